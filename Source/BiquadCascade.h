@@ -0,0 +1,931 @@
+/*
+  ==============================================================================
+
+    This file contains the fused biquad cascade that processes all the
+    active filters of the EQ in a single pass, for any number of channels.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CacheAlignedMemory.h"
+
+// [LUCAS] : This structure holds the coefficients of a single biquad section,
+//           normalised so that a0 is 1, in the order JUCE stores them.
+//           They are kept in double precision, and each cascade rounds them to its sample type.
+struct BiquadCoefficients
+{
+    double b0 { 1.0 }, b1 { 0.0 }, b2 { 0.0 };
+    double a1 { 0.0 }, a2 { 0.0 };
+};
+
+// [LUCAS] : This structure holds the coefficients of a single TPT state variable filter section :
+//           the prewarped cutoff g, the damping k, and the mix of the input (m0),
+//           band pass (m1) and low pass (m2) outputs
+struct StateVariableCoefficients
+{
+    double g { 0.0 }, k { 2.0 };
+    double m0 { 1.0 }, m1 { 0.0 }, m2 { 0.0 };
+};
+
+// [LUCAS] : This enum defines how the sections of a cascade are computed
+enum class FilterTopology
+{
+    // [LUCAS] : Transposed direct form II biquads, set with BiquadCoefficients
+    transposedDirectForm2,
+
+    // [LUCAS] : Topology-preserving state variable filters, set with StateVariableCoefficients.
+    //           Their coefficients are cheap to compute and they stay stable
+    //           when they are modulated, which suits parameter smoothing.
+    stateVariable
+};
+
+//==============================================================================
+// [LUCAS] : This class processes a chain of up to MaxSections biquad sections,
+//           with the same coefficients for every channel.
+//           Instead of one pass over the block per section (as a ProcessorChain
+//           of IIR::Filter does), every active section is applied to a sample
+//           before moving on to the next one, with the coefficients and the state
+//           of the sections kept in local variables for the whole block.
+//           The coefficients and the states are stored as structures of arrays,
+//           one array per coefficient and per state variable, indexed by section.
+//           Bypassed sections are removed from a processing plan that is rebuilt
+//           when the bypass flags change, and the number of active sections picks
+//           a kernel specialised at compile time, so nothing is checked per sample.
+//           With every section bypassed, the cascade leaves the audio untouched.
+//
+//           When SIMD is available, channels are packed into the lanes of a
+//           juce::dsp::SIMDRegister, so that one evaluation of the cascade
+//           processes numLanes channels at once. A channel left on its own
+//           is processed in place with the scalar kernel.
+//
+//           Channels holding the same samples as the first channel of their group,
+//           with the same filter state, are not processed again : the first channel
+//           is processed on its own and copied over them, and their state is kept
+//           equal to its state, so the cascade can go back to processing them apart
+//           as soon as they differ. Dual mono material costs one channel.
+//
+//           The sections are either transposed direct form II biquads,
+//           or TPT state variable filters (see FilterTopology).
+//
+//           Everything the audio thread reads and writes for every block lives in a single
+//           block of memory starting on a cache line : the coefficients and the processing
+//           plan, then the states of the SIMD groups, then the states of the scalar channels,
+//           each part starting on a cache line of its own. The block is allocated by prepare,
+//           or handed over by the owner of the cascade, so that several cascades can share
+//           one allocation (see getStateSizeInBytes). The SIMD tile is scratch memory, which
+//           cascades that never process at the same time can share too.
+template<typename SampleType, int MaxSections>
+class BiquadCascade
+{
+public:
+   #if JUCE_USE_SIMD
+    using VectorType = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int numLanes = (int) VectorType::SIMDNumElements;
+   #else
+    using VectorType = SampleType;
+    static constexpr int numLanes = 1;
+   #endif
+
+    static constexpr int maxSections = MaxSections;
+
+    // [LUCAS] : The number of frames interleaved into SIMD lanes in one go.
+    //           A tile of 512 SIMD frames is 8 KiB, so the tile and the channels
+    //           it is read from stay in the L1 cache. Smaller blocks get a tile
+    //           of their own size.
+    static constexpr int tileSize = 512;
+
+    BiquadCascade()
+    {
+        for (auto& bypassed : sectionBypassed)
+            bypassed = true;
+
+        // [LUCAS] : The coefficients can be set before prepare, they are moved into its block
+        ownedMemory.allocate(getStateSizeInBytes(0));
+        header = new (ownedMemory.getData()) Header();
+    }
+
+    // [LUCAS] : Selects the topology of the sections, and clears their state.
+    //           The sections must then be set with the matching coefficient type.
+    void setTopology(FilterTopology newTopology) noexcept
+    {
+        topology = newTopology;
+        reset();
+    }
+
+    FilterTopology getTopology() const noexcept
+    {
+        return (topology);
+    }
+
+    // [LUCAS] : Returns the size of the state block of a cascade prepared for numChannels channels,
+    //           which is a whole number of cache lines
+    static size_t getStateSizeInBytes(int numChannels) noexcept
+    {
+        int numVectorGroups = 0, numScalarChannels = 0;
+        getChannelLayout(numChannels, numVectorGroups, numScalarChannels);
+
+        return (CacheAlignedMemory::roundUp(sizeof(Header))
+                + CacheAlignedMemory::roundUp((size_t) numVectorGroups * sizeof(VectorGroup))
+                + CacheAlignedMemory::roundUp((size_t) numScalarChannels * sizeof(ScalarChannel)));
+    }
+
+    // [LUCAS] : Returns the size of the scratch memory the SIMD groups are interleaved into,
+    //           for blocks of up to maxBlockSize samples. It is 0 without SIMD groups.
+    static size_t getScratchSizeInBytes(int numChannels, int maxBlockSize) noexcept
+    {
+        int numVectorGroups = 0, numScalarChannels = 0;
+        getChannelLayout(numChannels, numVectorGroups, numScalarChannels);
+
+        if (numVectorGroups == 0)
+            return (0);
+
+        return (CacheAlignedMemory::roundUp((size_t) getTileLength(maxBlockSize) * sizeof(VectorType)));
+    }
+
+    // [LUCAS] : Prepares the cascade for spec.numChannels channels, in a state block of its own.
+    //           This allocates, so it must not be called from the audio thread.
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        const auto numChannels = (int) spec.numChannels;
+        const auto stateSize = getStateSizeInBytes(numChannels);
+
+        CacheAlignedMemory memory;
+        memory.allocate(stateSize + getScratchSizeInBytes(numChannels, (int) spec.maximumBlockSize));
+
+        prepare(spec, memory.getData(), memory.getData() + stateSize);
+        ownedMemory.swapWith(memory);
+    }
+
+    // [LUCAS] : Prepares the cascade for spec.numChannels channels, in the given state block
+    //           of getStateSizeInBytes bytes, aligned on a cache line, and with the given scratch
+    //           memory of getScratchSizeInBytes bytes. The coefficients and the bypass flags are
+    //           kept. The memory must outlive the cascade, or the next call to prepare.
+    void prepare(const juce::dsp::ProcessSpec& spec, char* stateMemory, char* scratchMemory) noexcept
+    {
+        jassert(reinterpret_cast<std::uintptr_t>(stateMemory) % CacheAlignedMemory::cacheLineSize == 0);
+
+        const auto numChannels = (int) spec.numChannels;
+
+        int numVectorGroups = 0, numScalarChannels = 0;
+        getChannelLayout(numChannels, numVectorGroups, numScalarChannels);
+
+        // [LUCAS] : Moves the coefficients and the plan into the new block
+        auto* newHeader = new (stateMemory) Header(*header);
+        newHeader->numVectorGroups = numVectorGroups;
+        newHeader->numScalarChannels = numScalarChannels;
+
+        auto* memory = stateMemory + CacheAlignedMemory::roundUp(sizeof(Header));
+        vectorGroups = reinterpret_cast<VectorGroup*>(memory);
+
+        memory += CacheAlignedMemory::roundUp((size_t) numVectorGroups * sizeof(VectorGroup));
+        scalarChannels = reinterpret_cast<ScalarChannel*>(memory);
+
+        int channel = 0;
+
+        // [LUCAS] : Packs as many channels as possible into SIMD lanes
+        for (int group = 0; group < numVectorGroups; ++group, channel += numLanes)
+            new (vectorGroups + group) VectorGroup { channel, juce::jmin(numLanes, numChannels - channel), {} };
+
+        for (int i = 0; i < numScalarChannels; ++i, ++channel)
+            new (scalarChannels + i) ScalarChannel { channel, {} };
+
+        header = newHeader;
+        interleaved = reinterpret_cast<VectorType*>(scratchMemory);
+        tileLength = getTileLength((int) spec.maximumBlockSize);
+        preparedChannels = numChannels;
+
+        // [LUCAS] : The previous block of the cascade, if it had one, is no longer used
+        ownedMemory.free();
+
+        reset();
+    }
+
+    // [LUCAS] : Clears the state of every section, for every channel
+    void reset() noexcept
+    {
+        for (auto& group : getVectorGroups())
+            group.states.clear();
+
+        for (auto& scalarChannel : getScalarChannels())
+            scalarChannel.states.clear();
+    }
+
+    // [LUCAS] : Updates the coefficients of the section at the given position
+    void setCoefficients(int index, const BiquadCoefficients& coefficients) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(index, MaxSections));
+
+        const auto i = (size_t) index;
+
+        header->sections.b0[i] = static_cast<SampleType>(coefficients.b0);
+        header->sections.b1[i] = static_cast<SampleType>(coefficients.b1);
+        header->sections.b2[i] = static_cast<SampleType>(coefficients.b2);
+        header->sections.a1[i] = static_cast<SampleType>(coefficients.a1);
+        header->sections.a2[i] = static_cast<SampleType>(coefficients.a2);
+
+        poleRadii[(size_t) index] = getPoleRadius(coefficients.a1, coefficients.a2);
+    }
+
+    void setCoefficients(int index, const StateVariableCoefficients& coefficients) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(index, MaxSections));
+
+        const auto i = (size_t) index;
+
+        // [LUCAS] : The per-sample gains of the trapezoidal integrators
+        const auto g = static_cast<SampleType>(coefficients.g);
+        const auto k = static_cast<SampleType>(coefficients.k);
+
+        header->sections.g1[i] = SampleType(1) / (SampleType(1) + g * (g + k));
+        header->sections.g2[i] = g * header->sections.g1[i];
+        header->sections.g3[i] = g * header->sections.g2[i];
+        header->sections.m0[i] = static_cast<SampleType>(coefficients.m0);
+        header->sections.m1[i] = static_cast<SampleType>(coefficients.m1);
+        header->sections.m2[i] = static_cast<SampleType>(coefficients.m2);
+
+        // [LUCAS] : The state variable filter has the poles of the biquad
+        //           with a1 = 2 (g^2 - 1) / D and a2 = (1 - g k + g^2) / D
+        const auto d = 1.0 + coefficients.g * (coefficients.g + coefficients.k);
+        poleRadii[(size_t) index] = getPoleRadius(2.0 * (coefficients.g * coefficients.g - 1.0) / d,
+                                                  (1.0 - coefficients.g * coefficients.k + coefficients.g * coefficients.g) / d);
+    }
+
+    // [LUCAS] : Returns how many samples the impulse response of the active sections
+    //           takes to decay below the given level. Each section decays as fast as
+    //           its largest pole radius allows, and the cascade adds their decays up.
+    int getTailLengthInSamples(double level = 1.0e-6) const noexcept
+    {
+        double tailLength = 0.0;
+
+        for (int i = 0; i < MaxSections; ++i)
+        {
+            const auto radius = poleRadii[(size_t) i];
+
+            if (sectionBypassed[(size_t) i] || radius <= 0.0)
+                continue;
+
+            // [LUCAS] : A pole on or outside the unit circle never decays
+            if (radius >= 1.0)
+                return (std::numeric_limits<int>::max());
+
+            tailLength += std::log(level) / std::log(radius);
+        }
+
+        return ((int) juce::jmin(std::ceil(tailLength), (double) std::numeric_limits<int>::max()));
+    }
+
+    // [LUCAS] : Returns true if the state of every active section is zero, for every channel,
+    //           which means that the cascade outputs silence for a silent input.
+    //           The states are flushed to zero below 1e-8 after each block.
+    bool isStateSilent() const noexcept
+    {
+        if (planNeedsUpdate)
+            return (false);
+
+        for (int k = 0; k < header->numActiveSections; ++k)
+        {
+            const auto section = (size_t) header->activeSections[(size_t) k];
+
+            for (const auto& group : getVectorGroups())
+                for (size_t lane = 0; lane < (size_t) numLanes; ++lane)
+                    if (getLane(group.states.s1[section], lane) != SampleType(0) || getLane(group.states.s2[section], lane) != SampleType(0))
+                        return (false);
+
+            for (const auto& scalarChannel : getScalarChannels())
+                if (scalarChannel.states.s1[section] != SampleType(0) || scalarChannel.states.s2[section] != SampleType(0))
+                    return (false);
+        }
+
+        return (true);
+    }
+
+    // [LUCAS] : Bypassed sections are skipped by the processing plan.
+    //           A section coming back into the plan starts from rest,
+    //           rather than from the state it was left with.
+    //           It leaves the plan here rather than in process(), which is not called
+    //           while the cascade is a pass-through.
+    void setBypassed(int index, bool shouldBeBypassed) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(index, MaxSections));
+
+        if (sectionBypassed[(size_t) index] != shouldBeBypassed)
+        {
+            sectionBypassed[(size_t) index] = shouldBeBypassed;
+            planNeedsUpdate = true;
+
+            if (shouldBeBypassed)
+                sectionInPlan[(size_t) index] = false;
+        }
+    }
+
+    bool isBypassed(int index) const noexcept
+    {
+        return (sectionBypassed[(size_t) index]);
+    }
+
+    // [LUCAS] : Returns true if every section is bypassed, so the cascade outputs its input
+    bool isPassThrough() const noexcept
+    {
+        return (std::all_of(sectionBypassed.begin(), sectionBypassed.end(), [](bool bypassed) { return bypassed; }));
+    }
+
+    // [LUCAS] : Selects whether identical channels are processed once, which is the default
+    void setIdenticalChannelDetection(bool shouldDetect) noexcept
+    {
+        identicalChannelDetection = shouldDetect;
+    }
+
+    bool isIdenticalChannelDetectionEnabled() const noexcept
+    {
+        return (identicalChannelDetection);
+    }
+
+    // [LUCAS] : Processes a block, the same way as a JUCE processor.
+    //           The block may have fewer channels than the cascade was prepared for.
+    template<typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+
+        jassert(inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom(inputBlock);
+
+        if (context.isBypassed)
+            return;
+
+        const auto numChannels = (int) outputBlock.getNumChannels();
+        const auto numSamples = (int) outputBlock.getNumSamples();
+
+        jassert(numChannels <= preparedChannels);
+
+        if (planNeedsUpdate)
+            updatePlan();
+
+        if (header->numActiveSections == 0)
+            return;
+
+        for (auto& group : getVectorGroups())
+        {
+            const auto groupChannels = juce::jmin(group.numChannels, numChannels - group.firstChannel);
+
+            if (groupChannels > 1 && identicalChannelDetection
+                && processIdenticalLanes(group, outputBlock, groupChannels, numSamples))
+                continue;
+
+            if (groupChannels > 0)
+                processVectorGroup(group, outputBlock, groupChannels, numSamples);
+        }
+
+        for (size_t i = 0; i < (size_t) header->numScalarChannels; ++i)
+        {
+            auto& scalarChannel = scalarChannels[i];
+
+            if (scalarChannel.channel >= numChannels)
+                continue;
+
+            auto* samples = outputBlock.getChannelPointer((size_t) scalarChannel.channel);
+
+            // [LUCAS] : Counts the next channels that are copies of this one, before it is processed
+            size_t numCopies = 0;
+
+            while (identicalChannelDetection
+                   && i + numCopies + 1 < (size_t) header->numScalarChannels
+                   && scalarChannels[i + numCopies + 1].channel < numChannels
+                   && areIdentical(samples, outputBlock.getChannelPointer((size_t) scalarChannels[i + numCopies + 1].channel), numSamples)
+                   && areStatesEqual(scalarChannel.states, scalarChannels[i + numCopies + 1].states))
+                ++numCopies;
+
+            const auto& kernels = (topology == FilterTopology::stateVariable ? scalarStateVariableKernels : scalarKernels);
+
+            kernels[(size_t) header->numActiveSections](samples,
+                                                        numSamples,
+                                                        header->sections,
+                                                        scalarChannel.states,
+                                                        header->activeSections.data());
+            snapStatesToZero(scalarChannel.states);
+
+            for (size_t k = 1; k <= numCopies; ++k)
+            {
+                auto& copy = scalarChannels[i + k];
+
+                juce::FloatVectorOperations::copy(outputBlock.getChannelPointer((size_t) copy.channel), samples, numSamples);
+                copy.states = scalarChannel.states;
+            }
+
+            i += numCopies;
+        }
+    }
+
+private:
+    template<typename ValueType>
+    using SectionArray = std::array<ValueType, MaxSections>;
+
+    // [LUCAS] : The coefficients of every section, shared by every channel,
+    //           for the transposed direct form II and for the state variable topology
+    struct Sections
+    {
+        Sections()
+        {
+            // [LUCAS] : Every section starts as a pass-through, in both topologies
+            for (auto* coefficient : { &b1, &b2, &a1, &a2, &g2, &g3, &m1, &m2 })
+                coefficient->fill(SampleType(0));
+
+            for (auto* coefficient : { &b0, &g1, &m0 })
+                coefficient->fill(SampleType(1));
+        }
+
+        SectionArray<SampleType> b0, b1, b2, a1, a2;
+        SectionArray<SampleType> g1, g2, g3, m0, m1, m2;
+    };
+
+    // [LUCAS] : The state of every section, for one channel or one SIMD group :
+    //           the two delays of the transposed direct form II,
+    //           or the two integrator states of the state variable filter
+    template<typename LaneType>
+    struct States
+    {
+        States()
+        {
+            clear();
+        }
+
+        void clear() noexcept
+        {
+            s1.fill(broadcast<LaneType>(SampleType(0)));
+            s2.fill(broadcast<LaneType>(SampleType(0)));
+        }
+
+        SectionArray<LaneType> s1, s2;
+    };
+
+    // [LUCAS] : Up to numLanes channels processed together in SIMD lanes
+    struct VectorGroup
+    {
+        int firstChannel;
+        int numChannels;
+        States<VectorType> states;
+    };
+
+    // [LUCAS] : A channel processed on its own
+    struct ScalarChannel
+    {
+        int channel;
+        States<SampleType> states;
+    };
+
+    // [LUCAS] : The start of the state block : the coefficients and the processing plan,
+    //           read for every block, and the number of groups and channels that follow them
+    struct alignas(CacheAlignedMemory::cacheLineSize) Header
+    {
+        Sections sections;
+        std::array<int, MaxSections> activeSections {};
+        int numActiveSections { 0 };
+        int numVectorGroups { 0 };
+        int numScalarChannels { 0 };
+    };
+
+    // [LUCAS] : The groups or the channels of the state block, for range-based loops
+    template<typename ItemType>
+    struct ItemRange
+    {
+        ItemType* first;
+        int size;
+
+        ItemType* begin() const noexcept { return (first); }
+        ItemType* end() const noexcept { return (first + size); }
+    };
+
+    ItemRange<VectorGroup> getVectorGroups() const noexcept
+    {
+        return { vectorGroups, header->numVectorGroups };
+    }
+
+    ItemRange<ScalarChannel> getScalarChannels() const noexcept
+    {
+        return { scalarChannels, header->numScalarChannels };
+    }
+
+    // [LUCAS] : Packs as many channels as possible into SIMD groups, two channels at least,
+    //           and leaves the others to the scalar kernel
+    static void getChannelLayout(int numChannels, int& numVectorGroups, int& numScalarChannels) noexcept
+    {
+        numVectorGroups = 0;
+
+        int channel = 0;
+
+        if constexpr (numLanes > 1)
+        {
+            for (; numChannels - channel >= 2; channel += numLanes)
+                ++numVectorGroups;
+        }
+
+        numScalarChannels = juce::jmax(0, numChannels - channel);
+    }
+
+    static int getTileLength(int maxBlockSize) noexcept
+    {
+        return (juce::jlimit(1, tileSize, maxBlockSize));
+    }
+
+    template<typename LaneType>
+    using Kernel = void (*)(LaneType*, int, const Sections&, States<LaneType>&, const int*);
+
+    // [LUCAS] : Rebuilds the list of the sections that are not bypassed,
+    //           and clears the state of the ones that were not in the previous plan
+    void updatePlan() noexcept
+    {
+        header->numActiveSections = 0;
+
+        for (int i = 0; i < MaxSections; ++i)
+        {
+            const auto active = ! sectionBypassed[(size_t) i];
+
+            if (active && ! sectionInPlan[(size_t) i])
+                resetSection((size_t) i);
+
+            sectionInPlan[(size_t) i] = active;
+
+            if (active)
+                header->activeSections[(size_t) header->numActiveSections++] = i;
+        }
+
+        planNeedsUpdate = false;
+    }
+
+    void resetSection(size_t index) noexcept
+    {
+        for (auto& group : getVectorGroups())
+            group.states.s1[index] = group.states.s2[index] = broadcast<VectorType>(SampleType(0));
+
+        for (auto& scalarChannel : getScalarChannels())
+            scalarChannel.states.s1[index] = scalarChannel.states.s2[index] = SampleType(0);
+    }
+
+    // [LUCAS] : Interleaves a tile of the group channels into SIMD lanes,
+    //           runs the cascade over it, and writes it back
+    template<typename BlockType>
+    void processVectorGroup(VectorGroup& group, BlockType& block, int groupChannels, int numSamples) noexcept
+    {
+        auto* lanes = reinterpret_cast<SampleType*>(interleaved);
+
+        for (int tileStart = 0; tileStart < numSamples; tileStart += tileLength)
+        {
+            const auto length = juce::jmin(tileLength, numSamples - tileStart);
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                if (lane < groupChannels)
+                {
+                    const auto* source = block.getChannelPointer((size_t) (group.firstChannel + lane)) + tileStart;
+
+                    for (int i = 0; i < length; ++i)
+                        lanes[i * numLanes + lane] = source[i];
+                }
+                else
+                {
+                    // [LUCAS] : Unused lanes are kept silent, so their state stays at zero
+                    for (int i = 0; i < length; ++i)
+                        lanes[i * numLanes + lane] = SampleType(0);
+                }
+            }
+
+            const auto& kernels = (topology == FilterTopology::stateVariable ? vectorStateVariableKernels : vectorKernels);
+
+            kernels[(size_t) header->numActiveSections](interleaved,
+                                                        length,
+                                                        header->sections,
+                                                        group.states,
+                                                        header->activeSections.data());
+
+            for (int lane = 0; lane < groupChannels; ++lane)
+            {
+                auto* destination = block.getChannelPointer((size_t) (group.firstChannel + lane)) + tileStart;
+
+                for (int i = 0; i < length; ++i)
+                    destination[i] = lanes[i * numLanes + lane];
+            }
+        }
+
+        snapStatesToZero(group.states);
+    }
+
+    // [LUCAS] : Processes a group whose channels all hold the same samples and the same state
+    //           as its first one : the first channel goes through the scalar kernel, from the
+    //           state of the first lane, and the result and the new state are copied to every lane.
+    //           Returns false, leaving everything untouched, if the channels differ.
+    //           The output is bit-identical to the SIMD kernel's as long as the compiler does not
+    //           fuse multiply-adds, which the build turns off (-ffp-contract=off).
+    template<typename BlockType>
+    bool processIdenticalLanes(VectorGroup& group, BlockType& block, int groupChannels, int numSamples) noexcept
+    {
+        auto* first = block.getChannelPointer((size_t) group.firstChannel);
+
+        for (int lane = 1; lane < groupChannels; ++lane)
+            if (! areIdentical(first, block.getChannelPointer((size_t) (group.firstChannel + lane)), numSamples))
+                return (false);
+
+        for (int k = 0; k < header->numActiveSections; ++k)
+        {
+            const auto section = (size_t) header->activeSections[(size_t) k];
+
+            for (size_t lane = 1; lane < (size_t) groupChannels; ++lane)
+                if (getLane(group.states.s1[section], lane) != getLane(group.states.s1[section], 0)
+                    || getLane(group.states.s2[section], lane) != getLane(group.states.s2[section], 0))
+                    return (false);
+        }
+
+        States<SampleType> states;
+
+        for (int k = 0; k < header->numActiveSections; ++k)
+        {
+            const auto section = (size_t) header->activeSections[(size_t) k];
+
+            states.s1[section] = getLane(group.states.s1[section], 0);
+            states.s2[section] = getLane(group.states.s2[section], 0);
+        }
+
+        const auto& kernels = (topology == FilterTopology::stateVariable ? scalarStateVariableKernels : scalarKernels);
+
+        kernels[(size_t) header->numActiveSections](first, numSamples, header->sections, states, header->activeSections.data());
+        snapStatesToZero(states);
+
+        // [LUCAS] : The unused lanes are left at zero
+        for (int k = 0; k < header->numActiveSections; ++k)
+        {
+            const auto section = (size_t) header->activeSections[(size_t) k];
+
+            for (size_t lane = 0; lane < (size_t) groupChannels; ++lane)
+            {
+                setLane(group.states.s1[section], lane, states.s1[section]);
+                setLane(group.states.s2[section], lane, states.s2[section]);
+            }
+        }
+
+        for (int lane = 1; lane < groupChannels; ++lane)
+            juce::FloatVectorOperations::copy(block.getChannelPointer((size_t) (group.firstChannel + lane)), first, numSamples);
+
+        return (true);
+    }
+
+    // [LUCAS] : The channels are compared bit for bit, with memcmp, which the C library vectorises
+    static bool areIdentical(const SampleType* a, const SampleType* b, int numSamples) noexcept
+    {
+        return (std::memcmp(a, b, (size_t) numSamples * sizeof(SampleType)) == 0);
+    }
+
+    bool areStatesEqual(const States<SampleType>& a, const States<SampleType>& b) const noexcept
+    {
+        for (int k = 0; k < header->numActiveSections; ++k)
+        {
+            const auto section = (size_t) header->activeSections[(size_t) k];
+
+            if (a.s1[section] != b.s1[section] || a.s2[section] != b.s2[section])
+                return (false);
+        }
+
+        return (true);
+    }
+
+    // [LUCAS] : The largest radius of the roots of z^2 + a1 z + a2
+    static double getPoleRadius(double a1, double a2) noexcept
+    {
+        const auto discriminant = a1 * a1 - 4.0 * a2;
+
+        if (discriminant < 0.0)
+            return (std::sqrt(a2));
+
+        const auto root = std::sqrt(discriminant);
+
+        return (juce::jmax(std::abs(-a1 + root), std::abs(-a1 - root)) * 0.5);
+    }
+
+    static SampleType getLane(const VectorType& value, size_t lane) noexcept
+    {
+        if constexpr (std::is_same<VectorType, SampleType>::value)
+        {
+            juce::ignoreUnused(lane);
+            return (value);
+        }
+        else
+        {
+            return (value.get(lane));
+        }
+    }
+
+    static void setLane(VectorType& value, size_t lane, SampleType laneValue) noexcept
+    {
+        if constexpr (std::is_same<VectorType, SampleType>::value)
+        {
+            juce::ignoreUnused(lane);
+            value = laneValue;
+        }
+        else
+        {
+            value.set(lane, laneValue);
+        }
+    }
+
+    template<typename LaneType>
+    static LaneType broadcast(SampleType value) noexcept
+    {
+        if constexpr (std::is_same<LaneType, SampleType>::value)
+            return (value);
+        else
+            return (LaneType::expand(value));
+    }
+
+    // [LUCAS] : Flushes tiny state values to zero, like JUCE's IIR::Filter does
+    static SampleType snapToZero(SampleType value) noexcept
+    {
+        return (std::abs(value) < static_cast<SampleType>(1.0e-8) ? SampleType(0) : value);
+    }
+
+    template<typename LaneType>
+    void snapStatesToZero(States<LaneType>& states) noexcept
+    {
+        for (int k = 0; k < header->numActiveSections; ++k)
+        {
+            const auto section = (size_t) header->activeSections[(size_t) k];
+            auto& s1 = states.s1[section];
+            auto& s2 = states.s2[section];
+
+            if constexpr (std::is_same<LaneType, SampleType>::value)
+            {
+                s1 = snapToZero(s1);
+                s2 = snapToZero(s2);
+            }
+            else
+            {
+                for (size_t lane = 0; lane < (size_t) numLanes; ++lane)
+                {
+                    s1.set(lane, snapToZero(s1.get(lane)));
+                    s2.set(lane, snapToZero(s2.get(lane)));
+                }
+            }
+        }
+    }
+
+    // [LUCAS] : The fused kernel for a plan of exactly NumSections sections.
+    //           LaneType is either a single sample, or a SIMD register of samples.
+    template<typename LaneType, int NumSections>
+    static void processFused(LaneType* samples,
+                             int numSamples,
+                             const Sections& allSections,
+                             States<LaneType>& states,
+                             const int* plan) noexcept
+    {
+        if constexpr (NumSections > 0)
+        {
+            LaneType b0[NumSections], b1[NumSections], b2[NumSections], a1[NumSections], a2[NumSections];
+            LaneType s1[NumSections], s2[NumSections];
+
+            // [LUCAS] : Gathers the active sections into contiguous local arrays
+            for (int k = 0; k < NumSections; ++k)
+            {
+                const auto section = (size_t) plan[k];
+
+                b0[k] = broadcast<LaneType>(allSections.b0[section]);
+                b1[k] = broadcast<LaneType>(allSections.b1[section]);
+                b2[k] = broadcast<LaneType>(allSections.b2[section]);
+                a1[k] = broadcast<LaneType>(allSections.a1[section]);
+                a2[k] = broadcast<LaneType>(allSections.a2[section]);
+                s1[k] = states.s1[section];
+                s2[k] = states.s2[section];
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto x = samples[i];
+
+                for (int k = 0; k < NumSections; ++k)
+                {
+                    const auto y = b0[k] * x + s1[k];
+                    s1[k] = b1[k] * x - a1[k] * y + s2[k];
+                    s2[k] = b2[k] * x - a2[k] * y;
+                    x = y;
+                }
+
+                samples[i] = x;
+            }
+
+            for (int k = 0; k < NumSections; ++k)
+            {
+                states.s1[(size_t) plan[k]] = s1[k];
+                states.s2[(size_t) plan[k]] = s2[k];
+            }
+        }
+        else
+        {
+            juce::ignoreUnused(samples, numSamples, allSections, states, plan);
+        }
+    }
+
+    // [LUCAS] : The same fused kernel, for state variable sections
+    template<typename LaneType, int NumSections>
+    static void processFusedStateVariable(LaneType* samples,
+                                          int numSamples,
+                                          const Sections& allSections,
+                                          States<LaneType>& states,
+                                          const int* plan) noexcept
+    {
+        if constexpr (NumSections > 0)
+        {
+            LaneType g1[NumSections], g2[NumSections], g3[NumSections], m0[NumSections], m1[NumSections], m2[NumSections];
+            LaneType ic1[NumSections], ic2[NumSections];
+
+            for (int k = 0; k < NumSections; ++k)
+            {
+                const auto section = (size_t) plan[k];
+
+                g1[k] = broadcast<LaneType>(allSections.g1[section]);
+                g2[k] = broadcast<LaneType>(allSections.g2[section]);
+                g3[k] = broadcast<LaneType>(allSections.g3[section]);
+                m0[k] = broadcast<LaneType>(allSections.m0[section]);
+                m1[k] = broadcast<LaneType>(allSections.m1[section]);
+                m2[k] = broadcast<LaneType>(allSections.m2[section]);
+                ic1[k] = states.s1[section];
+                ic2[k] = states.s2[section];
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto x = samples[i];
+
+                for (int k = 0; k < NumSections; ++k)
+                {
+                    const auto v3 = x - ic2[k];
+                    const auto v1 = g1[k] * ic1[k] + g2[k] * v3;
+                    const auto v2 = ic2[k] + g2[k] * ic1[k] + g3[k] * v3;
+
+                    ic1[k] = v1 + v1 - ic1[k];
+                    ic2[k] = v2 + v2 - ic2[k];
+                    x = m0[k] * x + m1[k] * v1 + m2[k] * v2;
+                }
+
+                samples[i] = x;
+            }
+
+            for (int k = 0; k < NumSections; ++k)
+            {
+                states.s1[(size_t) plan[k]] = ic1[k];
+                states.s2[(size_t) plan[k]] = ic2[k];
+            }
+        }
+        else
+        {
+            juce::ignoreUnused(samples, numSamples, allSections, states, plan);
+        }
+    }
+
+    template<typename LaneType, size_t... NumSections>
+    static constexpr std::array<Kernel<LaneType>, sizeof...(NumSections)> makeKernels(std::index_sequence<NumSections...>)
+    {
+        return {{ &processFused<LaneType, (int) NumSections>... }};
+    }
+
+    template<typename LaneType, size_t... NumSections>
+    static constexpr std::array<Kernel<LaneType>, sizeof...(NumSections)> makeStateVariableKernels(std::index_sequence<NumSections...>)
+    {
+        return {{ &processFusedStateVariable<LaneType, (int) NumSections>... }};
+    }
+
+    // [LUCAS] : One kernel per possible number of active sections, from 0 to MaxSections
+    static constexpr std::array<Kernel<SampleType>, MaxSections + 1> scalarKernels
+        = makeKernels<SampleType>(std::make_index_sequence<MaxSections + 1>());
+
+    static constexpr std::array<Kernel<VectorType>, MaxSections + 1> vectorKernels
+        = makeKernels<VectorType>(std::make_index_sequence<MaxSections + 1>());
+
+    static constexpr std::array<Kernel<SampleType>, MaxSections + 1> scalarStateVariableKernels
+        = makeStateVariableKernels<SampleType>(std::make_index_sequence<MaxSections + 1>());
+
+    static constexpr std::array<Kernel<VectorType>, MaxSections + 1> vectorStateVariableKernels
+        = makeStateVariableKernels<VectorType>(std::make_index_sequence<MaxSections + 1>());
+
+    FilterTopology topology { FilterTopology::transposedDirectForm2 };
+
+    // [LUCAS] : Only read when the bypass flags or the coefficients change
+    std::array<bool, MaxSections> sectionBypassed;
+    std::array<bool, MaxSections> sectionInPlan {};
+    std::array<double, MaxSections> poleRadii {};
+
+    bool planNeedsUpdate { true };
+    bool identicalChannelDetection { true };
+
+    // [LUCAS] : The state block, owned by the cascade or handed over to prepare, and the scratch tile
+    CacheAlignedMemory ownedMemory;
+    Header* header { nullptr };
+    VectorGroup* vectorGroups { nullptr };
+    ScalarChannel* scalarChannels { nullptr };
+    VectorType* interleaved { nullptr };
+    int tileLength { 0 };
+    int preparedChannels { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (BiquadCascade)
+};
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    This file contains a block of memory aligned on a cache line, used to
+    keep the hot data of the DSP together.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// [LUCAS] : This class owns a block of zeroed memory starting on a cache line boundary.
+//           Data laid out in it in multiples of cacheLineSize never shares a cache line
+//           with anything else, and takes as few cache lines as its size allows.
+class CacheAlignedMemory
+{
+public:
+    static constexpr size_t cacheLineSize = 64;
+
+    CacheAlignedMemory() = default;
+
+    // [LUCAS] : Rounds a size up to a whole number of cache lines
+    static constexpr size_t roundUp(size_t numBytes) noexcept
+    {
+        return ((numBytes + cacheLineSize - 1) & ~(cacheLineSize - 1));
+    }
+
+    // [LUCAS] : Allocates numBytes of zeroed memory, freeing the previous block.
+    //           This allocates, so it must not be called from the audio thread.
+    void allocate(size_t numBytes)
+    {
+        block.allocate(numBytes + cacheLineSize, true);
+
+        const auto address = reinterpret_cast<std::uintptr_t>(block.get());
+        data = block.get() + (roundUp((size_t) address) - (size_t) address);
+        size = numBytes;
+    }
+
+    void free() noexcept
+    {
+        block.free();
+        data = nullptr;
+        size = 0;
+    }
+
+    void swapWith(CacheAlignedMemory& other) noexcept
+    {
+        block.swapWith(other.block);
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+    }
+
+    char* getData() const noexcept
+    {
+        return (data);
+    }
+
+    size_t getSize() const noexcept
+    {
+        return (size);
+    }
+
+private:
+    juce::HeapBlock<char> block;
+    char* data { nullptr };
+    size_t size { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (CacheAlignedMemory)
+};
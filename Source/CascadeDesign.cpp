@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    This file contains the closed-form designs of the filters of the EQ,
+    written straight into preallocated second order sections.
+
+  ==============================================================================
+*/
+
+#include "CascadeDesign.h"
+
+// [LUCAS] : The designs are computed and stored in double precision
+void designButterworthHighPass(std::array<BiquadCoefficients, 4>& sections, float frequency, Slope slope, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && frequency > 0.0f && frequency <= sampleRate * 0.5);
+
+    const auto& qs = ButterworthTables::qs[(size_t) slope];
+
+    const auto n = std::tan(juce::MathConstants<double>::pi * (double) frequency / sampleRate);
+    const auto nSquared = n * n;
+
+    for (int i = 0; i <= slope; ++i)
+    {
+        const auto nOverQ = n / qs[(size_t) i];
+        const auto c1 = 1.0 / (1.0 + nOverQ + nSquared);
+
+        sections[(size_t) i] = { c1,
+                                 -2.0 * c1,
+                                 c1,
+                                 2.0 * c1 * (nSquared - 1.0),
+                                 c1 * (1.0 - nOverQ + nSquared) };
+    }
+}
+
+void designButterworthLowPass(std::array<BiquadCoefficients, 4>& sections, float frequency, Slope slope, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && frequency > 0.0f && frequency <= sampleRate * 0.5);
+
+    const auto& qs = ButterworthTables::qs[(size_t) slope];
+
+    const auto n = 1.0 / std::tan(juce::MathConstants<double>::pi * (double) frequency / sampleRate);
+    const auto nSquared = n * n;
+
+    for (int i = 0; i <= slope; ++i)
+    {
+        const auto nOverQ = n / qs[(size_t) i];
+        const auto c1 = 1.0 / (1.0 + nOverQ + nSquared);
+
+        sections[(size_t) i] = { c1,
+                                 2.0 * c1,
+                                 c1,
+                                 2.0 * c1 * (1.0 - nSquared),
+                                 c1 * (1.0 - nOverQ + nSquared) };
+    }
+}
+
+BiquadCoefficients designPeakFilter(float frequency, float q, float gainInDb, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    const auto a = std::sqrt(juce::jmax(1.0e-15, (double) juce::Decibels::decibelsToGain(gainInDb)));
+    const auto omega = juce::MathConstants<double>::twoPi * juce::jmax((double) frequency, 2.0) / sampleRate;
+    const auto alpha = std::sin(omega) / (2.0 * (double) q);
+    const auto c2 = -2.0 * std::cos(omega);
+
+    const auto a0 = 1.0 / (1.0 + alpha / a);
+
+    return (BiquadCoefficients { (1.0 + alpha * a) * a0,
+                                 c2 * a0,
+                                 (1.0 - alpha * a) * a0,
+                                 c2 * a0,
+                                 (1.0 - alpha / a) * a0 });
+}
+
+// [LUCAS] : The shelves and the notch keep their frequency below Nyquist, where the prewarping holds
+static double getBandOmega(float frequency, double sampleRate) noexcept
+{
+    return (juce::MathConstants<double>::twoPi * juce::jlimit(2.0, sampleRate * 0.49, (double) frequency) / sampleRate);
+}
+
+BiquadCoefficients designLowShelfFilter(float frequency, float q, float gainInDb, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    const auto a = std::sqrt(juce::jmax(1.0e-15, (double) juce::Decibels::decibelsToGain(gainInDb)));
+    const auto omega = getBandOmega(frequency, sampleRate);
+    const auto cosine = std::cos(omega);
+    const auto beta = std::sin(omega) * std::sqrt(a) / (double) q;
+    const auto aMinusOneTimesCosine = (a - 1.0) * cosine;
+
+    const auto a0 = 1.0 / ((a + 1.0) + aMinusOneTimesCosine + beta);
+
+    return (BiquadCoefficients { a * ((a + 1.0) - aMinusOneTimesCosine + beta) * a0,
+                                 a * 2.0 * ((a - 1.0) - (a + 1.0) * cosine) * a0,
+                                 a * ((a + 1.0) - aMinusOneTimesCosine - beta) * a0,
+                                 -2.0 * ((a - 1.0) + (a + 1.0) * cosine) * a0,
+                                 ((a + 1.0) + aMinusOneTimesCosine - beta) * a0 });
+}
+
+BiquadCoefficients designHighShelfFilter(float frequency, float q, float gainInDb, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    const auto a = std::sqrt(juce::jmax(1.0e-15, (double) juce::Decibels::decibelsToGain(gainInDb)));
+    const auto omega = getBandOmega(frequency, sampleRate);
+    const auto cosine = std::cos(omega);
+    const auto beta = std::sin(omega) * std::sqrt(a) / (double) q;
+    const auto aMinusOneTimesCosine = (a - 1.0) * cosine;
+
+    const auto a0 = 1.0 / ((a + 1.0) - aMinusOneTimesCosine + beta);
+
+    return (BiquadCoefficients { a * ((a + 1.0) + aMinusOneTimesCosine + beta) * a0,
+                                 a * -2.0 * ((a - 1.0) + (a + 1.0) * cosine) * a0,
+                                 a * ((a + 1.0) + aMinusOneTimesCosine - beta) * a0,
+                                 2.0 * ((a - 1.0) - (a + 1.0) * cosine) * a0,
+                                 ((a + 1.0) - aMinusOneTimesCosine - beta) * a0 });
+}
+
+BiquadCoefficients designNotchFilter(float frequency, float q, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    const auto n = 1.0 / std::tan(getBandOmega(frequency, sampleRate) * 0.5);
+    const auto nSquared = n * n;
+    const auto c1 = 1.0 / (1.0 + n / (double) q + nSquared);
+
+    return (BiquadCoefficients { c1 * (1.0 + nSquared),
+                                 2.0 * c1 * (1.0 - nSquared),
+                                 c1 * (1.0 + nSquared),
+                                 2.0 * c1 * (1.0 - nSquared),
+                                 c1 * (1.0 - n / (double) q + nSquared) });
+}
+
+double getMagnitudeForFrequency(const BiquadCoefficients& coefficients, double frequency, double sampleRate) noexcept
+{
+    // [LUCAS] : Evaluates the transfer function on the unit circle, at z = exp(j omega)
+    const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const auto z1 = std::polar(1.0, -omega);
+    const auto z2 = z1 * z1;
+
+    const auto numerator = coefficients.b0 + coefficients.b1 * z1 + coefficients.b2 * z2;
+    const auto denominator = 1.0 + coefficients.a1 * z1 + coefficients.a2 * z2;
+
+    return (std::abs(numerator) / std::abs(denominator));
+}
+
+//==============================================================================
+void designStateVariableHighPass(std::array<StateVariableCoefficients, 4>& sections, float frequency, Slope slope, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && frequency > 0.0f && frequency <= sampleRate * 0.5);
+
+    const auto& qs = ButterworthTables::qs[(size_t) slope];
+    const auto g = std::tan(juce::MathConstants<double>::pi * (double) frequency / sampleRate);
+
+    for (int i = 0; i <= slope; ++i)
+    {
+        const auto k = 1.0 / qs[(size_t) i];
+
+        sections[(size_t) i] = { g, k, 1.0, -k, -1.0 };
+    }
+}
+
+void designStateVariableLowPass(std::array<StateVariableCoefficients, 4>& sections, float frequency, Slope slope, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && frequency > 0.0f && frequency <= sampleRate * 0.5);
+
+    const auto& qs = ButterworthTables::qs[(size_t) slope];
+    const auto g = std::tan(juce::MathConstants<double>::pi * (double) frequency / sampleRate);
+
+    for (int i = 0; i <= slope; ++i)
+        sections[(size_t) i] = { g, 1.0 / qs[(size_t) i], 0.0, 0.0, 1.0 };
+}
+
+StateVariableCoefficients designStateVariablePeak(float frequency, float q, float gainInDb, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    // [LUCAS] : A is the square root of the gain, as in designPeakFilter
+    const auto a = std::sqrt(juce::jmax(1.0e-15, (double) juce::Decibels::decibelsToGain(gainInDb)));
+    const auto g = std::tan(juce::MathConstants<double>::pi * juce::jmax((double) frequency, 2.0) / sampleRate);
+    const auto k = 1.0 / ((double) q * a);
+
+    return (StateVariableCoefficients { g, k, 1.0, k * (a * a - 1.0), 0.0 });
+}
+
+// [LUCAS] : The shelves move their cutoff by the fourth root of the gain, so that their
+//           midpoint stays at the given frequency, and mix in the low pass for the gain
+StateVariableCoefficients designStateVariableLowShelf(float frequency, float q, float gainInDb, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    const auto a = std::sqrt(juce::jmax(1.0e-15, (double) juce::Decibels::decibelsToGain(gainInDb)));
+    const auto g = std::tan(getBandOmega(frequency, sampleRate) * 0.5) / std::sqrt(a);
+    const auto k = 1.0 / (double) q;
+
+    return (StateVariableCoefficients { g, k, 1.0, k * (a - 1.0), a * a - 1.0 });
+}
+
+StateVariableCoefficients designStateVariableHighShelf(float frequency, float q, float gainInDb, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    const auto a = std::sqrt(juce::jmax(1.0e-15, (double) juce::Decibels::decibelsToGain(gainInDb)));
+    const auto g = std::tan(getBandOmega(frequency, sampleRate) * 0.5) * std::sqrt(a);
+    const auto k = 1.0 / (double) q;
+
+    return (StateVariableCoefficients { g, k, a * a, k * (1.0 - a) * a, 1.0 - a * a });
+}
+
+StateVariableCoefficients designStateVariableNotch(float frequency, float q, double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    const auto g = std::tan(getBandOmega(frequency, sampleRate) * 0.5);
+    const auto k = 1.0 / (double) q;
+
+    return (StateVariableCoefficients { g, k, 1.0, -k, 0.0 });
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    This file contains the closed-form designs of the filters of the EQ,
+    written straight into preallocated second order sections.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "ChainSettings.h"
+
+//==============================================================================
+// [LUCAS] : The Q of every second order section of the Butterworth cascades,
+//           computed at compile time : an order N cascade has N / 2 sections,
+//           and the section i has Q = 1 / (2 cos((2i + 1) pi / 2N)),
+//           the same values as juce::dsp::FilterDesign uses.
+namespace ButterworthTables
+{
+    // [LUCAS] : std::cos is not constexpr, and the angles stay within [0, pi / 2),
+    //           where this Taylor series converges well below the float precision
+    constexpr double cosine(double x)
+    {
+        double term = 1.0, sum = 1.0;
+
+        for (int n = 1; n < 20; ++n)
+        {
+            term *= -x * x / (double) ((2 * n - 1) * (2 * n));
+            sum += term;
+        }
+
+        return (sum);
+    }
+
+    constexpr std::array<double, 4> makeQs(Slope slope)
+    {
+        std::array<double, 4> qs {};
+        const int order = 2 * (slope + 1);
+
+        for (int i = 0; i < slope + 1; ++i)
+            qs[(size_t) i] = 1.0 / (2.0 * cosine((2.0 * i + 1.0) * juce::MathConstants<double>::pi / (2.0 * order)));
+
+        return (qs);
+    }
+
+    // [LUCAS] : Indexed by Slope, then by section
+    constexpr std::array<std::array<double, 4>, 4> qs { makeQs(Slope_12), makeQs(Slope_24), makeQs(Slope_36), makeQs(Slope_48) };
+
+    static_assert(qs[Slope_12][0] > 0.70710678 && qs[Slope_12][0] < 0.70710679, "The order 2 Butterworth Q is 1 / sqrt(2)");
+}
+
+// [LUCAS] : These functions write the (slope + 1) sections of a Butterworth high pass (low cut)
+//           or low pass (high cut) cascade into sections. The frequency is prewarped once
+//           for the whole cascade. They neither allocate nor lock.
+void designButterworthHighPass(std::array<BiquadCoefficients, 4>& sections, float frequency, Slope slope, double sampleRate) noexcept;
+void designButterworthLowPass(std::array<BiquadCoefficients, 4>& sections, float frequency, Slope slope, double sampleRate) noexcept;
+
+// [LUCAS] : This function returns the coefficients of a peak filter,
+//           the same design as juce::dsp::IIR::Coefficients::makePeakFilter
+BiquadCoefficients designPeakFilter(float frequency, float q, float gainInDb, double sampleRate) noexcept;
+
+// [LUCAS] : These functions return the coefficients of the shelf and notch filters of the
+//           parametric bands, the same designs as juce::dsp::IIR::Coefficients::makeLowShelf,
+//           makeHighShelf and makeNotch
+BiquadCoefficients designLowShelfFilter(float frequency, float q, float gainInDb, double sampleRate) noexcept;
+BiquadCoefficients designHighShelfFilter(float frequency, float q, float gainInDb, double sampleRate) noexcept;
+BiquadCoefficients designNotchFilter(float frequency, float q, double sampleRate) noexcept;
+
+// [LUCAS] : This function returns the magnitude response of a section at the given frequency
+double getMagnitudeForFrequency(const BiquadCoefficients& coefficients, double frequency, double sampleRate) noexcept;
+
+// [LUCAS] : The same designs, for the state variable topology : the Butterworth cascades
+//           share the prewarped cutoff g, and each section only changes its damping k
+void designStateVariableHighPass(std::array<StateVariableCoefficients, 4>& sections, float frequency, Slope slope, double sampleRate) noexcept;
+void designStateVariableLowPass(std::array<StateVariableCoefficients, 4>& sections, float frequency, Slope slope, double sampleRate) noexcept;
+StateVariableCoefficients designStateVariablePeak(float frequency, float q, float gainInDb, double sampleRate) noexcept;
+StateVariableCoefficients designStateVariableLowShelf(float frequency, float q, float gainInDb, double sampleRate) noexcept;
+StateVariableCoefficients designStateVariableHighShelf(float frequency, float q, float gainInDb, double sampleRate) noexcept;
+StateVariableCoefficients designStateVariableNotch(float frequency, float q, double sampleRate) noexcept;
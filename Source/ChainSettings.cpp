@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+    This file contains the settings of the EQ and how they are read
+    from the parameters manager.
+
+  ==============================================================================
+*/
+
+#include "ChainSettings.h"
+
+// [LUCAS] : This function looks up the raw parameter values of the EQ once.
+ChainParameters getChainParameters(juce::AudioProcessorValueTreeState& parametersManager)
+{
+    ChainParameters parameters;
+
+    parameters.lowCutFreq   = parametersManager.getRawParameterValue("LowCut Freq");
+    parameters.highCutFreq  = parametersManager.getRawParameterValue("HighCut Freq");
+    parameters.peakFreq     = parametersManager.getRawParameterValue("Peak Freq");
+    parameters.peakGainInDb = parametersManager.getRawParameterValue("Peak Gain");
+    parameters.peakQ        = parametersManager.getRawParameterValue("Peak Quality");
+    parameters.lowCutSlope  = parametersManager.getRawParameterValue("LowCut Slope");
+    parameters.highCutSlope = parametersManager.getRawParameterValue("HighCut Slope");
+
+    return (parameters);
+}
+
+// [LUCAS] : This function is a getter for the parameters settings of the EQ.
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& parametersManager)
+{
+    return (getChainSettings(getChainParameters(parametersManager)));
+}
+
+// [LUCAS] : This function is a getter for the parameters settings of the EQ,
+//           reading from previously cached parameter values.
+ChainSettings getChainSettings(const ChainParameters& chainParameters)
+{
+    ChainSettings settings;
+
+    settings.lowCutFreq     = chainParameters.lowCutFreq->load();
+    settings.highCutFreq    = chainParameters.highCutFreq->load();
+    settings.peakFreq       = chainParameters.peakFreq->load();
+    settings.peakGainInDb   = chainParameters.peakGainInDb->load();
+    settings.peakQ          = chainParameters.peakQ->load();
+    settings.lowCutSlope    = static_cast<Slope>(static_cast<int>(chainParameters.lowCutSlope->load()));
+    settings.highCutSlope   = static_cast<Slope>(static_cast<int>(chainParameters.highCutSlope->load()));
+
+    return (settings);
+}
+
+//==============================================================================
+// [LUCAS] : The parameters the snapshot listens to
+static const char* const chainParameterIds[] = { "LowCut Freq", "HighCut Freq", "Peak Freq", "Peak Gain",
+                                                  "Peak Quality", "LowCut Slope", "HighCut Slope" };
+
+ChainSettingsSnapshot::ChainSettingsSnapshot(juce::AudioProcessorValueTreeState& parametersManagerToUse)
+    : parametersManager(parametersManagerToUse),
+      chainParameters(getChainParameters(parametersManagerToUse))
+{
+    publish();
+
+    for (auto* parameterId : chainParameterIds)
+        parametersManager.addParameterListener(parameterId, this);
+}
+
+ChainSettingsSnapshot::~ChainSettingsSnapshot()
+{
+    for (auto* parameterId : chainParameterIds)
+        parametersManager.removeParameterListener(parameterId, this);
+}
+
+bool ChainSettingsSnapshot::tryRead(ChainSettings& settings, juce::uint32* readVersion) const noexcept
+{
+    const auto before = version.load(std::memory_order_acquire);
+
+    if ((before & 1u) != 0)
+        return (false);
+
+    ChainSettings copy;
+
+    copy.peakFreq       = peakFreq.load(std::memory_order_relaxed);
+    copy.peakGainInDb   = peakGainInDb.load(std::memory_order_relaxed);
+    copy.peakQ          = peakQ.load(std::memory_order_relaxed);
+    copy.lowCutFreq     = lowCutFreq.load(std::memory_order_relaxed);
+    copy.highCutFreq    = highCutFreq.load(std::memory_order_relaxed);
+    copy.lowCutSlope    = static_cast<Slope>(lowCutSlope.load(std::memory_order_relaxed));
+    copy.highCutSlope   = static_cast<Slope>(highCutSlope.load(std::memory_order_relaxed));
+
+    // [LUCAS] : Keeps the loads above from moving after the second version check
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (version.load(std::memory_order_relaxed) != before)
+        return (false);
+
+    settings = copy;
+
+    if (readVersion != nullptr)
+        *readVersion = before;
+
+    return (true);
+}
+
+ChainSettings ChainSettingsSnapshot::read(juce::uint32* readVersion) const noexcept
+{
+    ChainSettings settings;
+
+    while (! tryRead(settings, readVersion))
+        juce::Thread::yield();
+
+    return (settings);
+}
+
+juce::uint32 ChainSettingsSnapshot::getVersion() const noexcept
+{
+    return (version.load(std::memory_order_acquire));
+}
+
+void ChainSettingsSnapshot::publish() noexcept
+{
+    publishPending.store(true, std::memory_order_release);
+
+    while (publishPending.load(std::memory_order_acquire))
+    {
+        auto current = version.load(std::memory_order_relaxed);
+
+        // [LUCAS] : Another writer holds the snapshot, and will see the pending flag before leaving
+        if ((current & 1u) != 0
+            || ! version.compare_exchange_strong(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return;
+
+        // [LUCAS] : Keeps the stores below from moving before the odd version
+        std::atomic_thread_fence(std::memory_order_release);
+
+        while (publishPending.exchange(false, std::memory_order_acq_rel))
+        {
+            const auto settings = getChainSettings(chainParameters);
+
+            peakFreq.store(settings.peakFreq, std::memory_order_relaxed);
+            peakGainInDb.store(settings.peakGainInDb, std::memory_order_relaxed);
+            peakQ.store(settings.peakQ, std::memory_order_relaxed);
+            lowCutFreq.store(settings.lowCutFreq, std::memory_order_relaxed);
+            highCutFreq.store(settings.highCutFreq, std::memory_order_relaxed);
+            lowCutSlope.store(settings.lowCutSlope, std::memory_order_relaxed);
+            highCutSlope.store(settings.highCutSlope, std::memory_order_relaxed);
+        }
+
+        version.store(current + 2, std::memory_order_release);
+    }
+}
+
+void ChainSettingsSnapshot::parameterChanged(const juce::String&, float)
+{
+    // [LUCAS] : The raw value is already stored, so the whole settings are read back from the raw values
+    publish();
+}
+
+// [LUCAS] : These helper functions tell if the settings of a given filter differ
+bool peakSettingsChanged(const ChainSettings& a, const ChainSettings& b)
+{
+    return (a.peakFreq != b.peakFreq
+         || a.peakGainInDb != b.peakGainInDb
+         || a.peakQ != b.peakQ);
+}
+
+bool lowCutSettingsChanged(const ChainSettings& a, const ChainSettings& b)
+{
+    return (a.lowCutFreq != b.lowCutFreq || a.lowCutSlope != b.lowCutSlope);
+}
+
+bool highCutSettingsChanged(const ChainSettings& a, const ChainSettings& b)
+{
+    return (a.highCutFreq != b.highCutFreq || a.highCutSlope != b.highCutSlope);
+}
+
+// [LUCAS] : These helper functions tell if a given filter leaves the audio unchanged.
+//           The largest deviation of a peak filter from 0 dB is its gain, at its centre frequency.
+bool isPeakNeutral(const ChainSettings& settings, float toleranceInDb)
+{
+    return (toleranceInDb >= 0.f && std::abs(settings.peakGainInDb) <= toleranceInDb);
+}
+
+bool isLowCutNeutral(const ChainSettings& settings, float toleranceInDb)
+{
+    return (toleranceInDb >= 0.f && settings.lowCutFreq <= minCutFrequency);
+}
+
+bool isHighCutNeutral(const ChainSettings& settings, float toleranceInDb, double sampleRate)
+{
+    return (toleranceInDb >= 0.f
+            && (settings.highCutFreq >= maxCutFrequency || (double) settings.highCutFreq >= sampleRate * 0.5));
+}
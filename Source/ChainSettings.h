@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    This file contains the settings of the EQ and how they are read
+    from the parameters manager.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// [LUCAS] : This enum defines and represents the slope of the filters
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+// [LUCAS] : The range of the cut frequencies. A cut filter parked at the end of its range is off.
+constexpr float minCutFrequency = 20.f;
+constexpr float maxCutFrequency = 20000.f;
+
+// [LUCAS] : This structure holds the parameters of the EQ
+struct ChainSettings
+{
+    float peakFreq { 0 }, peakGainInDb { 0 }, peakQ { 1.f };
+    float lowCutFreq { 0 }, highCutFreq { 0 };
+    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+};
+
+// [LUCAS] : This structure holds pointers to the raw parameter values of the EQ,
+//           so they can be read without looking them up by name every time
+struct ChainParameters
+{
+    std::atomic<float>* peakFreq { nullptr };
+    std::atomic<float>* peakGainInDb { nullptr };
+    std::atomic<float>* peakQ { nullptr };
+    std::atomic<float>* lowCutFreq { nullptr };
+    std::atomic<float>* highCutFreq { nullptr };
+    std::atomic<float>* lowCutSlope { nullptr };
+    std::atomic<float>* highCutSlope { nullptr };
+};
+
+// [LUCAS] : This function looks up the raw parameter values of the EQ once.
+ChainParameters getChainParameters(juce::AudioProcessorValueTreeState& parametersManager);
+
+// [LUCAS] : This function is a getter for the parameters settings of the EQ.
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& parametersManager);
+
+// [LUCAS] : This function is a getter for the parameters settings of the EQ,
+//           reading from previously cached parameter values.
+ChainSettings getChainSettings(const ChainParameters& chainParameters);
+
+//==============================================================================
+// [LUCAS] : This class keeps a consistent, versioned copy of the ChainSettings,
+//           that any thread can read without locks and without looking parameters up by name.
+//
+//           It listens to the parameters of the chain, and republishes the whole settings
+//           whenever one of them changes. The copy is guarded by a sequence lock : the version
+//           is odd while a write is in progress, and grows by 2 with every publication,
+//           so comparing versions is enough to know whether anything changed.
+//
+//           The parameters may be set from several threads (message thread, host automation),
+//           so a writer first takes the odd version. A writer finding it taken does not wait :
+//           it leaves a flag, and the writer holding it publishes once more before giving it back.
+class ChainSettingsSnapshot : private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    ChainSettingsSnapshot(juce::AudioProcessorValueTreeState& parametersManager);
+    ~ChainSettingsSnapshot() override;
+
+    // [LUCAS] : Makes a single attempt at reading the settings, and returns false if a write
+    //           was in progress, in which case the audio thread keeps its previous settings.
+    //           Wait-free, so it is safe on the audio thread.
+    bool tryRead(ChainSettings& settings, juce::uint32* version = nullptr) const noexcept;
+
+    // [LUCAS] : Reads the settings, retrying until no write got in the way. Not for the audio thread.
+    ChainSettings read(juce::uint32* version = nullptr) const noexcept;
+
+    // [LUCAS] : The version of the newest settings, even unless a write is in progress
+    juce::uint32 getVersion() const noexcept;
+
+    // [LUCAS] : Republishes the settings from the raw parameter values
+    void publish() noexcept;
+
+private:
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    juce::AudioProcessorValueTreeState& parametersManager;
+    ChainParameters chainParameters;
+
+    std::atomic<juce::uint32> version { 0 };
+    std::atomic<bool> publishPending { false };
+
+    std::atomic<float> peakFreq { 0 }, peakGainInDb { 0 }, peakQ { 1.f };
+    std::atomic<float> lowCutFreq { 0 }, highCutFreq { 0 };
+    std::atomic<int> lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+
+    JUCE_DECLARE_NON_COPYABLE (ChainSettingsSnapshot)
+};
+
+// [LUCAS] : These helper functions tell if the settings of a given filter differ
+bool peakSettingsChanged(const ChainSettings& a, const ChainSettings& b);
+bool lowCutSettingsChanged(const ChainSettings& a, const ChainSettings& b);
+bool highCutSettingsChanged(const ChainSettings& a, const ChainSettings& b);
+
+// [LUCAS] : These helper functions tell if a given filter leaves the audio unchanged, so it can be
+//           left out of the processing : a peak filter within toleranceInDb of 0 dB, or a cut filter
+//           parked at the end of its range (or above Nyquist). A negative tolerance keeps every filter.
+bool isPeakNeutral(const ChainSettings& settings, float toleranceInDb);
+bool isLowCutNeutral(const ChainSettings& settings, float toleranceInDb);
+bool isHighCutNeutral(const ChainSettings& settings, float toleranceInDb, double sampleRate);
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    This file contains the smoothing of the settings of the EQ, used to ramp
+    the filters towards the parameter values without zipper noise.
+
+  ==============================================================================
+*/
+
+#include "ChainSmoother.h"
+
+void ChainSmoother::prepare(double sampleRate, double rampLengthInSeconds)
+{
+    peakFreq.reset(sampleRate, rampLengthInSeconds);
+    peakQ.reset(sampleRate, rampLengthInSeconds);
+    peakGainInDb.reset(sampleRate, rampLengthInSeconds);
+    lowCutFreq.reset(sampleRate, rampLengthInSeconds);
+    highCutFreq.reset(sampleRate, rampLengthInSeconds);
+
+    for (auto& band : bands)
+    {
+        band.freq.reset(sampleRate, rampLengthInSeconds);
+        band.q.reset(sampleRate, rampLengthInSeconds);
+        band.gainInDb.reset(sampleRate, rampLengthInSeconds);
+    }
+}
+
+void ChainSmoother::setCurrentAndTarget(const ChainSettings& chainSettings) noexcept
+{
+    peakFreq.setCurrentAndTargetValue(chainSettings.peakFreq);
+    peakQ.setCurrentAndTargetValue(chainSettings.peakQ);
+    peakGainInDb.setCurrentAndTargetValue(chainSettings.peakGainInDb);
+    lowCutFreq.setCurrentAndTargetValue(chainSettings.lowCutFreq);
+    highCutFreq.setCurrentAndTargetValue(chainSettings.highCutFreq);
+
+    lowCutSlope = chainSettings.lowCutSlope;
+    highCutSlope = chainSettings.highCutSlope;
+}
+
+void ChainSmoother::setTarget(const ChainSettings& chainSettings) noexcept
+{
+    peakFreq.setTargetValue(chainSettings.peakFreq);
+    peakQ.setTargetValue(chainSettings.peakQ);
+    peakGainInDb.setTargetValue(chainSettings.peakGainInDb);
+    lowCutFreq.setTargetValue(chainSettings.lowCutFreq);
+    highCutFreq.setTargetValue(chainSettings.highCutFreq);
+
+    lowCutSlope = chainSettings.lowCutSlope;
+    highCutSlope = chainSettings.highCutSlope;
+}
+
+void ChainSmoother::setCurrentAndTargetBands(const BandSettingsArray& bandSettings) noexcept
+{
+    for (size_t i = 0; i < bands.size(); ++i)
+    {
+        bands[i].freq.setCurrentAndTargetValue(bandSettings[i].freq);
+        bands[i].q.setCurrentAndTargetValue(bandSettings[i].q);
+        bands[i].gainInDb.setCurrentAndTargetValue(bandSettings[i].gainInDb);
+        bands[i].enabled = bandSettings[i].enabled;
+        bands[i].type = bandSettings[i].type;
+    }
+}
+
+void ChainSmoother::setBandTargets(const BandSettingsArray& bandSettings) noexcept
+{
+    for (size_t i = 0; i < bands.size(); ++i)
+    {
+        bands[i].freq.setTargetValue(bandSettings[i].freq);
+        bands[i].q.setTargetValue(bandSettings[i].q);
+        bands[i].gainInDb.setTargetValue(bandSettings[i].gainInDb);
+        bands[i].enabled = bandSettings[i].enabled;
+        bands[i].type = bandSettings[i].type;
+    }
+}
+
+ChainSmoother::BandSettingsArray ChainSmoother::getCurrentBands() const noexcept
+{
+    BandSettingsArray bandSettings;
+
+    for (size_t i = 0; i < bands.size(); ++i)
+    {
+        bandSettings[i].enabled = bands[i].enabled;
+        bandSettings[i].type = bands[i].type;
+        bandSettings[i].freq = bands[i].freq.getCurrentValue();
+        bandSettings[i].q = bands[i].q.getCurrentValue();
+        bandSettings[i].gainInDb = bands[i].gainInDb.getCurrentValue();
+    }
+
+    return (bandSettings);
+}
+
+bool ChainSmoother::isSmoothing() const noexcept
+{
+    const bool bandsSmoothing = std::any_of(bands.begin(), bands.end(), [](const BandRamps& band)
+    {
+        return (band.freq.isSmoothing() || band.q.isSmoothing() || band.gainInDb.isSmoothing());
+    });
+
+    return (peakFreq.isSmoothing()
+         || peakQ.isSmoothing()
+         || peakGainInDb.isSmoothing()
+         || lowCutFreq.isSmoothing()
+         || highCutFreq.isSmoothing()
+         || bandsSmoothing);
+}
+
+ChainSettings ChainSmoother::getCurrent() const noexcept
+{
+    ChainSettings chainSettings;
+
+    chainSettings.peakFreq = peakFreq.getCurrentValue();
+    chainSettings.peakQ = peakQ.getCurrentValue();
+    chainSettings.peakGainInDb = peakGainInDb.getCurrentValue();
+    chainSettings.lowCutFreq = lowCutFreq.getCurrentValue();
+    chainSettings.highCutFreq = highCutFreq.getCurrentValue();
+    chainSettings.lowCutSlope = lowCutSlope;
+    chainSettings.highCutSlope = highCutSlope;
+
+    return (chainSettings);
+}
+
+ChainSettings ChainSmoother::skip(int numSamples) noexcept
+{
+    peakFreq.skip(numSamples);
+    peakQ.skip(numSamples);
+    peakGainInDb.skip(numSamples);
+    lowCutFreq.skip(numSamples);
+    highCutFreq.skip(numSamples);
+
+    for (auto& band : bands)
+    {
+        band.freq.skip(numSamples);
+        band.q.skip(numSamples);
+        band.gainInDb.skip(numSamples);
+    }
+
+    return (getCurrent());
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    This file contains the smoothing of the settings of the EQ, used to ramp
+    the filters towards the parameter values without zipper noise.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+#include "ParametricBands.h"
+
+//==============================================================================
+// [LUCAS] : This class ramps the continuous settings of the EQ towards their targets.
+//           The frequencies and the Q ramp multiplicatively, so a sweep sounds even
+//           across the octaves, and the gain ramps linearly in decibels.
+//           The slopes cannot be ramped : they jump to their target right away.
+//           The parametric bands ramp the same way, while their enabled flags and types jump.
+class ChainSmoother
+{
+public:
+    using BandSettingsArray = std::array<BandSettings, numParametricBands>;
+
+    // [LUCAS] : Sets the length of the ramps. Not to be called from the audio thread.
+    void prepare(double sampleRate, double rampLengthInSeconds);
+
+    // [LUCAS] : Jumps to the given settings, without ramping
+    void setCurrentAndTarget(const ChainSettings& chainSettings) noexcept;
+
+    // [LUCAS] : Starts ramping towards the given settings
+    void setTarget(const ChainSettings& chainSettings) noexcept;
+
+    bool isSmoothing() const noexcept;
+
+    // [LUCAS] : Returns the settings reached so far
+    ChainSettings getCurrent() const noexcept;
+
+    // [LUCAS] : Jumps to, or starts ramping towards, the given settings of the bands
+    void setCurrentAndTargetBands(const BandSettingsArray& bandSettings) noexcept;
+    void setBandTargets(const BandSettingsArray& bandSettings) noexcept;
+
+    // [LUCAS] : Returns the settings of the bands reached so far
+    BandSettingsArray getCurrentBands() const noexcept;
+
+    // [LUCAS] : Advances the ramps by numSamples, and returns the settings reached
+    ChainSettings skip(int numSamples) noexcept;
+
+private:
+    struct BandRamps
+    {
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> freq, q;
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> gainInDb;
+
+        bool enabled { false };
+        BandType type { BandType::Band_Peak };
+    };
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> peakFreq, peakQ, lowCutFreq, highCutFreq;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> peakGainInDb;
+
+    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+
+    std::array<BandRamps, numParametricBands> bands;
+};
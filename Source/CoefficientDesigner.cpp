@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    This file contains the coefficient sets of the EQ, and the background
+    thread that can design them away from the audio thread.
+
+  ==============================================================================
+*/
+
+#include "CoefficientDesigner.h"
+
+// [LUCAS] : This function designs the peak filter coefficients
+void designPeakCoefficients(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate)
+{
+    set.peak = designPeakFilter(chainSettings.peakFreq, chainSettings.peakQ, chainSettings.peakGainInDb,
+                                sampleRate * set.peakOversamplingFactor);
+}
+
+// [LUCAS] : This function designs the low cut filter coefficients,
+//           using the Butterworth method
+void designLowCutCoefficients(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate,
+                              CutCoefficientCache* cache)
+{
+    set.lowCutSlope = chainSettings.lowCutSlope;
+
+    if (cache != nullptr
+        && cache->lookup(CutCoefficientCache::CutType::lowCut, chainSettings.lowCutFreq, chainSettings.lowCutSlope, sampleRate, set.lowCut))
+        return;
+
+    designButterworthHighPass(set.lowCut, chainSettings.lowCutFreq, chainSettings.lowCutSlope, sampleRate);
+
+    if (cache != nullptr)
+        cache->insert(CutCoefficientCache::CutType::lowCut, chainSettings.lowCutFreq, chainSettings.lowCutSlope, sampleRate, set.lowCut);
+}
+
+// [LUCAS] : This function designs the high cut filter coefficients,
+//           using the Butterworth method
+void designHighCutCoefficients(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate,
+                               CutCoefficientCache* cache)
+{
+    set.highCutSlope = chainSettings.highCutSlope;
+
+    if (cache != nullptr
+        && cache->lookup(CutCoefficientCache::CutType::highCut, chainSettings.highCutFreq, chainSettings.highCutSlope, sampleRate, set.highCut))
+        return;
+
+    designButterworthLowPass(set.highCut, chainSettings.highCutFreq, chainSettings.highCutSlope, sampleRate);
+
+    if (cache != nullptr)
+        cache->insert(CutCoefficientCache::CutType::highCut, chainSettings.highCutFreq, chainSettings.highCutSlope, sampleRate, set.highCut);
+}
+
+double getMagnitudeForFrequency(const CoefficientSet& set, double frequency, double sampleRate) noexcept
+{
+    // [LUCAS] : The neutral filters are left out, as they are left out of the chain
+    auto magnitude = 1.0;
+
+    if (! set.peakNeutral)
+        magnitude *= getMagnitudeForFrequency(set.peak, frequency, sampleRate * set.peakOversamplingFactor);
+
+    if (! set.lowCutNeutral)
+        for (int i = 0; i <= set.lowCutSlope; ++i)
+            magnitude *= getMagnitudeForFrequency(set.lowCut[(size_t) i], frequency, sampleRate);
+
+    if (! set.highCutNeutral)
+        for (int i = 0; i <= set.highCutSlope; ++i)
+            magnitude *= getMagnitudeForFrequency(set.highCut[(size_t) i], frequency, sampleRate);
+
+    for (size_t i = 0; i < set.bands.size(); ++i)
+        if (set.activeBands.test(i))
+            magnitude *= getMagnitudeForFrequency(set.bands[i], frequency, sampleRate);
+
+    return (magnitude);
+}
+
+void designParametricBands(CoefficientSet& set, const std::array<BandSettings, numParametricBands>& bandSettings,
+                           double sampleRate, float toleranceInDb) noexcept
+{
+    set.activeBands.reset();
+
+    for (size_t i = 0; i < bandSettings.size(); ++i)
+    {
+        if (isBandNeutral(bandSettings[i], toleranceInDb))
+            continue;
+
+        set.bands[i] = designBandCoefficients(bandSettings[i], sampleRate);
+        set.activeBands.set(i);
+    }
+}
+
+void classifyNeutralStages(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate, float toleranceInDb) noexcept
+{
+    set.peakNeutral = isPeakNeutral(chainSettings, toleranceInDb);
+    set.lowCutNeutral = isLowCutNeutral(chainSettings, toleranceInDb);
+    set.highCutNeutral = isHighCutNeutral(chainSettings, toleranceInDb, sampleRate);
+}
+
+void prewarmCutCoefficientCache(CutCoefficientCache& cache, const ChainSettings& chainSettings, double sampleRate)
+{
+    CoefficientSet set;
+    auto settings = chainSettings;
+
+    for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+    {
+        settings.lowCutSlope = slope;
+        settings.highCutSlope = slope;
+
+        designLowCutCoefficients(set, settings, sampleRate, &cache);
+        designHighCutCoefficients(set, settings, sampleRate, &cache);
+    }
+}
+
+//==============================================================================
+CoefficientDesigner::CoefficientDesigner(const ChainSettingsSnapshot& chainSettingsSnapshotToUse,
+                                         const std::atomic<juce::uint32>& stateSequenceToUse)
+    : juce::Thread("SimpleEQ Coefficient Designer"),
+      chainSettingsSnapshot(chainSettingsSnapshotToUse),
+      stateSequence(stateSequenceToUse)
+{
+}
+
+CoefficientDesigner::~CoefficientDesigner()
+{
+    stop();
+}
+
+void CoefficientDesigner::start(double newSampleRate, float neutralToleranceInDb, int peakOversamplingFactor)
+{
+    stop();
+
+    sampleRate.store(newSampleRate);
+    neutralTolerance.store(neutralToleranceInDb);
+
+    // [LUCAS] : The thread is stopped, so its set can be changed from here
+    designedSet.peakOversamplingFactor = peakOversamplingFactor;
+
+    // [LUCAS] : Forces a complete redesign for the new sample rate
+    designedSampleRate = 0.0;
+
+    startThread();
+}
+
+void CoefficientDesigner::stop()
+{
+    stopThread(1000);
+}
+
+const CoefficientSet* CoefficientDesigner::getNewCoefficients() noexcept
+{
+    return (coefficientBuffer.read());
+}
+
+void CoefficientDesigner::run()
+{
+    while (! threadShouldExit())
+    {
+        designIfChanged();
+        wait(pollIntervalMs);
+    }
+}
+
+void CoefficientDesigner::designIfChanged()
+{
+    const auto currentSampleRate = sampleRate.load();
+    const bool sampleRateChanged = (currentSampleRate != designedSampleRate);
+
+    // [LUCAS] : Nothing was published since the last design
+    if (! sampleRateChanged && chainSettingsSnapshot.getVersion() == designedVersion)
+        return;
+
+    // [LUCAS] : A state being restored sets the parameters one by one, so its settings
+    //           are only designed once it is whole, like readChainSettings does
+    const auto sequence = stateSequence.load(std::memory_order_acquire);
+
+    if ((sequence & 1u) != 0)
+        return;
+
+    juce::uint32 version = 0;
+    const auto chainSettings = chainSettingsSnapshot.read(&version);
+
+    if (stateSequence.load(std::memory_order_acquire) != sequence)
+        return;
+
+    designedVersion = version;
+    designedSet.stateSequence = sequence;
+
+    bool changed = false;
+
+    if (sampleRateChanged || peakSettingsChanged(chainSettings, designedSettings))
+    {
+        designPeakCoefficients(designedSet, chainSettings, currentSampleRate);
+        changed = true;
+    }
+
+    if (sampleRateChanged || lowCutSettingsChanged(chainSettings, designedSettings))
+    {
+        designLowCutCoefficients(designedSet, chainSettings, currentSampleRate, cutCoefficientCache.get());
+        changed = true;
+    }
+
+    if (sampleRateChanged || highCutSettingsChanged(chainSettings, designedSettings))
+    {
+        designHighCutCoefficients(designedSet, chainSettings, currentSampleRate, cutCoefficientCache.get());
+        changed = true;
+    }
+
+    if (! changed)
+        return;
+
+    classifyNeutralStages(designedSet, chainSettings, currentSampleRate, neutralTolerance.load());
+
+    designedSettings = chainSettings;
+    designedSampleRate = currentSampleRate;
+
+    // [LUCAS] : Hands the finished set over to the audio thread
+    coefficientBuffer.getWriteBuffer() = designedSet;
+    coefficientBuffer.publish();
+}
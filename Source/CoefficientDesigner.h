@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    This file contains the coefficient sets of the EQ, and the background
+    thread that can design them away from the audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "CascadeDesign.h"
+#include "ChainSettings.h"
+#include "CutCoefficientCache.h"
+#include "ParametricBands.h"
+#include "TripleBuffer.h"
+
+// [LUCAS] : This structure holds all the coefficients of a MonoChain,
+//           as plain values that can be copied without allocating
+struct CoefficientSet
+{
+    std::array<BiquadCoefficients, 4> lowCut;
+    BiquadCoefficients peak;
+    std::array<BiquadCoefficients, 4> highCut;
+    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+
+    // [LUCAS] : The filters that leave the audio unchanged, and are left out of the chain
+    bool peakNeutral { false }, lowCutNeutral { false }, highCutNeutral { false };
+
+    // [LUCAS] : The peak is designed for the sample rate times this factor, as it runs oversampled
+    int peakOversamplingFactor { 1 };
+
+    // [LUCAS] : The parametric bands as biquads, for the response curve and the linear phase kernel.
+    //           Only the bands flagged in activeBands are part of the chain.
+    std::array<BiquadCoefficients, numParametricBands> bands;
+    std::bitset<numParametricBands> activeBands;
+
+    // [LUCAS] : The state sequence of the processor the settings were read at,
+    //           so a set designed before a restored state can be told apart
+    juce::uint32 stateSequence { 0 };
+};
+
+// [LUCAS] : These functions design the coefficients of one filter of the chain
+//           into a CoefficientSet, based on the given chainSettings.
+//           They neither allocate nor lock, so they are safe on the audio thread.
+//           The cut filters are read from the cache when it holds them,
+//           and added to it when they had to be designed.
+//           The peak is designed at the oversampled rate of the set.
+void designPeakCoefficients(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate);
+void designLowCutCoefficients(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate,
+                              CutCoefficientCache* cache = nullptr);
+void designHighCutCoefficients(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate,
+                               CutCoefficientCache* cache = nullptr);
+
+// [LUCAS] : This function designs the parametric bands into the set as biquads,
+//           leaving out the neutral ones (see isBandNeutral)
+void designParametricBands(CoefficientSet& set, const std::array<BandSettings, numParametricBands>& bandSettings,
+                           double sampleRate, float toleranceInDb) noexcept;
+
+// [LUCAS] : This function flags the filters of the set that leave the audio unchanged,
+//           within toleranceInDb (see isPeakNeutral)
+void classifyNeutralStages(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate, float toleranceInDb) noexcept;
+
+// [LUCAS] : Designs the cut filters of every slope at the current cut frequencies,
+//           so that changing the slopes never needs a design. Not for the audio thread.
+void prewarmCutCoefficientCache(CutCoefficientCache& cache, const ChainSettings& chainSettings, double sampleRate);
+
+// [LUCAS] : This function returns the magnitude response of the whole chain at the given frequency,
+//           taking the slopes of the cut filters and the active parametric bands into account.
+//           The filters flagged neutral are left out, like they are left out of the chain.
+double getMagnitudeForFrequency(const CoefficientSet& set, double frequency, double sampleRate) noexcept;
+
+// [LUCAS] : This enum defines where the filter coefficients are designed
+enum class CoefficientUpdateMode
+{
+    // [LUCAS] : The coefficients are designed in processBlock, when the parameters change
+    audioThread,
+
+    // [LUCAS] : The coefficients are designed by a CoefficientDesigner thread,
+    //           and processBlock only copies the finished coefficients
+    backgroundThread,
+
+    // [LUCAS] : The parameters ramp towards their new values, and processBlock redesigns
+    //           the coefficients every few samples, so automation never zippers
+    smoothed
+};
+
+//==============================================================================
+// [LUCAS] : This thread watches the settings snapshot of the EQ, designs the coefficients
+//           of the filters whose settings changed, and publishes the finished
+//           CoefficientSet to the audio thread through a TripleBuffer.
+//           The audio thread never waits, never locks and never frees memory.
+class CoefficientDesigner : private juce::Thread
+{
+public:
+    // [LUCAS] : The stateSequence is odd while the processor restores a state,
+    //           during which nothing is designed
+    CoefficientDesigner(const ChainSettingsSnapshot& chainSettingsSnapshot, const std::atomic<juce::uint32>& stateSequence);
+    ~CoefficientDesigner() override;
+
+    // [LUCAS] : Starts designing for the given sample rate, leaving out the filters
+    //           that are neutral within neutralToleranceInDb, with the peak designed for its
+    //           oversampling factor. Not to be called from the audio thread.
+    void start(double sampleRate, float neutralToleranceInDb, int peakOversamplingFactor = 1);
+
+    // [LUCAS] : Stops the thread. Not to be called from the audio thread.
+    void stop();
+
+    // [LUCAS] : Audio thread : returns the newest CoefficientSet,
+    //           or nullptr if nothing changed since the last call
+    const CoefficientSet* getNewCoefficients() noexcept;
+
+private:
+    void run() override;
+
+    // [LUCAS] : Redesigns the filters whose settings changed, and publishes the result
+    void designIfChanged();
+
+    // [LUCAS] : How often the parameters are checked for changes
+    static constexpr int pollIntervalMs = 2;
+
+    const ChainSettingsSnapshot& chainSettingsSnapshot;
+    const std::atomic<juce::uint32>& stateSequence;
+
+    juce::SharedResourcePointer<CutCoefficientCache> cutCoefficientCache;
+
+    TripleBuffer<CoefficientSet> coefficientBuffer;
+
+    // [LUCAS] : Only touched by the designer thread
+    CoefficientSet designedSet;
+    ChainSettings designedSettings;
+    juce::uint32 designedVersion { 0 };
+    double designedSampleRate { 0.0 };
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<float> neutralTolerance { 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoefficientDesigner)
+};
@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    This file contains the cache of Butterworth cut filter designs, shared by
+    every instance of the plugin in the process.
+
+  ==============================================================================
+*/
+
+#include "CutCoefficientCache.h"
+
+CutCoefficientCache::CutCoefficientCache()
+    : entries(new Entry[(size_t) numEntries])
+{
+    static_assert((numEntries & (numEntries - 1)) == 0, "numEntries must be a power of two");
+}
+
+juce::uint64 CutCoefficientCache::makeKey(CutType type, float frequency, Slope slope, double sampleRate) noexcept
+{
+    const auto wholeFrequency = (juce::uint64) frequency;
+    const auto wholeSampleRate = (juce::uint64) sampleRate;
+
+    if ((float) wholeFrequency != frequency || (double) wholeSampleRate != sampleRate
+        || wholeFrequency == 0 || wholeFrequency >= (1u << 24) || wholeSampleRate >= (1u << 24))
+        return (0);
+
+    // [LUCAS] : [sampleRate : 24 bits] [frequency : 24 bits] [slope : 8 bits] [type : 8 bits]
+    return ((wholeSampleRate << 40) | (wholeFrequency << 16) | ((juce::uint64) slope << 8) | (juce::uint64) type);
+}
+
+size_t CutCoefficientCache::getFirstIndex(juce::uint64 key) noexcept
+{
+    // [LUCAS] : splitmix64 finaliser, to spread neighbouring frequencies over the table
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+
+    return ((size_t) key & (size_t) (numEntries - 1));
+}
+
+bool CutCoefficientCache::lookup(CutType type, float frequency, Slope slope, double sampleRate, Sections& sections) const noexcept
+{
+    const auto key = makeKey(type, frequency, slope, sampleRate);
+
+    if (key != 0)
+    {
+        const auto firstIndex = getFirstIndex(key);
+
+        for (int probe = 0; probe < probeLength; ++probe)
+        {
+            const auto& entry = entries[(firstIndex + (size_t) probe) & (size_t) (numEntries - 1)];
+
+            const auto sequence = entry.sequence.load(std::memory_order_acquire);
+            const auto entryKey = entry.key.load(std::memory_order_relaxed);
+
+            // [LUCAS] : Entries are never removed, so an empty one ends the search
+            if (entryKey == 0 && (sequence & 1) == 0)
+                break;
+
+            if (entryKey != key || (sequence & 1) != 0)
+                continue;
+
+            std::array<double, numValues> values;
+
+            for (size_t i = 0; i < values.size(); ++i)
+                values[i] = entry.values[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // [LUCAS] : The entry was overwritten while it was read
+            if (entry.sequence.load(std::memory_order_relaxed) != sequence)
+                break;
+
+            for (size_t section = 0; section < sections.size(); ++section)
+            {
+                const auto* value = values.data() + section * 5;
+                sections[section] = { value[0], value[1], value[2], value[3], value[4] };
+            }
+
+            numHits.fetch_add(1, std::memory_order_relaxed);
+            return (true);
+        }
+    }
+
+    numMisses.fetch_add(1, std::memory_order_relaxed);
+    return (false);
+}
+
+void CutCoefficientCache::insert(CutType type, float frequency, Slope slope, double sampleRate, const Sections& sections) noexcept
+{
+    const auto key = makeKey(type, frequency, slope, sampleRate);
+
+    if (key == 0)
+        return;
+
+    const auto firstIndex = getFirstIndex(key);
+
+    // [LUCAS] : Takes the entry already holding this key, or the first empty one,
+    //           or else evicts one of the probed entries
+    auto index = (firstIndex + nextVictim.fetch_add(1, std::memory_order_relaxed) % (juce::uint32) probeLength)
+               & (size_t) (numEntries - 1);
+
+    for (int probe = 0; probe < probeLength; ++probe)
+    {
+        const auto probedIndex = (firstIndex + (size_t) probe) & (size_t) (numEntries - 1);
+        const auto entryKey = entries[probedIndex].key.load(std::memory_order_relaxed);
+
+        if (entryKey == key || entryKey == 0)
+        {
+            index = probedIndex;
+            break;
+        }
+    }
+
+    auto& entry = entries[index];
+    auto sequence = entry.sequence.load(std::memory_order_relaxed);
+
+    // [LUCAS] : Another thread is writing this entry : this design will simply not be cached
+    if ((sequence & 1) != 0 || ! entry.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+        return;
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry.key.store(key, std::memory_order_relaxed);
+
+    for (size_t section = 0; section < sections.size(); ++section)
+    {
+        const auto& coefficients = sections[section];
+        auto* value = entry.values.data() + section * 5;
+
+        value[0].store(coefficients.b0, std::memory_order_relaxed);
+        value[1].store(coefficients.b1, std::memory_order_relaxed);
+        value[2].store(coefficients.b2, std::memory_order_relaxed);
+        value[3].store(coefficients.a1, std::memory_order_relaxed);
+        value[4].store(coefficients.a2, std::memory_order_relaxed);
+    }
+
+    entry.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+juce::uint64 CutCoefficientCache::getNumHits() const noexcept
+{
+    return (numHits.load());
+}
+
+juce::uint64 CutCoefficientCache::getNumMisses() const noexcept
+{
+    return (numMisses.load());
+}
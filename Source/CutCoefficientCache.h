@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    This file contains the cache of Butterworth cut filter designs, shared by
+    every instance of the plugin in the process.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "ChainSettings.h"
+
+//==============================================================================
+// [LUCAS] : This class caches the sections of the low cut and high cut designs.
+//           The frequency parameters move in 1 Hz steps, there are four slopes and
+//           only a handful of sample rates, so many instances keep designing the
+//           very same filters : they are designed once, and then read from here.
+//
+//           The cache is an open addressing hash table with a fixed number of entries,
+//           so its memory is bounded : when the probed entries are all taken, one of
+//           them is evicted. Every entry is protected by a sequence counter, so that
+//           lookups never lock nor wait, and an insertion simply gives up if another
+//           thread is writing the same entry.
+//
+//           Use it through a juce::SharedResourcePointer<CutCoefficientCache>.
+class CutCoefficientCache
+{
+public:
+    enum class CutType
+    {
+        lowCut,
+        highCut
+    };
+
+    using Sections = std::array<BiquadCoefficients, 4>;
+
+    static constexpr int numEntries = 4096;
+    static constexpr int probeLength = 8;
+
+    CutCoefficientCache();
+
+    // [LUCAS] : Copies a cached design into sections and returns true,
+    //           or returns false if the design is not cached. Lock free.
+    bool lookup(CutType type, float frequency, Slope slope, double sampleRate, Sections& sections) const noexcept;
+
+    // [LUCAS] : Adds a design to the cache. Lock free.
+    void insert(CutType type, float frequency, Slope slope, double sampleRate, const Sections& sections) noexcept;
+
+    // [LUCAS] : Statistics, for the benchmarks
+    juce::uint64 getNumHits() const noexcept;
+    juce::uint64 getNumMisses() const noexcept;
+
+private:
+    static constexpr int numValues = 4 * 5;
+
+    struct Entry
+    {
+        // [LUCAS] : Odd while a thread is writing the entry
+        std::atomic<juce::uint32> sequence { 0 };
+        std::atomic<juce::uint64> key { 0 };
+        std::array<std::atomic<double>, numValues> values;
+    };
+
+    // [LUCAS] : Packs the design parameters into a key, or returns 0
+    //           if they are not whole numbers of Hz and cannot be cached
+    static juce::uint64 makeKey(CutType type, float frequency, Slope slope, double sampleRate) noexcept;
+
+    static size_t getFirstIndex(juce::uint64 key) noexcept;
+
+    std::unique_ptr<Entry[]> entries;
+
+    std::atomic<juce::uint32> nextVictim { 0 };
+    mutable std::atomic<juce::uint64> numHits { 0 }, numMisses { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CutCoefficientCache)
+};
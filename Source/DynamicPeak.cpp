@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    This file contains the dynamic mode of the peak filter : an envelope
+    follower that moves the peak gain like a compressor, and the cheap peak
+    design it redesigns the filter with at every control interval.
+
+  ==============================================================================
+*/
+
+#include "DynamicPeak.h"
+
+void addDynamicParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout)
+{
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("Dynamic Enabled", 1),
+        "Dynamic Enabled",
+        false
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("Dynamic Threshold", 1),
+        "Dynamic Threshold",
+        juce::NormalisableRange<float>(-60.f, 0.f, 0.5f, 1.f),
+        -24.0f
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("Dynamic Ratio", 1),
+        "Dynamic Ratio",
+        juce::NormalisableRange<float>(1.f, 20.f, 0.1f, 0.4f),
+        2.0f
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("Dynamic Attack", 1),
+        "Dynamic Attack",
+        juce::NormalisableRange<float>(0.1f, 200.f, 0.1f, 0.4f),
+        10.0f
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("Dynamic Release", 1),
+        "Dynamic Release",
+        juce::NormalisableRange<float>(5.f, 2000.f, 1.f, 0.4f),
+        150.0f
+    ));
+}
+
+DynamicParameters getDynamicParameters(juce::AudioProcessorValueTreeState& parametersManager)
+{
+    DynamicParameters parameters;
+
+    parameters.enabled       = parametersManager.getRawParameterValue("Dynamic Enabled");
+    parameters.thresholdInDb = parametersManager.getRawParameterValue("Dynamic Threshold");
+    parameters.ratio         = parametersManager.getRawParameterValue("Dynamic Ratio");
+    parameters.attackInMs    = parametersManager.getRawParameterValue("Dynamic Attack");
+    parameters.releaseInMs   = parametersManager.getRawParameterValue("Dynamic Release");
+
+    return (parameters);
+}
+
+DynamicSettings getDynamicSettings(const DynamicParameters& dynamicParameters)
+{
+    DynamicSettings settings;
+
+    settings.enabled       = dynamicParameters.enabled->load() >= 0.5f;
+    settings.thresholdInDb = dynamicParameters.thresholdInDb->load();
+    settings.ratio         = dynamicParameters.ratio->load();
+    settings.attackInMs    = dynamicParameters.attackInMs->load();
+    settings.releaseInMs   = dynamicParameters.releaseInMs->load();
+
+    return (settings);
+}
+
+//==============================================================================
+void PeakGainDesigner::prepare(float frequency, float q, double sampleRate) noexcept
+{
+    if (frequency == preparedFrequency && q == preparedQ && sampleRate == preparedSampleRate)
+        return;
+
+    jassert(sampleRate > 0.0 && q > 0.0f);
+
+    // [LUCAS] : The same terms as designPeakFilter and designStateVariablePeak
+    const auto omega = juce::MathConstants<double>::twoPi * juce::jmax((double) frequency, 2.0) / sampleRate;
+
+    alpha = std::sin(omega) / (2.0 * (double) q);
+    c2 = -2.0 * std::cos(omega);
+    g = std::tan(omega * 0.5);
+    inverseQ = 1.0 / (double) q;
+
+    preparedFrequency = frequency;
+    preparedQ = q;
+    preparedSampleRate = sampleRate;
+}
+
+// [LUCAS] : A is the square root of the linear gain, 10 ^ (gain / 40)
+static double getPeakA(float gainInDb) noexcept
+{
+    return (std::exp((double) gainInDb * (std::log(10.0) / 40.0)));
+}
+
+BiquadCoefficients PeakGainDesigner::design(float gainInDb) const noexcept
+{
+    const auto a = getPeakA(gainInDb);
+    const auto a0 = 1.0 / (1.0 + alpha / a);
+
+    return (BiquadCoefficients { (1.0 + alpha * a) * a0,
+                                 c2 * a0,
+                                 (1.0 - alpha * a) * a0,
+                                 c2 * a0,
+                                 (1.0 - alpha / a) * a0 });
+}
+
+StateVariableCoefficients PeakGainDesigner::designStateVariable(float gainInDb) const noexcept
+{
+    const auto a = getPeakA(gainInDb);
+    const auto k = inverseQ / a;
+
+    return (StateVariableCoefficients { g, k, 1.0, k * (a * a - 1.0), 0.0 });
+}
+
+//==============================================================================
+void DynamicPeak::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void DynamicPeak::reset() noexcept
+{
+    envelopeInDb = silenceInDb;
+    gainReductionInDb = 0.f;
+}
+
+void DynamicPeak::setSettings(const DynamicSettings& newSettings) noexcept
+{
+    settings = newSettings;
+}
+
+float DynamicPeak::skip(int numSamples) noexcept
+{
+    return (advance(silenceInDb, numSamples));
+}
+
+float DynamicPeak::getGainReductionInDb() const noexcept
+{
+    return (gainReductionInDb);
+}
+
+float DynamicPeak::advance(float levelInDb, int numSamples) noexcept
+{
+    // [LUCAS] : A one pole ramp over the whole interval, so the times hold whatever its length
+    const auto timeInMs = (levelInDb > envelopeInDb ? settings.attackInMs : settings.releaseInMs);
+    const auto timeInSamples = juce::jmax(1.0, (double) timeInMs * 0.001 * sampleRate);
+    const auto coefficient = (float) std::exp(-(double) numSamples / timeInSamples);
+
+    envelopeInDb = levelInDb + coefficient * (envelopeInDb - levelInDb);
+
+    const auto overshootInDb = envelopeInDb - settings.thresholdInDb;
+
+    gainReductionInDb = (overshootInDb > 0.f
+                         ? -juce::jmin(maxGainReductionInDb, overshootInDb * (1.f - 1.f / juce::jmax(1.f, settings.ratio)))
+                         : 0.f);
+
+    return (gainReductionInDb);
+}
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    This file contains the dynamic mode of the peak filter : an envelope
+    follower that moves the peak gain like a compressor, and the cheap peak
+    design it redesigns the filter with at every control interval.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+
+// [LUCAS] : This structure holds the parameters of the dynamic peak
+struct DynamicSettings
+{
+    bool enabled { false };
+    float thresholdInDb { -24.f }, ratio { 2.f };
+    float attackInMs { 10.f }, releaseInMs { 150.f };
+};
+
+// [LUCAS] : This structure holds pointers to the raw parameter values of the dynamic peak
+struct DynamicParameters
+{
+    std::atomic<float>* enabled { nullptr };
+    std::atomic<float>* thresholdInDb { nullptr };
+    std::atomic<float>* ratio { nullptr };
+    std::atomic<float>* attackInMs { nullptr };
+    std::atomic<float>* releaseInMs { nullptr };
+};
+
+// [LUCAS] : This function adds the Dynamic Enabled, Threshold, Ratio, Attack and Release parameters
+void addDynamicParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout);
+
+// [LUCAS] : This function looks up the raw parameter values of the dynamic peak once
+DynamicParameters getDynamicParameters(juce::AudioProcessorValueTreeState& parametersManager);
+
+// [LUCAS] : This function is a getter for the settings of the dynamic peak, reading from cached parameter values
+DynamicSettings getDynamicSettings(const DynamicParameters& dynamicParameters);
+
+//==============================================================================
+// [LUCAS] : This class designs a peak filter whose gain changes far more often than its
+//           frequency and Q. The terms of the frequency and the Q are computed once,
+//           so a new gain only costs an exp and a few multiplications, with the same
+//           coefficients as designPeakFilter and designStateVariablePeak.
+class PeakGainDesigner
+{
+public:
+    // [LUCAS] : Computes the terms of the frequency and the Q, unless they did not change
+    void prepare(float frequency, float q, double sampleRate) noexcept;
+
+    BiquadCoefficients design(float gainInDb) const noexcept;
+    StateVariableCoefficients designStateVariable(float gainInDb) const noexcept;
+
+private:
+    float preparedFrequency { -1.f }, preparedQ { -1.f };
+    double preparedSampleRate { 0.0 };
+
+    double alpha { 0.0 }, c2 { 0.0 };
+    double g { 0.0 }, inverseQ { 1.0 };
+};
+
+//==============================================================================
+// [LUCAS] : This class follows the level of the input, one control interval at a time.
+//           The level of an interval is its peak over every channel, found with the
+//           vectorised FloatVectorOperations, and the envelope ramps towards it in
+//           decibels with the attack or the release time. Above the threshold,
+//           the envelope is turned into a gain reduction, as a downward compressor would.
+class DynamicPeak
+{
+public:
+    // [LUCAS] : The gain reduction stops at the range of the Peak Gain parameter
+    static constexpr float maxGainReductionInDb = 24.f;
+
+    void prepare(double sampleRate) noexcept;
+    void reset() noexcept;
+
+    void setSettings(const DynamicSettings& newSettings) noexcept;
+
+    // [LUCAS] : Measures the level of block, and returns the gain reduction in dB (0 or less)
+    template<typename SampleType>
+    float process(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        SampleType peak = 0;
+
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(channel), (int) block.getNumSamples());
+            peak = juce::jmax(peak, -range.getStart(), range.getEnd());
+        }
+
+        return (advance(juce::Decibels::gainToDecibels((float) peak, silenceInDb), (int) block.getNumSamples()));
+    }
+
+    // [LUCAS] : Lets the envelope release over numSamples of silence
+    float skip(int numSamples) noexcept;
+
+    float getGainReductionInDb() const noexcept;
+
+private:
+    static constexpr float silenceInDb = -100.f;
+
+    float advance(float levelInDb, int numSamples) noexcept;
+
+    DynamicSettings settings;
+    double sampleRate { 44100.0 };
+    float envelopeInDb { silenceInDb };
+    float gainReductionInDb { 0.f };
+};
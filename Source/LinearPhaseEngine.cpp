@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    This file contains the linear phase mode of the EQ : the same curve as the
+    filter chain, applied as a linear phase FIR with partitioned convolution.
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseEngine.h"
+
+LinearPhaseEngine::LinearPhaseEngine(const ChainSettingsSnapshot& chainSettingsSnapshotToUse,
+                                     const std::array<BandParameters, numParametricBands>& bandParametersToUse,
+                                     const std::atomic<juce::uint32>& stateSequenceToUse)
+    : juce::Thread("SimpleEQ Linear Phase Designer"),
+      chainSettingsSnapshot(chainSettingsSnapshotToUse),
+      bandParameters(bandParametersToUse),
+      stateSequence(stateSequenceToUse)
+{
+}
+
+LinearPhaseEngine::~LinearPhaseEngine()
+{
+    stop();
+}
+
+void LinearPhaseEngine::prepare(const juce::dsp::ProcessSpec& spec, int newFirLength, int convolutionLatency,
+                                float neutralToleranceInDb)
+{
+    stop();
+
+    sampleRate = spec.sampleRate;
+    neutralTolerance = neutralToleranceInDb;
+    firLength = juce::jlimit(minFirLength, maxFirLength, juce::nextPowerOfTwo(newFirLength));
+
+    convolutions.clear();
+
+    for (juce::uint32 channel = 0; channel < spec.numChannels; channel += 2)
+    {
+        std::unique_ptr<juce::dsp::Convolution> convolution;
+
+        if (convolutionLatency > 0)
+            convolution = std::make_unique<juce::dsp::Convolution>(juce::dsp::Convolution::Latency { convolutionLatency }, messageQueue);
+        else
+            convolution = std::make_unique<juce::dsp::Convolution>(juce::dsp::Convolution::NonUniform { headSize }, messageQueue);
+
+        convolution->prepare({ spec.sampleRate, spec.maximumBlockSize, juce::jmin((juce::uint32) 2, spec.numChannels - channel) });
+        convolutions.push_back(std::move(convolution));
+    }
+
+    latencySamples = firLength / 2 + (convolutions.empty() ? 0 : convolutions.front()->getLatency());
+
+    designedSettings = chainSettingsSnapshot.read(&designedVersion);
+    designedBandSettings = readBandSettings();
+    loadKernel(designedSettings, designedBandSettings);
+
+    startThread();
+}
+
+void LinearPhaseEngine::stop()
+{
+    stopThread(1000);
+}
+
+void LinearPhaseEngine::reset() noexcept
+{
+    for (auto& convolution : convolutions)
+        convolution->reset();
+}
+
+int LinearPhaseEngine::getLatencySamples() const noexcept
+{
+    return (latencySamples);
+}
+
+int LinearPhaseEngine::getFirLength() const noexcept
+{
+    return (firLength);
+}
+
+void LinearPhaseEngine::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    const auto numChannels = block.getNumChannels();
+
+    for (size_t pair = 0; pair < convolutions.size(); ++pair)
+    {
+        const auto firstChannel = pair * 2;
+
+        if (firstChannel >= numChannels)
+            break;
+
+        auto pairBlock = block.getSubsetChannelBlock(firstChannel, juce::jmin((size_t) 2, numChannels - firstChannel));
+        juce::dsp::ProcessContextReplacing<float> context(pairBlock);
+        convolutions[pair]->process(context);
+    }
+}
+
+const CoefficientSet* LinearPhaseEngine::getNewCoefficients() noexcept
+{
+    return (designedCoefficients.read());
+}
+
+//==============================================================================
+juce::AudioBuffer<float> LinearPhaseEngine::designKernel(const ChainSettings& chainSettings, double sampleRate, int firLength)
+{
+    CoefficientSet set;
+    designPeakCoefficients(set, chainSettings, sampleRate);
+    designLowCutCoefficients(set, chainSettings, sampleRate);
+    designHighCutCoefficients(set, chainSettings, sampleRate);
+
+    return (designKernel(set, sampleRate, firLength));
+}
+
+juce::AudioBuffer<float> LinearPhaseEngine::designKernel(const CoefficientSet& set, double sampleRate, int firLength)
+{
+    // [LUCAS] : A zero phase spectrum holding the magnitude response of the chain on the FFT grid.
+    //           Its inverse transform is real and symmetric around the first sample.
+    juce::dsp::FFT fft(juce::roundToInt(std::log2((double) firLength)));
+    std::vector<float> spectrum((size_t) (2 * firLength), 0.0f);
+
+    for (int bin = 0; bin <= firLength / 2; ++bin)
+    {
+        const auto frequency = (double) bin * sampleRate / (double) firLength;
+        const auto magnitude = (float) getMagnitudeForFrequency(set, frequency, sampleRate);
+
+        spectrum[(size_t) (2 * bin)] = magnitude;
+
+        if (bin > 0 && bin < firLength / 2)
+            spectrum[(size_t) (2 * (firLength - bin))] = magnitude;
+    }
+
+    fft.performRealOnlyInverseTransform(spectrum.data());
+
+    // [LUCAS] : Centres the kernel, so that it is causal with a delay of firLength / 2,
+    //           and windows it to smooth the ripples of the frequency sampling
+    juce::AudioBuffer<float> kernel(1, firLength);
+    auto* samples = kernel.getWritePointer(0);
+
+    for (int i = 0; i < firLength; ++i)
+        samples[i] = spectrum[(size_t) ((i + firLength / 2) % firLength)];
+
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(spectrum.data(), (size_t) firLength,
+                                                             juce::dsp::WindowingFunction<float>::blackman, false);
+
+    for (int i = 0; i < firLength; ++i)
+        samples[i] *= spectrum[(size_t) i];
+
+    return (kernel);
+}
+
+void LinearPhaseEngine::loadKernel(const ChainSettings& chainSettings, const BandSettingsArray& bandSettings)
+{
+    auto& set = designedCoefficients.getWriteBuffer();
+    designPeakCoefficients(set, chainSettings, sampleRate);
+    designLowCutCoefficients(set, chainSettings, sampleRate);
+    designHighCutCoefficients(set, chainSettings, sampleRate);
+    designParametricBands(set, bandSettings, sampleRate, neutralTolerance);
+
+    // [LUCAS] : The kernel leaves out the neutral filters, so it renders the same curve as the minimum phase chain
+    classifyNeutralStages(set, chainSettings, sampleRate, neutralTolerance);
+
+    const auto kernel = designKernel(set, sampleRate, firLength);
+    designedCoefficients.publish();
+
+    // [LUCAS] : Each convolution takes ownership of its own copy.
+    //           The kernel is applied to both channels of the pair.
+    for (auto& convolution : convolutions)
+        convolution->loadImpulseResponse(juce::AudioBuffer<float>(kernel),
+                                         sampleRate,
+                                         juce::dsp::Convolution::Stereo::no,
+                                         juce::dsp::Convolution::Trim::no,
+                                         juce::dsp::Convolution::Normalise::no);
+}
+
+void LinearPhaseEngine::run()
+{
+    while (! threadShouldExit())
+    {
+        // [LUCAS] : A state being restored sets the parameters one by one, so its settings
+        //           are only designed once it is whole, like in the CoefficientDesigner
+        const auto sequence = stateSequence.load(std::memory_order_acquire);
+
+        if ((sequence & 1u) == 0)
+            designIfChanged(sequence);
+
+        wait(pollIntervalMs);
+    }
+}
+
+void LinearPhaseEngine::designIfChanged(juce::uint32 sequence)
+{
+    // [LUCAS] : The chain settings are only compared when a new version was published.
+    //           The bands have no snapshot, so their few raw values are compared every time.
+    const auto bandSettings = readBandSettings();
+    const bool bandsChanged = ! std::equal(bandSettings.begin(), bandSettings.end(), designedBandSettings.begin(),
+                                           [](const BandSettings& a, const BandSettings& b) { return (! bandSettingsChanged(a, b)); });
+
+    if (! bandsChanged && chainSettingsSnapshot.getVersion() == designedVersion)
+        return;
+
+    juce::uint32 version = 0;
+    const auto chainSettings = chainSettingsSnapshot.read(&version);
+
+    if (stateSequence.load(std::memory_order_acquire) != sequence)
+        return;
+
+    designedVersion = version;
+
+    if (bandsChanged
+        || peakSettingsChanged(chainSettings, designedSettings)
+        || lowCutSettingsChanged(chainSettings, designedSettings)
+        || highCutSettingsChanged(chainSettings, designedSettings))
+    {
+        loadKernel(chainSettings, bandSettings);
+        designedSettings = chainSettings;
+        designedBandSettings = bandSettings;
+    }
+}
+
+LinearPhaseEngine::BandSettingsArray LinearPhaseEngine::readBandSettings() const
+{
+    BandSettingsArray bandSettings;
+
+    for (size_t band = 0; band < bandSettings.size(); ++band)
+        bandSettings[band] = getBandSettings(bandParameters[band]);
+
+    return (bandSettings);
+}
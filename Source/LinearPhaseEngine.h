@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    This file contains the linear phase mode of the EQ : the same curve as the
+    filter chain, applied as a linear phase FIR with partitioned convolution.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+#include "CoefficientDesigner.h"
+#include "ParametricBands.h"
+
+// [LUCAS] : This enum defines how the EQ curve is applied
+enum class PhaseMode
+{
+    // [LUCAS] : The IIR filter chain : no latency, but the phase turns around the filters
+    minimumPhase,
+
+    // [LUCAS] : A linear phase FIR with the same magnitude response :
+    //           no phase distortion, but half the FIR length of latency
+    linearPhase
+};
+
+//==============================================================================
+// [LUCAS] : This class applies the magnitude response of the filter chain as a linear phase FIR.
+//
+//           A background thread watches the settings snapshot and the parametric bands.
+//           When they change, it samples the magnitude response of the chain, bands included,
+//           on the FFT grid, turns it into a
+//           symmetric kernel with an inverse FFT, windows it, and loads it into
+//           juce::dsp::Convolution, which partitions it, swaps it in without
+//           blocking the audio thread, and crossfades from the previous kernel.
+//
+//           A longer FIR resolves the low frequencies better, at the cost of latency.
+//           The convolution adds no latency with non-uniform partitions, or the
+//           size of its partitions with uniform ones, which are cheaper.
+//           juce::dsp::Convolution processes up to two channels,
+//           so there is one convolution per pair of channels.
+class LinearPhaseEngine : private juce::Thread
+{
+public:
+    using BandSettingsArray = std::array<BandSettings, numParametricBands>;
+
+    // [LUCAS] : The band parameters are read from their cached raw values, which must outlive the engine.
+    //           The stateSequence is odd while the processor restores a state, during which nothing is designed.
+    LinearPhaseEngine(const ChainSettingsSnapshot& chainSettingsSnapshot,
+                      const std::array<BandParameters, numParametricBands>& bandParameters,
+                      const std::atomic<juce::uint32>& stateSequence);
+    ~LinearPhaseEngine() override;
+
+    // [LUCAS] : Prepares the convolutions, designs the kernel of the current settings,
+    //           and starts watching the parameters.
+    //           A convolutionLatency of 0 selects zero-latency non-uniform partitions.
+    //           The filters neutral within neutralToleranceInDb are left out of the kernel,
+    //           as they are left out of the minimum phase chain.
+    //           Not to be called from the audio thread.
+    void prepare(const juce::dsp::ProcessSpec& spec, int firLength, int convolutionLatency, float neutralToleranceInDb);
+
+    // [LUCAS] : Stops the thread. Not to be called from the audio thread.
+    void stop();
+
+    void reset() noexcept;
+
+    // [LUCAS] : The delay of the kernel centre, plus the latency of the convolution
+    int getLatencySamples() const noexcept;
+
+    int getFirLength() const noexcept;
+
+    // [LUCAS] : Processes a block. It may have fewer channels than it was prepared for.
+    void process(juce::dsp::AudioBlock<float>& block) noexcept;
+
+    // [LUCAS] : Designs the linear phase kernel of the given settings, or of the given coefficients
+    static juce::AudioBuffer<float> designKernel(const ChainSettings& chainSettings, double sampleRate, int firLength);
+    static juce::AudioBuffer<float> designKernel(const CoefficientSet& set, double sampleRate, int firLength);
+
+    // [LUCAS] : Returns the coefficients of the newest kernel, or nullptr if it did not change
+    //           since the last call. For a single consumer thread.
+    const CoefficientSet* getNewCoefficients() noexcept;
+
+    // [LUCAS] : The FIR lengths that can be selected
+    static constexpr int minFirLength = 1024;
+    static constexpr int maxFirLength = 32768;
+
+private:
+    void run() override;
+
+    // [LUCAS] : Designs the kernel of the given settings and hands it over to every convolution
+    void loadKernel(const ChainSettings& chainSettings, const BandSettingsArray& bandSettings);
+
+    // [LUCAS] : Designs a new kernel if the settings changed, unless a restore started meanwhile
+    void designIfChanged(juce::uint32 sequence);
+
+    BandSettingsArray readBandSettings() const;
+
+    // [LUCAS] : How often the parameters are checked for changes
+    static constexpr int pollIntervalMs = 20;
+
+    // [LUCAS] : The size of the first partition of the non-uniform convolution
+    static constexpr int headSize = 256;
+
+    const ChainSettingsSnapshot& chainSettingsSnapshot;
+    const std::array<BandParameters, numParametricBands>& bandParameters;
+    const std::atomic<juce::uint32>& stateSequence;
+
+    juce::dsp::ConvolutionMessageQueue messageQueue;
+    std::vector<std::unique_ptr<juce::dsp::Convolution>> convolutions;
+
+    ChainSettings designedSettings;
+    BandSettingsArray designedBandSettings;
+    juce::uint32 designedVersion { 0 };
+    TripleBuffer<CoefficientSet> designedCoefficients;
+    double sampleRate { 0.0 };
+    int firLength { 4096 };
+    int latencySamples { 0 };
+    float neutralTolerance { 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LinearPhaseEngine)
+};
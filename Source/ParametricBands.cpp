@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    This file contains the parametric bands of the EQ : their settings,
+    their parameters, and how they are designed into the sections of
+    a fused biquad cascade.
+
+  ==============================================================================
+*/
+
+#include "ParametricBands.h"
+#include "CascadeDesign.h"
+
+juce::String getBandParameterId(int band, const char* name)
+{
+    return ("Band " + juce::String(band) + " " + name);
+}
+
+void addBandParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, int numBands)
+{
+    for (int band = 1; band <= numBands; ++band)
+    {
+        // [LUCAS] : The default frequencies are spread evenly over the octaves from 60 Hz to 12 kHz
+        const auto defaultFreq = 60.f * std::pow(200.f, numBands > 1 ? (float) (band - 1) / (float) (numBands - 1) : 0.5f);
+
+        layout.add(std::make_unique<juce::AudioParameterBool>(
+            juce::ParameterID(getBandParameterId(band, "Enabled"), 1),
+            getBandParameterId(band, "Enabled"),
+            false
+        ));
+
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(getBandParameterId(band, "Type"), 1),
+            getBandParameterId(band, "Type"),
+            juce::StringArray { "Peak", "Low Shelf", "High Shelf", "Notch" },
+            0
+        ));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(getBandParameterId(band, "Freq"), 1),
+            getBandParameterId(band, "Freq"),
+            juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+            std::round(defaultFreq)
+        ));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(getBandParameterId(band, "Gain"), 1),
+            getBandParameterId(band, "Gain"),
+            juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
+            0.0f
+        ));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(getBandParameterId(band, "Quality"), 1),
+            getBandParameterId(band, "Quality"),
+            juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f),
+            1.0f
+        ));
+    }
+}
+
+BandParameters getBandParameters(juce::AudioProcessorValueTreeState& parametersManager, int band)
+{
+    BandParameters parameters;
+
+    parameters.enabled  = parametersManager.getRawParameterValue(getBandParameterId(band, "Enabled"));
+    parameters.type     = parametersManager.getRawParameterValue(getBandParameterId(band, "Type"));
+    parameters.freq     = parametersManager.getRawParameterValue(getBandParameterId(band, "Freq"));
+    parameters.gainInDb = parametersManager.getRawParameterValue(getBandParameterId(band, "Gain"));
+    parameters.q        = parametersManager.getRawParameterValue(getBandParameterId(band, "Quality"));
+
+    return (parameters);
+}
+
+BandSettings getBandSettings(const BandParameters& bandParameters)
+{
+    BandSettings settings;
+
+    settings.enabled  = bandParameters.enabled->load() >= 0.5f;
+    settings.type     = static_cast<BandType>(static_cast<int>(bandParameters.type->load()));
+    settings.freq     = bandParameters.freq->load();
+    settings.gainInDb = bandParameters.gainInDb->load();
+    settings.q        = bandParameters.q->load();
+
+    return (settings);
+}
+
+bool bandSettingsChanged(const BandSettings& a, const BandSettings& b)
+{
+    return (a.enabled != b.enabled
+         || a.type != b.type
+         || a.freq != b.freq
+         || a.gainInDb != b.gainInDb
+         || a.q != b.q);
+}
+
+bool isBandNeutral(const BandSettings& settings, float toleranceInDb)
+{
+    if (! settings.enabled)
+        return (true);
+
+    // [LUCAS] : A notch always removes its frequency, whatever its gain
+    return (settings.type != BandType::Band_Notch
+            && toleranceInDb >= 0.f
+            && std::abs(settings.gainInDb) <= toleranceInDb);
+}
+
+BiquadCoefficients designBandCoefficients(const BandSettings& settings, double sampleRate) noexcept
+{
+    switch (settings.type)
+    {
+        case Band_LowShelf:
+            return (designLowShelfFilter(settings.freq, settings.q, settings.gainInDb, sampleRate));
+        case Band_HighShelf:
+            return (designHighShelfFilter(settings.freq, settings.q, settings.gainInDb, sampleRate));
+        case Band_Notch:
+            return (designNotchFilter(settings.freq, settings.q, sampleRate));
+        case Band_Peak:
+        default:
+            return (designPeakFilter(settings.freq, settings.q, settings.gainInDb, sampleRate));
+    }
+}
+
+StateVariableCoefficients designStateVariableBand(const BandSettings& settings, double sampleRate) noexcept
+{
+    switch (settings.type)
+    {
+        case Band_LowShelf:
+            return (designStateVariableLowShelf(settings.freq, settings.q, settings.gainInDb, sampleRate));
+        case Band_HighShelf:
+            return (designStateVariableHighShelf(settings.freq, settings.q, settings.gainInDb, sampleRate));
+        case Band_Notch:
+            return (designStateVariableNotch(settings.freq, settings.q, sampleRate));
+        case Band_Peak:
+        default:
+            return (designStateVariablePeak(settings.freq, settings.q, settings.gainInDb, sampleRate));
+    }
+}
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    This file contains the parametric bands of the EQ : their settings,
+    their parameters, and how they are designed into the sections of
+    a fused biquad cascade.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+
+// [LUCAS] : The number of parametric bands of the plugin, on top of the peak and cut filters.
+//           Each band is one section of the FilterChain, so raising it to 16 only costs
+//           the sections that are enabled.
+constexpr int numParametricBands = 8;
+
+// [LUCAS] : This enum defines and represents the shape of a parametric band
+enum BandType
+{
+    Band_Peak,
+    Band_LowShelf,
+    Band_HighShelf,
+    Band_Notch
+};
+
+// [LUCAS] : This structure holds the parameters of a parametric band
+struct BandSettings
+{
+    bool enabled { false };
+    BandType type { BandType::Band_Peak };
+    float freq { 1000.f }, gainInDb { 0.f }, q { 1.f };
+};
+
+// [LUCAS] : This structure holds pointers to the raw parameter values of a band
+struct BandParameters
+{
+    std::atomic<float>* enabled { nullptr };
+    std::atomic<float>* type { nullptr };
+    std::atomic<float>* freq { nullptr };
+    std::atomic<float>* gainInDb { nullptr };
+    std::atomic<float>* q { nullptr };
+};
+
+// [LUCAS] : This function returns the ID of a parameter of a band, e.g. "Band 3 Freq".
+//           Bands are numbered from 1, and name is one of Enabled, Type, Freq, Gain or Quality.
+juce::String getBandParameterId(int band, const char* name);
+
+// [LUCAS] : This function adds the parameters of numBands bands to the layout.
+//           Every band starts disabled, so a new band never changes the sound of a session.
+void addBandParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, int numBands);
+
+// [LUCAS] : This function looks up the raw parameter values of a band once
+BandParameters getBandParameters(juce::AudioProcessorValueTreeState& parametersManager, int band);
+
+// [LUCAS] : This function is a getter for the settings of a band, reading from cached parameter values
+BandSettings getBandSettings(const BandParameters& bandParameters);
+
+// [LUCAS] : This helper function tells if the settings of a band differ
+bool bandSettingsChanged(const BandSettings& a, const BandSettings& b);
+
+// [LUCAS] : This helper function tells if a band leaves the audio unchanged : it is disabled,
+//           or it is a peak or a shelf within toleranceInDb of 0 dB. A negative tolerance
+//           only leaves disabled bands out.
+bool isBandNeutral(const BandSettings& settings, float toleranceInDb);
+
+// [LUCAS] : These functions design a band, in either topology of the cascade
+BiquadCoefficients designBandCoefficients(const BandSettings& settings, double sampleRate) noexcept;
+StateVariableCoefficients designStateVariableBand(const BandSettings& settings, double sampleRate) noexcept;
+
+//==============================================================================
+// [LUCAS] : This class holds the designs of NumBands parametric bands, and copies them
+//           into NumBands consecutive sections of a BiquadCascade. The bands then run
+//           in the same fused loop as the other sections of the cascade : an enabled band
+//           costs one biquad per sample, and a neutral band is bypassed and costs nothing.
+//
+//           Only the bands whose settings changed are designed again. The designs are
+//           closed-form and allocation-free, so this can run on the audio thread.
+template<int NumBands>
+class ParametricBands
+{
+public:
+    static constexpr int numBands = NumBands;
+
+    using Settings = std::array<BandSettings, NumBands>;
+    using Mask = std::bitset<NumBands>;
+
+    // [LUCAS] : Designs the bands whose settings changed since the last call, or all of them
+    //           when forced (or when the sample rate or the topology changed).
+    //           Returns the mask of the bands that were designed.
+    Mask design(const Settings& newSettings, double sampleRate, FilterTopology topology, float toleranceInDb, bool force) noexcept
+    {
+        Mask designed;
+
+        if (sampleRate != designedSampleRate || topology != designedTopology || toleranceInDb != designedTolerance)
+            force = true;
+
+        for (size_t i = 0; i < (size_t) NumBands; ++i)
+        {
+            const auto& band = newSettings[i];
+
+            if (! force && ! bandSettingsChanged(band, settings[i]))
+                continue;
+
+            neutral[i] = isBandNeutral(band, toleranceInDb);
+
+            if (! neutral[i])
+            {
+                if (topology == FilterTopology::stateVariable)
+                    stateVariables[i] = designStateVariableBand(band, sampleRate);
+                else
+                    biquads[i] = designBandCoefficients(band, sampleRate);
+            }
+
+            settings[i] = band;
+            designed.set(i);
+        }
+
+        designedSampleRate = sampleRate;
+        designedTopology = topology;
+        designedTolerance = toleranceInDb;
+
+        return (designed);
+    }
+
+    // [LUCAS] : Copies the given bands into the sections firstSection + band of the cascade.
+    //           Neutral bands are bypassed.
+    template<typename CascadeType>
+    void apply(CascadeType& cascade, int firstSection, Mask bands = Mask().set()) const noexcept
+    {
+        jassert(firstSection + NumBands <= CascadeType::maxSections);
+
+        for (size_t i = 0; i < (size_t) NumBands; ++i)
+        {
+            if (! bands.test(i))
+                continue;
+
+            const auto section = firstSection + (int) i;
+
+            if (! neutral[i])
+            {
+                if (designedTopology == FilterTopology::stateVariable)
+                    cascade.setCoefficients(section, stateVariables[i]);
+                else
+                    cascade.setCoefficients(section, biquads[i]);
+            }
+
+            cascade.setBypassed(section, neutral[i]);
+        }
+    }
+
+    const Settings& getSettings() const noexcept
+    {
+        return (settings);
+    }
+
+    FilterTopology getTopology() const noexcept
+    {
+        return (designedTopology);
+    }
+
+    // [LUCAS] : Writes the biquad of every band that is not neutral, whatever the topology it runs in,
+    //           as the state variable sections have the response of the biquads of the same settings
+    void getBiquads(std::array<BiquadCoefficients, NumBands>& sections, Mask& activeBands) const noexcept
+    {
+        activeBands.reset();
+
+        for (size_t i = 0; i < (size_t) NumBands; ++i)
+        {
+            if (neutral[i])
+                continue;
+
+            sections[i] = (designedTopology == FilterTopology::stateVariable ? designBandCoefficients(settings[i], designedSampleRate)
+                                                                             : biquads[i]);
+            activeBands.set(i);
+        }
+    }
+
+    // [LUCAS] : Returns how many bands are not neutral
+    int getNumActiveBands() const noexcept
+    {
+        return ((int) std::count(neutral.begin(), neutral.end(), false));
+    }
+
+private:
+    Settings settings;
+    std::array<BiquadCoefficients, NumBands> biquads;
+    std::array<StateVariableCoefficients, NumBands> stateVariables;
+    std::array<bool, NumBands> neutral { initialNeutral() };
+
+    double designedSampleRate { 0.0 };
+    FilterTopology designedTopology { FilterTopology::transposedDirectForm2 };
+    float designedTolerance { 0.f };
+
+    static std::array<bool, NumBands> initialNeutral() noexcept
+    {
+        std::array<bool, NumBands> flags;
+        flags.fill(true);
+        return (flags);
+    }
+};
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    This file contains the editor panel showing the timings of processBlock.
+
+  ==============================================================================
+*/
+
+#include "PerformanceComponent.h"
+
+PerformanceComponent::PerformanceComponent(PerformanceMonitor& monitor)
+    : performanceMonitor(monitor)
+{
+    exportButton.onClick = [this] { exportTrace(); };
+    addAndMakeVisible(exportButton);
+
+    // [LUCAS] : The blocks are only traced while the panel is open, and its timer drains them
+    performanceMonitor.setTracing(true);
+    startTimerHz(4);
+}
+
+PerformanceComponent::~PerformanceComponent()
+{
+    stopTimer();
+    performanceMonitor.setTracing(false);
+}
+
+void PerformanceComponent::paint(juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId).darker(0.2f));
+
+    auto textArea = getLocalBounds().reduced(8, 4).withTrimmedRight(exportButton.getWidth() + 8);
+
+    juce::String firstLine;
+    firstLine << "CPU " << juce::String(snapshot.cpuLoadPercent, 1) << " %"
+              << "    p99 block " << juce::String(snapshot.p99BlockMicroseconds, 1) << " us"
+              << "    max " << juce::String(snapshot.maxBlockMicroseconds, 1) << " us";
+
+    juce::String secondLine;
+    secondLine << "xrun risks " << juce::String((juce::int64) totalXrunRisks)
+               << "    redesigns " << juce::String((juce::int64) totalRedesigns);
+
+    g.setColour(snapshot.numXrunRisks > 0 ? juce::Colours::orange : juce::Colours::white);
+    g.setFont(13.0f);
+    g.drawFittedText(firstLine + "\n" + secondLine, textArea, juce::Justification::centredLeft, 2);
+}
+
+void PerformanceComponent::resized()
+{
+    exportButton.setBounds(getLocalBounds().removeFromRight(120).reduced(8));
+}
+
+void PerformanceComponent::timerCallback()
+{
+    snapshot = performanceMonitor.getSnapshot();
+
+    totalXrunRisks += snapshot.numXrunRisks;
+    totalRedesigns += snapshot.numRedesigns;
+
+    repaint();
+}
+
+void PerformanceComponent::exportTrace()
+{
+    fileChooser = std::make_unique<juce::FileChooser>(
+        "Export a Chrome trace",
+        juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("SimpleEQ-trace.json"),
+        "*.json");
+
+    fileChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles,
+                             [this](const juce::FileChooser& chooser)
+                             {
+                                 const auto file = chooser.getResult();
+
+                                 if (file != juce::File())
+                                     performanceMonitor.exportChromeTrace(file);
+                             });
+}
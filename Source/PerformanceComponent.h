@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    This file contains the editor panel showing the timings of processBlock.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PerformanceMonitor.h"
+
+//==============================================================================
+// [LUCAS] : This component shows the CPU load, the p99 block time, the xrun risks
+//           and the coefficient redesigns measured by a PerformanceMonitor,
+//           and exports the recent blocks as a Chrome trace.
+//           The trace of the monitor is armed while the component exists.
+class PerformanceComponent : public juce::Component,
+                             private juce::Timer
+{
+public:
+    PerformanceComponent(PerformanceMonitor& monitor);
+    ~PerformanceComponent() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void timerCallback() override;
+
+    void exportTrace();
+
+    PerformanceMonitor& performanceMonitor;
+
+    PerformanceMonitor::Snapshot snapshot;
+    juce::uint64 totalXrunRisks { 0 };
+    juce::uint64 totalRedesigns { 0 };
+
+    juce::TextButton exportButton { "Export trace..." };
+    std::unique_ptr<juce::FileChooser> fileChooser;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PerformanceComponent)
+};
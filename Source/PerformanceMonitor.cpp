@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    This file contains the instrumentation of the audio thread : block timings
+    collected without locks, and aggregated on the message thread.
+
+  ==============================================================================
+*/
+
+#include "PerformanceMonitor.h"
+
+PerformanceMonitor::PerformanceMonitor()
+    : ticksPerSecond((double) juce::Time::getHighResolutionTicksPerSecond())
+{
+    for (auto& bucket : histogram)
+        bucket.store(0);
+
+    originTicks = juce::Time::getHighResolutionTicks();
+}
+
+void PerformanceMonitor::prepare(double newSampleRate)
+{
+    sampleRate.store(newSampleRate);
+}
+
+void PerformanceMonitor::setEnabled(bool shouldBeEnabled) noexcept
+{
+    enabled.store(shouldBeEnabled);
+}
+
+bool PerformanceMonitor::isEnabled() const noexcept
+{
+    return (enabled.load());
+}
+
+void PerformanceMonitor::setTracing(bool shouldTrace)
+{
+    if (shouldTrace == tracing.load())
+        return;
+
+    if (shouldTrace)
+    {
+        if (eventBuffer == nullptr)
+        {
+            eventBuffer.allocate((size_t) eventFifoSize, true);
+            traceWindow.allocate((size_t) traceWindowSize, true);
+        }
+
+        // [LUCAS] : Leftovers of a previous trace are dropped, and the new one starts empty
+        drainEvents();
+        nextTraceEvent = numTraceEvents = 0;
+    }
+
+    // [LUCAS] : Releases the buffers to the audio thread, which checks the flag before writing
+    tracing.store(shouldTrace, std::memory_order_release);
+}
+
+bool PerformanceMonitor::isTracing() const noexcept
+{
+    return (tracing.load());
+}
+
+//==============================================================================
+void PerformanceMonitor::beginBlock() noexcept
+{
+    currentEvent = {};
+
+    if (enabled.load(std::memory_order_relaxed))
+        currentEvent.startTicks = juce::Time::getHighResolutionTicks();
+}
+
+void PerformanceMonitor::beginCoefficientUpdate() noexcept
+{
+    if (currentEvent.startTicks != 0)
+        currentEvent.updateStartTicks = juce::Time::getHighResolutionTicks();
+}
+
+void PerformanceMonitor::endCoefficientUpdate(bool redesigned) noexcept
+{
+    if (currentEvent.startTicks != 0)
+    {
+        currentEvent.updateEndTicks = juce::Time::getHighResolutionTicks();
+        currentEvent.redesigned = redesigned;
+    }
+}
+
+void PerformanceMonitor::endBlock(int numSamples) noexcept
+{
+    // [LUCAS] : The monitor was disabled when the block started
+    if (currentEvent.startTicks == 0)
+        return;
+
+    currentEvent.endTicks = juce::Time::getHighResolutionTicks();
+    currentEvent.numSamples = numSamples;
+
+    const auto blockTicks = currentEvent.endTicks - currentEvent.startTicks;
+    const auto blockMicroseconds = (double) blockTicks * 1.0e6 / ticksPerSecond;
+    const auto budgetMicroseconds = (double) numSamples * 1.0e6 / sampleRate.load(std::memory_order_relaxed);
+
+    histogram[(size_t) getHistogramBucket(blockMicroseconds)].fetch_add(1, std::memory_order_relaxed);
+
+    totalBlocks.fetch_add(1, std::memory_order_relaxed);
+    totalSamples.fetch_add((juce::uint64) numSamples, std::memory_order_relaxed);
+    totalBusyTicks.fetch_add((juce::uint64) blockTicks, std::memory_order_relaxed);
+
+    if (blockMicroseconds > budgetMicroseconds * xrunRiskThreshold)
+        totalXrunRisks.fetch_add(1, std::memory_order_relaxed);
+
+    if (currentEvent.redesigned)
+        totalRedesigns.fetch_add(1, std::memory_order_relaxed);
+
+    if (blockTicks > maxBlockTicks.load(std::memory_order_relaxed))
+        maxBlockTicks.store(blockTicks, std::memory_order_relaxed);
+
+    if (! tracing.load(std::memory_order_acquire))
+        return;
+
+    // [LUCAS] : Drops the event rather than waiting, if nobody drained the FIFO in time
+    const auto scope = eventFifo.write(1);
+
+    if (scope.blockSize1 > 0)
+        eventBuffer[scope.startIndex1] = currentEvent;
+    else
+        totalDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+PerformanceMonitor::Snapshot PerformanceMonitor::getSnapshot()
+{
+    drainEvents();
+
+    Snapshot snapshot;
+
+    const auto blocks = totalBlocks.load();
+    const auto samples = totalSamples.load();
+    const auto busyTicks = totalBusyTicks.load();
+    const auto xrunRisks = totalXrunRisks.load();
+    const auto redesigns = totalRedesigns.load();
+    const auto droppedEvents = totalDroppedEvents.load();
+
+    snapshot.numBlocks = blocks - previousBlocks;
+    snapshot.numXrunRisks = xrunRisks - previousXrunRisks;
+    snapshot.numRedesigns = redesigns - previousRedesigns;
+    snapshot.numDroppedEvents = droppedEvents - previousDroppedEvents;
+
+    // [LUCAS] : CPU load is the time spent in processBlock, over the duration of the audio it produced
+    const auto audioSeconds = (double) (samples - previousSamples) / sampleRate.load();
+
+    if (audioSeconds > 0.0)
+        snapshot.cpuLoadPercent = 100.0 * ((double) (busyTicks - previousBusyTicks) / ticksPerSecond) / audioSeconds;
+
+    snapshot.maxBlockMicroseconds = (double) maxBlockTicks.exchange(0) * 1.0e6 / ticksPerSecond;
+
+    // [LUCAS] : The p99 block time is read from the histogram counts of this interval
+    std::array<juce::uint32, numHistogramBuckets> counts;
+    juce::uint64 numCounted = 0;
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        const auto count = histogram[i].load(std::memory_order_relaxed);
+        counts[i] = count - previousHistogram[i];
+        previousHistogram[i] = count;
+        numCounted += counts[i];
+    }
+
+    if (numCounted > 0)
+    {
+        const auto target = (juce::uint64) std::ceil(0.99 * (double) numCounted);
+        juce::uint64 cumulated = 0;
+
+        for (int i = 0; i < numHistogramBuckets; ++i)
+        {
+            cumulated += counts[(size_t) i];
+
+            if (cumulated >= target)
+            {
+                snapshot.p99BlockMicroseconds = getBucketMicroseconds(i + 1);
+                break;
+            }
+        }
+    }
+
+    previousBlocks = blocks;
+    previousSamples = samples;
+    previousBusyTicks = busyTicks;
+    previousXrunRisks = xrunRisks;
+    previousRedesigns = redesigns;
+    previousDroppedEvents = droppedEvents;
+
+    return (snapshot);
+}
+
+void PerformanceMonitor::exportChromeTrace(const juce::File& file)
+{
+    drainEvents();
+
+    // [LUCAS] : The trace window, oldest event first
+    std::vector<BlockEvent> events;
+    events.reserve((size_t) numTraceEvents);
+
+    for (int i = 0; i < numTraceEvents; ++i)
+        events.push_back(traceWindow[(nextTraceEvent - numTraceEvents + i + traceWindowSize) % traceWindowSize]);
+
+    const auto origin = originTicks;
+    const auto ticksPerMicrosecond = ticksPerSecond / 1.0e6;
+
+    // [LUCAS] : Formatting and writing a large trace can take a while,
+    //           so it is done on its own thread, with a copy of the events
+    juce::Thread::launch([file, events = std::move(events), origin, ticksPerMicrosecond]
+    {
+        file.replaceWithText(toChromeTrace(events, origin, ticksPerMicrosecond));
+    });
+}
+
+//==============================================================================
+void PerformanceMonitor::drainEvents()
+{
+    // [LUCAS] : Nothing was ever traced
+    if (eventBuffer == nullptr)
+        return;
+
+    const auto scope = eventFifo.read(eventFifo.getNumReady());
+
+    const auto keep = [this](const BlockEvent& event)
+    {
+        traceWindow[nextTraceEvent] = event;
+        nextTraceEvent = (nextTraceEvent + 1) % traceWindowSize;
+        numTraceEvents = juce::jmin(numTraceEvents + 1, traceWindowSize);
+    };
+
+    for (int i = 0; i < scope.blockSize1; ++i)
+        keep(eventBuffer[scope.startIndex1 + i]);
+
+    for (int i = 0; i < scope.blockSize2; ++i)
+        keep(eventBuffer[scope.startIndex2 + i]);
+}
+
+int PerformanceMonitor::getHistogramBucket(double microseconds) noexcept
+{
+    return (juce::jlimit(0, numHistogramBuckets - 1, (int) (std::log2(1.0 + microseconds) * 4.0)));
+}
+
+double PerformanceMonitor::getBucketMicroseconds(int bucket) noexcept
+{
+    // [LUCAS] : The upper bound of the bucket, so the percentile is never under-reported
+    return (std::exp2((double) bucket / 4.0) - 1.0);
+}
+
+juce::String PerformanceMonitor::toChromeTrace(const std::vector<BlockEvent>& events, juce::int64 origin, double ticksPerMicrosecond)
+{
+    juce::MemoryOutputStream stream;
+
+    auto writeEvent = [&stream, origin, ticksPerMicrosecond](const char* name, juce::int64 startTicks, juce::int64 endTicks, const juce::String& arguments)
+    {
+        stream << "{\"name\":\"" << name << "\",\"cat\":\"audio\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+               << ",\"ts\":" << juce::String((double) (startTicks - origin) / ticksPerMicrosecond, 3)
+               << ",\"dur\":" << juce::String((double) (endTicks - startTicks) / ticksPerMicrosecond, 3)
+               << ",\"args\":{" << arguments << "}}";
+    };
+
+    stream << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    for (const auto& event : events)
+    {
+        if (! first)
+            stream << ",";
+
+        first = false;
+
+        writeEvent("processBlock", event.startTicks, event.endTicks, "\"numSamples\":" + juce::String(event.numSamples));
+
+        if (event.updateStartTicks != 0 && event.updateEndTicks != 0)
+        {
+            stream << ",";
+            writeEvent("coefficientUpdate", event.updateStartTicks, event.updateEndTicks,
+                       juce::String("\"redesigned\":") + (event.redesigned ? "true" : "false"));
+        }
+    }
+
+    stream << "],\"displayTimeUnit\":\"ms\"}";
+
+    return (stream.toString());
+}
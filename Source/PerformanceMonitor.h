@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    This file contains the instrumentation of the audio thread : block timings
+    collected without locks, and aggregated on the message thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// [LUCAS] : This class times every call to processBlock, and the coefficient
+//           update phase inside it.
+//           The audio thread only reads the high resolution clock and bumps a few
+//           relaxed atomics. While a trace is armed, it also pushes a small event
+//           into a wait-free FIFO.
+//           The message thread turns this into CPU load, block time percentiles,
+//           xrun risk and redesign counts, and keeps the events of the trace window
+//           so they can be exported as a Chrome trace (chrome://tracing, Perfetto).
+//           The monitor has no timer of its own : whoever arms the trace, the editor,
+//           drains the FIFO by calling getSnapshot() regularly.
+class PerformanceMonitor
+{
+public:
+    // [LUCAS] : This structure holds the aggregated measurements,
+    //           since the previous call to getSnapshot()
+    struct Snapshot
+    {
+        double cpuLoadPercent { 0.0 };
+        double p99BlockMicroseconds { 0.0 };
+        double maxBlockMicroseconds { 0.0 };
+        juce::uint64 numBlocks { 0 };
+        juce::uint64 numXrunRisks { 0 };
+        juce::uint64 numRedesigns { 0 };
+        juce::uint64 numDroppedEvents { 0 };
+    };
+
+    PerformanceMonitor();
+
+    // [LUCAS] : A block taking more than this fraction of its duration is an xrun risk
+    static constexpr double xrunRiskThreshold = 0.75;
+
+    // [LUCAS] : Not to be called from the audio thread
+    void prepare(double sampleRate);
+
+    void setEnabled(bool shouldBeEnabled) noexcept;
+    bool isEnabled() const noexcept;
+
+    // [LUCAS] : Message thread : arms or disarms the trace. Arming it the first time allocates
+    //           the event FIFO and the trace window, and clears the events of a previous trace.
+    //           The caller has to call getSnapshot() at least every quarter of a second or so,
+    //           or the events of small blocks are dropped.
+    void setTracing(bool shouldTrace);
+    bool isTracing() const noexcept;
+
+    //==============================================================================
+    // [LUCAS] : Audio thread : these calls bracket processBlock and its coefficient update
+    void beginBlock() noexcept;
+    void beginCoefficientUpdate() noexcept;
+    void endCoefficientUpdate(bool redesigned) noexcept;
+    void endBlock(int numSamples) noexcept;
+
+    //==============================================================================
+    // [LUCAS] : Message thread : aggregates everything measured since the previous call
+    Snapshot getSnapshot();
+
+    // [LUCAS] : Message thread : writes the blocks of the trace window to a Chrome trace JSON file,
+    //           from a background thread
+    void exportChromeTrace(const juce::File& file);
+
+private:
+    // [LUCAS] : One processBlock call, as pushed by the audio thread
+    struct BlockEvent
+    {
+        juce::int64 startTicks { 0 }, endTicks { 0 };
+        juce::int64 updateStartTicks { 0 }, updateEndTicks { 0 };
+        int numSamples { 0 };
+        bool redesigned { false };
+    };
+
+    // [LUCAS] : Drains the event FIFO into the trace window
+    void drainEvents();
+
+    static int getHistogramBucket(double microseconds) noexcept;
+    static double getBucketMicroseconds(int bucket) noexcept;
+
+    static juce::String toChromeTrace(const std::vector<BlockEvent>& events, juce::int64 originTicks, double ticksPerMicrosecond);
+
+    // [LUCAS] : Quarter octave buckets of the block time in microseconds,
+    //           from 1 us to a bit over 1 s
+    static constexpr int numHistogramBuckets = 80;
+
+    // [LUCAS] : The FIFO holds half a second of 16 sample blocks at 48 kHz, and the trace window
+    //           the last 4096 blocks : 2.7 s of 32 sample blocks, or 44 s of 512 sample blocks at 48 kHz.
+    //           Both take about 220 KB together, and only once a trace was armed.
+    static constexpr int eventFifoSize = 1536;
+    static constexpr int traceWindowSize = 4096;
+
+    std::atomic<bool> enabled { true };
+    std::atomic<bool> tracing { false };
+
+    std::atomic<double> sampleRate { 44100.0 };
+    double ticksPerSecond;
+    juce::int64 originTicks { 0 };
+
+    // [LUCAS] : Written by the audio thread
+    std::array<std::atomic<juce::uint32>, numHistogramBuckets> histogram;
+    std::atomic<juce::uint64> totalBlocks { 0 }, totalSamples { 0 }, totalBusyTicks { 0 };
+    std::atomic<juce::uint64> totalXrunRisks { 0 }, totalRedesigns { 0 }, totalDroppedEvents { 0 };
+    std::atomic<juce::int64> maxBlockTicks { 0 };
+
+    // [LUCAS] : Allocated by the first setTracing(true), and kept until the monitor is deleted,
+    //           so the audio thread never writes into freed memory
+    juce::AbstractFifo eventFifo { eventFifoSize };
+    juce::HeapBlock<BlockEvent> eventBuffer;
+
+    // [LUCAS] : Only touched by the audio thread
+    BlockEvent currentEvent;
+
+    // [LUCAS] : Only touched by the message thread
+    std::array<juce::uint32, numHistogramBuckets> previousHistogram {};
+    juce::uint64 previousBlocks { 0 }, previousSamples { 0 }, previousBusyTicks { 0 };
+    juce::uint64 previousXrunRisks { 0 }, previousRedesigns { 0 }, previousDroppedEvents { 0 };
+
+    // [LUCAS] : The trace window, as a ring of traceWindowSize events
+    juce::HeapBlock<BlockEvent> traceWindow;
+    int nextTraceEvent { 0 }, numTraceEvents { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PerformanceMonitor)
+};
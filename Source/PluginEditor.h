@@ -1,33 +1,46 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-
-//==============================================================================
-/**
-*/
-class SimpleEQAudioProcessorEditor  : public juce::AudioProcessorEditor
-{
-public:
-    SimpleEQAudioProcessorEditor (SimpleEQAudioProcessor&);
-    ~SimpleEQAudioProcessorEditor() override;
-
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-private:
-    // This reference is provided as a quick way for your editor to
-    // access the processor object that created it.
-    SimpleEQAudioProcessor& audioProcessor;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessorEditor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "PerformanceComponent.h"
+#include "SpectrumComponent.h"
+
+//==============================================================================
+/**
+*/
+class SimpleEQAudioProcessorEditor  : public juce::AudioProcessorEditor
+{
+public:
+    SimpleEQAudioProcessorEditor (SimpleEQAudioProcessor&);
+    ~SimpleEQAudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    // This reference is provided as a quick way for your editor to
+    // access the processor object that created it.
+    SimpleEQAudioProcessor& audioProcessor;
+
+    // [LUCAS] : The spectrum of the input and output of the EQ, above the parameters
+    SpectrumComponent spectrumComponent;
+    static constexpr int spectrumHeight = 200;
+
+    // [LUCAS] : The generic editor for the parameters of the EQ
+    juce::GenericAudioProcessorEditor parametersEditor;
+
+    // [LUCAS] : The panel showing the timings of processBlock, below the parameters
+    PerformanceComponent performanceComponent;
+    static constexpr int performancePanelHeight = 56;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessorEditor)
+};
@@ -1,375 +1,1335 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-SimpleEQAudioProcessor::SimpleEQAudioProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       )
-#endif
-{
-}
-
-SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
-{
-}
-
-//==============================================================================
-const juce::String SimpleEQAudioProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool SimpleEQAudioProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SimpleEQAudioProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SimpleEQAudioProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double SimpleEQAudioProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int SimpleEQAudioProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int SimpleEQAudioProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void SimpleEQAudioProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String SimpleEQAudioProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void SimpleEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
-
-    // [LUCAS] : Setting the sample rate and the number of samples per block
-    juce::dsp::ProcessSpec spec;
-
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.sampleRate = sampleRate;
-    spec.numChannels = 1;
-
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
-
-    updateFilters();
-}
-
-void SimpleEQAudioProcessor::releaseResources()
-{
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    // In case we have more outputs than inputs, this code clears any output
-    // channels that didn't contain input data, (because these aren't
-    // guaranteed to be empty - they may contain garbage).
-    // This is here to avoid people getting screaming feedback
-    // when they first compile a plugin, but obviously you don't need to keep
-    // this code if your algorithm always overwrites all the output channels.
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-
-    updateFilters();
-
-    // [LUCAS] : Create an AudioBlock<float> wrapper for the input buffer
-    juce::dsp::AudioBlock<float> block(buffer);
-
-    // [LUCAS] : Provide separate blocks for left and right channels
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
-
-    // [LUCAS] : Provide processing context for each channel
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
-
-    // [LUCAS] : Process the left and right channels with their respective chains
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
-
-}
-
-//==============================================================================
-bool SimpleEQAudioProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* SimpleEQAudioProcessor::createEditor()
-{
-    // [LUCAS] : Un-comment this line to use the SimpleEQAudioProcessorEditor
-    // return new SimpleEQAudioProcessorEditor (*this);
-
-    // [LUCAS] : Un-comment this line to use the GenericAudioProcessorEditor
-    return new juce::GenericAudioProcessorEditor(*this);
-}
-
-//==============================================================================
-void SimpleEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-}
-
-void SimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-}
-
-// [LUCAS] : This function is a getter for the parameters settings of the EQ.
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& parametersManager)
-{
-    ChainSettings settings;
-
-    settings.lowCutFreq     = parametersManager.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq    = parametersManager.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq       = parametersManager.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDb   = parametersManager.getRawParameterValue("Peak Gain")->load();
-    settings.peakQ          = parametersManager.getRawParameterValue("Peak Quality")->load();
-    settings.lowCutSlope    = static_cast<Slope>(static_cast<int>(parametersManager.getRawParameterValue("LowCut Slope")->load()));
-    settings.highCutSlope   = static_cast<Slope>(static_cast<int>(parametersManager.getRawParameterValue("HighCut Slope")->load()));
-
-    return (settings);
-}
-
-// [LUCAS] : This function updates the peak filter coefficients for the
-//           left and right MonoChains based on the current chainSettings
-void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings)
-{
-    // [LUCAS] : Create the peak filter coefficients based on the current chainSettings
-    auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        getSampleRate(),
-        chainSettings.peakFreq,
-        chainSettings.peakQ,
-        juce::Decibels::decibelsToGain(chainSettings.peakGainInDb)
-    );
-
-    // [LUCAS] : Update the peak filter coefficients for the left and right channels
-    updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-}
-
-// [LUCAS] : This helper function updates the old Coefficients
-//           with the new updated coefficients
-void SimpleEQAudioProcessor::updateCoefficients(Coefficients& old, const Coefficients& updated)
-{
-    // [LUCAS] : Assigns the values of the updated coefficients to the old coefficients.
-    *old = *updated;
-}
-
-// [LUCAS] : This function updates the low cut filters of the left and right chains 
-//           based on the current chainSettings
-void SimpleEQAudioProcessor::updateLowCutFilter(const ChainSettings &chainSettings)
-{
-    // [LUCAS] : Calculates the high-pass filter coefficients using the Butterworth method 
-    auto cutCoefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(
-        chainSettings.lowCutFreq,
-        getSampleRate(),
-        2 * (chainSettings.lowCutSlope + 1)
-    );
-
-    // [LUCAS] : Updates the coefficients and slope of the low cut filters
-    //           in both the left and right chains
-    auto& leftLowCut = leftChain.get<ChainPositions::LowCut>();
-    auto& rightLowCut = rightChain.get<ChainPositions::LowCut>();
-
-    updateCutFilter(leftLowCut, cutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(rightLowCut, cutCoefficients, chainSettings.lowCutSlope);
-}
-
-// [LUCAS] : This function updates the high cut filters of the left and right chains 
-//           based on the current chainSettings
-void SimpleEQAudioProcessor::updateHighCutFilter(const ChainSettings &chainSettings)
-{
-    // [LUCAS] : Calculates the low-pass filter coefficients using the Butterworth method 
-    auto cutCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
-        chainSettings.highCutFreq,
-        getSampleRate(),
-        2 * (chainSettings.highCutSlope + 1)
-    );
-
-    // [LUCAS] : Updates the coefficients and slope of the low cut filters
-    //           in both the left and right chains
-    auto& leftHighCut = leftChain.get<ChainPositions::HighCut>();
-    auto& rightHighCut = rightChain.get<ChainPositions::HighCut>();
-
-    updateCutFilter(leftHighCut, cutCoefficients, chainSettings.highCutSlope);
-    updateCutFilter(rightHighCut, cutCoefficients, chainSettings.highCutSlope);
-}
-
-// [LUCAS] : This function updates all the filters in the audio processing chains :
-//           low cut filter, peak filter, and high cut filter
-//           based on the current parameters
-void SimpleEQAudioProcessor::updateFilters()
-{
-    // Retrieves the chain settings from the parameters manager
-    auto chainSettings = getChainSettings(parametersManager);
-
-    // Calls the appropriate update functions to update the filter coefficients and settings
-    // in both left and right audio processing chains
-    updatePeakFilter(chainSettings);   
-    updateLowCutFilter(chainSettings);
-    updateHighCutFilter(chainSettings);
-}
-
-//[LUCAS] : This method creates the parameters for my EQ
-juce::AudioProcessorValueTreeState::ParameterLayout
-    SimpleEQAudioProcessor::createParameterLayout()
-{
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID("LowCut Freq", 1),
-        "LowCut Freq",
-        juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-        20.f
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID("HighCut Freq", 1),
-        "HighCut Freq",
-        juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-        20000.f
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID("Peak Freq", 1),
-        "Peak Freq",
-        juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-        750.f
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID("Peak Gain", 1),
-        "Peak Gain",
-        juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-        0.0f
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID("Peak Quality", 1),
-        "Peak Quality",
-        juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f),
-        1.0f
-    ));
-    
-    juce::StringArray parametersArray;
-    for(int i = 0; i < 4; ++i)
-    {
-        juce::String parameterString;
-        parameterString << (12 + i * 12);
-        parameterString << " db/Oct";
-        parametersArray.add(parameterString);
-    }
-
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID("LowCut Slope", 1),
-        "LowCut Slope",
-        parametersArray,
-        0
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID("HighCut Slope", 1),
-        "HighCut Slope",
-        parametersArray,
-        0
-    ));
-
-    return (layout);
-}
-
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new SimpleEQAudioProcessor();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+#include "PluginState.h"
+#include "RealtimeSafety.h"
+
+//==============================================================================
+SimpleEQAudioProcessor::SimpleEQAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+                       )
+#endif
+{
+    // [LUCAS] : Looks up the raw parameter values once, instead of on every block
+    dynamicParameters = getDynamicParameters(parametersManager);
+
+    for (int band = 0; band < numParametricBands; ++band)
+        bandParameters[(size_t) band] = getBandParameters(parametersManager, band + 1);
+}
+
+SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
+{
+}
+
+//==============================================================================
+const juce::String SimpleEQAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool SimpleEQAudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleEQAudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleEQAudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double SimpleEQAudioProcessor::getTailLengthSeconds() const
+{
+    if (getSampleRate() <= 0.0)
+        return 0.0;
+
+    // [LUCAS] : The linear phase FIR rings for its whole length
+    if (activePhaseMode == PhaseMode::linearPhase)
+        return ((double) linearPhaseEngine.getFirLength() / getSampleRate());
+
+    // [LUCAS] : The filter chain rings until its slowest poles have decayed
+    return ((double) tailLengthInSamples.load() / getSampleRate());
+}
+
+int SimpleEQAudioProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int SimpleEQAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void SimpleEQAudioProcessor::setCurrentProgram (int index)
+{
+}
+
+const juce::String SimpleEQAudioProcessor::getProgramName (int index)
+{
+    return {};
+}
+
+void SimpleEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    // Use this method as the place to do any pre-playback
+    // initialisation that you need..
+
+    // [LUCAS] : Setting the sample rate and the number of samples per block
+    juce::dsp::ProcessSpec spec;
+
+    spec.maximumBlockSize = samplesPerBlock;
+    spec.sampleRate = sampleRate;
+    spec.numChannels = (juce::uint32) getTotalNumOutputChannels();
+
+    coefficientDesigner.stop();
+
+    activeCoefficientUpdateMode = coefficientUpdateMode;
+    activeControlInterval = smoothingControlInterval;
+
+    // [LUCAS] : The state variable topology is only used with smoothing,
+    //           the other modes design transposed direct form II biquads
+    const auto topology = (activeCoefficientUpdateMode == CoefficientUpdateMode::smoothed
+                           ? smoothingTopology
+                           : FilterTopology::transposedDirectForm2);
+
+    forEachFilterChain([this, topology](auto& chain)
+    {
+        chain.setTopology(topology);
+        chain.setIdenticalChannelDetection(dualMonoDetectionEnabled);
+    });
+
+    // [LUCAS] : Only the IIR modes have a peak filter to oversample. The buffers of the
+    //           oversampler are allocated here, and the peak is designed at its rate.
+    activePeakOversamplingFactor = (phaseMode == PhaseMode::minimumPhase ? peakOversamplingFactor : 1);
+    designedCoefficients.peakOversamplingFactor = activePeakOversamplingFactor;
+
+    auto oversampledSpec = spec;
+    oversampledSpec.sampleRate *= activePeakOversamplingFactor;
+    oversampledSpec.maximumBlockSize *= (juce::uint32) activePeakOversamplingFactor;
+
+    forEachOversampledPeak([this, &spec, topology](auto& peak)
+    {
+        peak.oversampler.prepare((int) spec.numChannels, (int) spec.maximumBlockSize,
+                                 activePeakOversamplingFactor, peakOversamplingPhase);
+
+        peak.filter.setTopology(topology);
+        peak.filter.setIdenticalChannelDetection(dualMonoDetectionEnabled);
+        peak.filter.setBypassed(0, true);
+    });
+
+    prepareDspState(spec, oversampledSpec);
+
+    performanceMonitor.prepare(sampleRate);
+    spectrumAnalyzer.prepare(sampleRate);
+    dynamicPeak.prepare(sampleRate);
+    dynamicPeakActive = false;
+
+    if (cutCoefficientCachePrewarmed)
+        prewarmCutCoefficientCache(*cutCoefficientCache, chainSettingsSnapshot.read(), sampleRate);
+
+    // [LUCAS] : Designs every filter right away, so the first block is processed
+    //           with the right coefficients whatever the update mode is
+    if (activeCoefficientUpdateMode == CoefficientUpdateMode::smoothed)
+    {
+        chainSmoother.prepare(sampleRate, smoothingRampLength);
+        chainSmoother.setCurrentAndTarget(chainSettingsSnapshot.read());
+        chainSmoother.setCurrentAndTargetBands(getBandSettings());
+        applySmoothedSettings(chainSmoother.getCurrent(), true);
+    }
+    else
+    {
+        designedSampleRate = 0.0;
+        updateFilters(chainSettingsSnapshot.read());
+    }
+
+    updateBands(getBandSettings(), true, neutralStageTolerance);
+
+    if (activeCoefficientUpdateMode == CoefficientUpdateMode::backgroundThread)
+        coefficientDesigner.start(sampleRate, neutralStageTolerance, activePeakOversamplingFactor);
+
+    updateTailLength();
+    publishResponseCoefficients();
+    numSilentSamples = 0;
+
+    // [LUCAS] : The linear phase FIR delays the signal by half its length
+    activePhaseMode = phaseMode;
+
+    if (activePhaseMode == PhaseMode::linearPhase)
+    {
+        linearPhaseEngine.prepare(spec, linearPhaseFirLength, linearPhaseConvolutionLatency, neutralStageTolerance);
+        setLatencySamples(linearPhaseEngine.getLatencySamples());
+
+        if (isUsingDoublePrecision())
+            linearPhaseBuffer.setSize((int) spec.numChannels, samplesPerBlock);
+    }
+    else
+    {
+        linearPhaseEngine.stop();
+
+        // [LUCAS] : The oversampled peak delays the whole chain, it is in series with it
+        setLatencySamples(juce::roundToInt(floatOversampledPeak.oversampler.getLatencyInSamples()));
+    }
+}
+
+void SimpleEQAudioProcessor::prepareDspState(const juce::dsp::ProcessSpec& spec, const juce::dsp::ProcessSpec& oversampledSpec)
+{
+    const auto numChannels = (int) spec.numChannels;
+
+    // [LUCAS] : The cascades of each sample type are laid out together,
+    //           in the order they process a block : the peak, then the FilterChain
+    const std::array<size_t, 4> stateSizes {
+        PeakFilter<float>::getStateSizeInBytes(numChannels),
+        FilterChain<float>::getStateSizeInBytes(numChannels),
+        PeakFilter<double>::getStateSizeInBytes(numChannels),
+        FilterChain<double>::getStateSizeInBytes(numChannels)
+    };
+
+    // [LUCAS] : One tile is enough for every cascade, as they process one after the other
+    const auto scratchSize = juce::jmax(PeakFilter<float>::getScratchSizeInBytes(numChannels, (int) oversampledSpec.maximumBlockSize),
+                                        FilterChain<float>::getScratchSizeInBytes(numChannels, (int) spec.maximumBlockSize),
+                                        PeakFilter<double>::getScratchSizeInBytes(numChannels, (int) oversampledSpec.maximumBlockSize),
+                                        FilterChain<double>::getScratchSizeInBytes(numChannels, (int) spec.maximumBlockSize));
+
+    const auto stateSize = std::accumulate(stateSizes.begin(), stateSizes.end(), size_t(0));
+
+    CacheAlignedMemory newState;
+    newState.allocate(stateSize + scratchSize);
+
+    auto* memory = newState.getData();
+    auto* scratch = memory + stateSize;
+
+    floatOversampledPeak.filter.prepare(oversampledSpec, memory, scratch);
+    memory += stateSizes[0];
+
+    floatFilterChain.prepare(spec, memory, scratch);
+    memory += stateSizes[1];
+
+    doubleOversampledPeak.filter.prepare(oversampledSpec, memory, scratch);
+    memory += stateSizes[2];
+
+    doubleFilterChain.prepare(spec, memory, scratch);
+
+    // [LUCAS] : The previous block is only freed now that the cascades moved their coefficients out of it
+    dspState.swapWith(newState);
+}
+
+size_t SimpleEQAudioProcessor::getDspStateSizeInBytes() const
+{
+    return (dspState.getSize());
+}
+
+const void* SimpleEQAudioProcessor::getDspStateData() const
+{
+    return (dspState.getData());
+}
+
+void SimpleEQAudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+    coefficientDesigner.stop();
+    linearPhaseEngine.stop();
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // This is the place where you check if the layout is supported.
+    // [LUCAS] : The FilterChain processes any number of channels in SIMD lanes,
+    //           so mono, stereo, surround and ambisonic layouts are all supported.
+    // Some plugin hosts, such as certain GarageBand versions, will only
+    // load plugins that support stereo bus layouts.
+    const auto& outputChannelSet = layouts.getMainOutputChannelSet();
+
+    const juce::AudioChannelSet supportedChannelSets[] = {
+        juce::AudioChannelSet::mono(),
+        juce::AudioChannelSet::stereo(),
+        juce::AudioChannelSet::createLCR(),
+        juce::AudioChannelSet::quadraphonic(),
+        juce::AudioChannelSet::create5point0(),
+        juce::AudioChannelSet::create5point1(),
+        juce::AudioChannelSet::create7point0(),
+        juce::AudioChannelSet::create7point1(),
+        juce::AudioChannelSet::create7point1point4(),
+        juce::AudioChannelSet::ambisonic(1),
+        juce::AudioChannelSet::ambisonic(2),
+        juce::AudioChannelSet::ambisonic(3)
+    };
+
+    if (std::find(std::begin(supportedChannelSets), std::end(supportedChannelSets), outputChannelSet)
+        == std::end(supportedChannelSets))
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+bool SimpleEQAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template<typename SampleType>
+void SimpleEQAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    // [LUCAS] : In a SIMPLEEQ_REALTIME_AUDIT build, any allocation or lock from here on is reported
+    RealtimeSafety::ScopedAudioThread audioThread;
+
+    performanceMonitor.beginBlock();
+
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    // In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+
+    // [LUCAS] : Either picks up the coefficients finished by the designer thread,
+    //           or starts ramping towards the new parameter values,
+    //           or redesigns the filters whose settings changed
+    performanceMonitor.beginCoefficientUpdate();
+
+    bool redesigned = false;
+
+    // [LUCAS] : A restored state comes with its coefficients, so applying it is only a copy
+    const auto sequence = stateSequence.load(std::memory_order_acquire);
+
+    if (auto* restoredState = restoredStates.read())
+        redesigned = applyRestoredState(*restoredState);
+
+    ChainSettings chainSettings;
+
+    if (activePhaseMode == PhaseMode::linearPhase)
+    {
+        // [LUCAS] : The linear phase kernels are designed by the LinearPhaseEngine thread
+    }
+    else if (activeCoefficientUpdateMode == CoefficientUpdateMode::backgroundThread)
+    {
+        // [LUCAS] : A set designed before the last restored state would override it with older settings
+        auto* coefficientSet = coefficientDesigner.getNewCoefficients();
+
+        if (coefficientSet != nullptr && (juce::int32) (coefficientSet->stateSequence - appliedStateSequence) >= 0)
+        {
+            designedCoefficients = *coefficientSet;
+            applyCoefficientSet(designedCoefficients);
+            redesigned = true;
+        }
+    }
+    else if (! readChainSettings(sequence, chainSettings))
+    {
+        // [LUCAS] : A state is being restored, so the parameters are left alone until it is whole
+    }
+    else if (activeCoefficientUpdateMode == CoefficientUpdateMode::smoothed)
+    {
+        chainSmoother.setTarget(chainSettings);
+
+        // [LUCAS] : The slopes jump, so they may change while nothing ramps
+        if (! chainSmoother.isSmoothing())
+            redesigned = applySmoothedSettings(chainSmoother.getCurrent(), false) || redesigned;
+    }
+    else
+    {
+        redesigned = updateFilters(chainSettings) || redesigned;
+    }
+
+    // [LUCAS] : The parametric bands are designed here in every IIR mode, as their designs are cheap.
+    //           In linear phase, the LinearPhaseEngine folds them into its kernel.
+    //           In the smoothed mode they ramp with the other filters.
+    ChainBands::Settings bandSettings;
+
+    if (activePhaseMode == PhaseMode::minimumPhase && readBandSettings(sequence, bandSettings))
+    {
+        if (activeCoefficientUpdateMode == CoefficientUpdateMode::smoothed)
+        {
+            chainSmoother.setBandTargets(bandSettings);
+
+            // [LUCAS] : The enabled flags and the types jump, so they may change while nothing ramps
+            if (! chainSmoother.isSmoothing())
+                redesigned = applySmoothedBands() || redesigned;
+        }
+        else
+        {
+            redesigned = updateBands(bandSettings, false, neutralStageTolerance) || redesigned;
+        }
+    }
+
+    // [LUCAS] : The dynamic peak takes over the peak filter in the IIR modes.
+    //           When it stops, the static peak filter is put back.
+    const auto dynamicSettings = getDynamicSettings(dynamicParameters);
+    const bool dynamic = (activePhaseMode == PhaseMode::minimumPhase && dynamicSettings.enabled);
+
+    if (dynamic)
+    {
+        if (! dynamicPeakActive)
+            dynamicPeak.reset();
+
+        dynamicPeak.setSettings(dynamicSettings);
+
+        ChainSettings peakSettings;
+
+        if (activeCoefficientUpdateMode == CoefficientUpdateMode::smoothed)
+            dynamicPeakSettings = chainSmoother.getCurrent();
+        else if (readChainSettings(sequence, peakSettings))
+            dynamicPeakSettings = peakSettings;
+    }
+    else if (dynamicPeakActive)
+    {
+        if (activeCoefficientUpdateMode == CoefficientUpdateMode::smoothed)
+            applySmoothedSettings(chainSmoother.getCurrent(), true);
+        else
+            applyPeakCoefficients(designedCoefficients);
+
+        redesigned = true;
+    }
+
+    dynamicPeakActive = dynamic;
+
+    if (redesigned)
+    {
+        updateTailLength();
+        publishResponseCoefficients();
+    }
+
+    performanceMonitor.endCoefficientUpdate(redesigned);
+
+    // [LUCAS] : Create an AudioBlock wrapper for the input channels only,
+    //           so a mono bus never reaches for a second channel
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+    auto inputBlock = block.getSubsetChannelBlock(0, (size_t) juce::jmin(totalNumInputChannels, (int) buffer.getNumChannels()));
+
+    spectrumAnalyzer.pushSamples(SpectrumAnalyzer::preEq, inputBlock);
+
+    // [LUCAS] : Leaves the block untouched when every filter is neutral,
+    //           or outputs silence without processing when nothing can be heard,
+    //           or processes every channel at once, packed into SIMD lanes,
+    //           or through the linear phase convolutions
+    const bool smoothing = (activeCoefficientUpdateMode == CoefficientUpdateMode::smoothed && chainSmoother.isSmoothing());
+
+    // [LUCAS] : The oversampling always runs, even for a neutral peak, so the latency holds
+    if (activePhaseMode == PhaseMode::minimumPhase && ! smoothing && ! dynamic && activePeakOversamplingFactor == 1
+        && getFilterChain<SampleType>().isPassThrough())
+    {
+        // [LUCAS] : The input is already the output
+    }
+    else if (canSkipBlock(inputBlock))
+    {
+        inputBlock.clear();
+
+        // [LUCAS] : The ramps go on, so the filters are where they should be when the signal returns
+        if (smoothing)
+        {
+            applySmoothedSettings(chainSmoother.skip((int) inputBlock.getNumSamples()), false);
+            applySmoothedBands();
+            updateTailLength();
+            publishResponseCoefficients();
+        }
+
+        // [LUCAS] : And the envelope releases over the silence
+        if (dynamic)
+            dynamicPeak.skip((int) inputBlock.getNumSamples());
+    }
+    else if (activePhaseMode == PhaseMode::linearPhase)
+    {
+        processLinearPhase(inputBlock);
+    }
+    else if (dynamic)
+    {
+        processDynamic(inputBlock, smoothing);
+    }
+    else if (smoothing)
+    {
+        processSmoothed(inputBlock);
+    }
+    else
+    {
+        processFilterChain(inputBlock);
+    }
+
+    spectrumAnalyzer.pushSamples(SpectrumAnalyzer::postEq, inputBlock);
+
+    performanceMonitor.endBlock(buffer.getNumSamples());
+}
+
+template<typename SampleType>
+bool SimpleEQAudioProcessor::canSkipBlock(const juce::dsp::AudioBlock<SampleType>& block)
+{
+    if (! silenceDetectionEnabled.load(std::memory_order_relaxed))
+        return (false);
+
+    const auto numSamples = (int) block.getNumSamples();
+
+    // [LUCAS] : A vectorised peak check of every channel
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(channel), numSamples);
+
+        if (juce::jmax(-range.getStart(), range.getEnd()) > static_cast<SampleType>(silenceThreshold))
+        {
+            numSilentSamples = 0;
+            return (false);
+        }
+    }
+
+    numSilentSamples = juce::jmin(numSilentSamples + numSamples, std::numeric_limits<int>::max() / 2);
+
+    // [LUCAS] : The state of the convolutions cannot be inspected, but it only holds
+    //           zeros once the whole FIR, delayed by the latency, has been fed silence
+    if (activePhaseMode == PhaseMode::linearPhase)
+        return (numSilentSamples >= linearPhaseEngine.getFirLength() + linearPhaseEngine.getLatencySamples());
+
+    // [LUCAS] : The half-band filters of the oversampled peak decay too, and what they
+    //           hold below the silence threshold is left for when the signal returns
+    if (activePeakOversamplingFactor > 1)
+    {
+        auto& peak = getOversampledPeak<SampleType>();
+
+        if (! peak.filter.isStateSilent() || ! peak.oversampler.isStateSilent(static_cast<SampleType>(silenceThreshold)))
+            return (false);
+    }
+
+    // [LUCAS] : The filter states are flushed to zero once they have decayed,
+    //           so the filters resume from rest, without a click, when the signal returns
+    return (getFilterChain<SampleType>().isStateSilent());
+}
+
+void SimpleEQAudioProcessor::updateTailLength()
+{
+    auto tailLength = (juce::int64) floatFilterChain.getTailLengthInSamples();
+
+    // [LUCAS] : The oversampled peak rings at its own rate, behind the delay of the oversampling
+    if (activePeakOversamplingFactor > 1)
+        tailLength += floatOversampledPeak.filter.getTailLengthInSamples() / activePeakOversamplingFactor
+                    + juce::roundToInt(floatOversampledPeak.oversampler.getLatencyInSamples());
+
+    tailLengthInSamples.store((int) juce::jmin(tailLength, (juce::int64) std::numeric_limits<int>::max()));
+}
+
+void SimpleEQAudioProcessor::publishResponseCoefficients()
+{
+    auto& coefficientSet = responseCoefficients.getWriteBuffer();
+
+    if (floatFilterChain.getTopology() == FilterTopology::stateVariable)
+    {
+        // [LUCAS] : The state variable sections have the response of the biquads of the same settings
+        const auto sampleRate = getSampleRate();
+
+        coefficientSet.peakOversamplingFactor = activePeakOversamplingFactor;
+        designPeakCoefficients(coefficientSet, designedSettings, sampleRate);
+        designLowCutCoefficients(coefficientSet, designedSettings, sampleRate);
+        designHighCutCoefficients(coefficientSet, designedSettings, sampleRate);
+
+        // [LUCAS] : The filters left out are the ones of the chain, which keeps them while they ramp
+        coefficientSet.peakNeutral = designedCoefficients.peakNeutral;
+        coefficientSet.lowCutNeutral = designedCoefficients.lowCutNeutral;
+        coefficientSet.highCutNeutral = designedCoefficients.highCutNeutral;
+    }
+    else
+    {
+        coefficientSet = designedCoefficients;
+    }
+
+    chainBands.getBiquads(coefficientSet.bands, coefficientSet.activeBands);
+
+    responseCoefficients.publish();
+}
+
+const CoefficientSet* SimpleEQAudioProcessor::getResponseCoefficients() noexcept
+{
+    const auto* newCoefficients = (activePhaseMode == PhaseMode::linearPhase ? linearPhaseEngine.getNewCoefficients()
+                                                                             : responseCoefficients.read());
+
+    if (newCoefficients != nullptr)
+    {
+        editorCoefficients = *newCoefficients;
+        hasEditorCoefficients = true;
+    }
+
+    return (hasEditorCoefficients ? &editorCoefficients : nullptr);
+}
+
+template<typename SampleType>
+void SimpleEQAudioProcessor::processLinearPhase(juce::dsp::AudioBlock<SampleType>& block)
+{
+    if constexpr (std::is_same<SampleType, float>::value)
+    {
+        linearPhaseEngine.process(block);
+    }
+    else
+    {
+        // [LUCAS] : Converts through the float buffer, in chunks of its size
+        const auto numChannels = juce::jmin(block.getNumChannels(), (size_t) linearPhaseBuffer.getNumChannels());
+        const auto chunkSize = (size_t) linearPhaseBuffer.getNumSamples();
+
+        for (size_t start = 0; start < block.getNumSamples(); start += chunkSize)
+        {
+            const auto length = juce::jmin(chunkSize, block.getNumSamples() - start);
+
+            auto chunk = block.getSubBlock(start, length).getSubsetChannelBlock(0, numChannels);
+            auto floatChunk = juce::dsp::AudioBlock<float>(linearPhaseBuffer).getSubBlock(0, length).getSubsetChannelBlock(0, numChannels);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* source = chunk.getChannelPointer(channel);
+                auto* destination = floatChunk.getChannelPointer(channel);
+
+                for (size_t i = 0; i < length; ++i)
+                    destination[i] = (float) source[i];
+            }
+
+            linearPhaseEngine.process(floatChunk);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* source = floatChunk.getChannelPointer(channel);
+                auto* destination = chunk.getChannelPointer(channel);
+
+                for (size_t i = 0; i < length; ++i)
+                    destination[i] = (double) source[i];
+            }
+        }
+    }
+}
+
+// [LUCAS] : The peak filter runs first, between the up and the down sampling,
+//           and the rest of the chain at the base rate
+template<typename SampleType>
+void SimpleEQAudioProcessor::processFilterChain(juce::dsp::AudioBlock<SampleType>& block)
+{
+    if (activePeakOversamplingFactor > 1)
+    {
+        auto& peak = getOversampledPeak<SampleType>();
+        auto oversampledBlock = peak.oversampler.processSamplesUp(block);
+
+        juce::dsp::ProcessContextReplacing<SampleType> oversampledContext(oversampledBlock);
+        peak.filter.process(oversampledContext);
+
+        peak.oversampler.processSamplesDown(block);
+    }
+
+    juce::dsp::ProcessContextReplacing<SampleType> context(block);
+    getFilterChain<SampleType>().process(context);
+}
+
+//==============================================================================
+bool SimpleEQAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* SimpleEQAudioProcessor::createEditor()
+{
+    // [LUCAS] : The SimpleEQAudioProcessorEditor shows the GenericAudioProcessorEditor
+    //           for the parameters, plus the timings of processBlock
+    return new SimpleEQAudioProcessorEditor (*this);
+}
+
+//==============================================================================
+void SimpleEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // [LUCAS] : The parameters are stored in the compact binary layout of PluginState
+    PluginState::write(parametersManager, destData);
+}
+
+void SimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // [LUCAS] : The sequence stays odd while the parameters are set one by one,
+    //           so the audio thread never designs filters from half a state
+    stateSequence.fetch_add(1, std::memory_order_acq_rel);
+
+    if (PluginState::read(parametersManager, data, sizeInBytes))
+    {
+        // [LUCAS] : Designs the coefficients here, before the audio thread sees the new parameters,
+        //           so the next block only copies them into the FilterChain
+        const auto sampleRate = getSampleRate();
+
+        if (sampleRate > 0.0)
+        {
+            auto& restoredState = restoredStates.getWriteBuffer();
+
+            restoredState.settings = chainSettingsSnapshot.read();
+            restoredState.sampleRate = sampleRate;
+            restoredState.coefficients.peakOversamplingFactor = activePeakOversamplingFactor;
+
+            // [LUCAS] : The sequence once this restore is over
+            restoredState.coefficients.stateSequence = stateSequence.load(std::memory_order_relaxed) + 1;
+
+            designPeakCoefficients(restoredState.coefficients, restoredState.settings, sampleRate);
+            designLowCutCoefficients(restoredState.coefficients, restoredState.settings, sampleRate, cutCoefficientCache.get());
+            designHighCutCoefficients(restoredState.coefficients, restoredState.settings, sampleRate, cutCoefficientCache.get());
+            classifyNeutralStages(restoredState.coefficients, restoredState.settings, sampleRate, neutralStageTolerance);
+
+            // [LUCAS] : The topology only changes in prepareToPlay, the audio thread checks it anyway
+            restoredState.bands.design(getBandSettings(), sampleRate, floatFilterChain.getTopology(), neutralStageTolerance, false);
+
+            restoredStates.publish();
+        }
+    }
+
+    stateSequence.fetch_add(1, std::memory_order_release);
+}
+
+bool SimpleEQAudioProcessor::readChainSettings(juce::uint32 sequence, ChainSettings& chainSettings)
+{
+    if ((sequence & 1u) != 0)
+        return (false);
+
+    // [LUCAS] : A write in progress leaves the previous settings in place until the next block
+    if (! chainSettingsSnapshot.tryRead(chainSettings))
+        return (false);
+
+    // [LUCAS] : A restore that started meanwhile may have left the settings half restored
+    return (stateSequence.load(std::memory_order_acquire) == sequence);
+}
+
+SimpleEQAudioProcessor::ChainBands::Settings SimpleEQAudioProcessor::getBandSettings() const
+{
+    ChainBands::Settings bandSettings;
+
+    for (size_t band = 0; band < bandSettings.size(); ++band)
+        bandSettings[band] = ::getBandSettings(bandParameters[band]);
+
+    return (bandSettings);
+}
+
+bool SimpleEQAudioProcessor::readBandSettings(juce::uint32 sequence, ChainBands::Settings& bandSettings)
+{
+    if ((sequence & 1u) != 0)
+        return (false);
+
+    bandSettings = getBandSettings();
+
+    return (stateSequence.load(std::memory_order_acquire) == sequence);
+}
+
+bool SimpleEQAudioProcessor::updateBands(const ChainBands::Settings& bandSettings, bool forceRedesign, float toleranceInDb)
+{
+    const auto designed = chainBands.design(bandSettings, getSampleRate(), floatFilterChain.getTopology(),
+                                            toleranceInDb, forceRedesign);
+
+    if (designed.none())
+        return (false);
+
+    forEachFilterChain([this, designed](auto& chain)
+    {
+        chainBands.apply(chain, ChainPositions::Bands, designed);
+    });
+
+    return (true);
+}
+
+bool SimpleEQAudioProcessor::applySmoothedBands()
+{
+    return (updateBands(chainSmoother.getCurrentBands(), false,
+                        chainSmoother.isSmoothing() ? -1.0f : neutralStageTolerance));
+}
+
+bool SimpleEQAudioProcessor::applyRestoredState(const RestoredState& restoredState)
+{
+    // [LUCAS] : The linear phase kernels are designed by their own thread,
+    //           and a state restored before a new sample rate or oversampling is designed again as usual
+    if (activePhaseMode == PhaseMode::linearPhase || restoredState.sampleRate != getSampleRate()
+        || restoredState.coefficients.peakOversamplingFactor != activePeakOversamplingFactor)
+        return (false);
+
+    appliedStateSequence = restoredState.coefficients.stateSequence;
+
+    // [LUCAS] : The restored state is jumped to, it is not ramped
+    if (activeCoefficientUpdateMode == CoefficientUpdateMode::smoothed)
+    {
+        chainSmoother.setCurrentAndTarget(restoredState.settings);
+        chainSmoother.setCurrentAndTargetBands(restoredState.bands.getSettings());
+
+        // [LUCAS] : The state variable sections are not biquads, their closed-form design is cheap
+        if (floatFilterChain.getTopology() == FilterTopology::stateVariable)
+            return (applySmoothedSettings(restoredState.settings, true));
+    }
+
+    designedSettings = restoredState.settings;
+    designedCoefficients = restoredState.coefficients;
+    designedSampleRate = restoredState.sampleRate;
+
+    applyCoefficientSet(designedCoefficients);
+
+    if (restoredState.bands.getTopology() == floatFilterChain.getTopology())
+    {
+        chainBands = restoredState.bands;
+
+        forEachFilterChain([this](auto& chain)
+        {
+            chainBands.apply(chain, ChainPositions::Bands);
+        });
+    }
+    else
+        updateBands(getBandSettings(), true, neutralStageTolerance);
+
+    return (true);
+}
+
+// [LUCAS] : This function redesigns the filters whose smoothed settings changed,
+//           in the topology of the FilterChain
+bool SimpleEQAudioProcessor::applySmoothedSettings(const ChainSettings& chainSettings, bool forceRedesign)
+{
+    const auto sampleRate = getSampleRate();
+    const bool stateVariable = (floatFilterChain.getTopology() == FilterTopology::stateVariable);
+
+    // [LUCAS] : While the settings ramp, no filter is left out of the chain, so a cut reaching
+    //           the end of its range or a gain crossing 0 dB does not drop out in one sample.
+    //           They are classified again once the ramps are done.
+    const bool wasPeakNeutral = designedCoefficients.peakNeutral;
+    const bool wasLowCutNeutral = designedCoefficients.lowCutNeutral;
+    const bool wasHighCutNeutral = designedCoefficients.highCutNeutral;
+
+    classifyNeutralStages(designedCoefficients, chainSettings, sampleRate,
+                          chainSmoother.isSmoothing() ? -1.0f : neutralStageTolerance);
+
+    bool redesigned = false;
+
+    if (forceRedesign || peakSettingsChanged(chainSettings, designedSettings) || designedCoefficients.peakNeutral != wasPeakNeutral)
+    {
+        if (stateVariable)
+        {
+            const auto peakCoefficients = designStateVariablePeak(chainSettings.peakFreq,
+                                                                  chainSettings.peakQ,
+                                                                  chainSettings.peakGainInDb,
+                                                                  getPeakSampleRate());
+
+            setPeakSection(peakCoefficients, designedCoefficients.peakNeutral);
+        }
+        else
+        {
+            updatePeakFilter(chainSettings);
+        }
+
+        redesigned = true;
+    }
+
+    if (forceRedesign || lowCutSettingsChanged(chainSettings, designedSettings) || designedCoefficients.lowCutNeutral != wasLowCutNeutral)
+    {
+        if (stateVariable)
+        {
+            std::array<StateVariableCoefficients, 4> cutCoefficients;
+            designStateVariableHighPass(cutCoefficients, chainSettings.lowCutFreq, chainSettings.lowCutSlope, sampleRate);
+            forEachFilterChain([this, &cutCoefficients, &chainSettings](auto& chain)
+            {
+                updateCutFilter(chain, ChainPositions::LowCut, cutCoefficients, chainSettings.lowCutSlope,
+                                designedCoefficients.lowCutNeutral);
+            });
+        }
+        else
+        {
+            // [LUCAS] : The ramping frequencies are seldom whole numbers, so the cache is left out
+            designLowCutCoefficients(designedCoefficients, chainSettings, sampleRate);
+            applyLowCutCoefficients(designedCoefficients);
+        }
+
+        redesigned = true;
+    }
+
+    if (forceRedesign || highCutSettingsChanged(chainSettings, designedSettings) || designedCoefficients.highCutNeutral != wasHighCutNeutral)
+    {
+        if (stateVariable)
+        {
+            std::array<StateVariableCoefficients, 4> cutCoefficients;
+            designStateVariableLowPass(cutCoefficients, chainSettings.highCutFreq, chainSettings.highCutSlope, sampleRate);
+            forEachFilterChain([this, &cutCoefficients, &chainSettings](auto& chain)
+            {
+                updateCutFilter(chain, ChainPositions::HighCut, cutCoefficients, chainSettings.highCutSlope,
+                                designedCoefficients.highCutNeutral);
+            });
+        }
+        else
+        {
+            designHighCutCoefficients(designedCoefficients, chainSettings, sampleRate);
+            applyHighCutCoefficients(designedCoefficients);
+        }
+
+        redesigned = true;
+    }
+
+    designedSettings = chainSettings;
+
+    return (redesigned);
+}
+
+// [LUCAS] : This function processes a block in sub-blocks, redesigning the filters
+//           from the ramped settings before each of them
+template<typename SampleType>
+void SimpleEQAudioProcessor::processSmoothed(juce::dsp::AudioBlock<SampleType>& block)
+{
+    const auto numSamples = (int) block.getNumSamples();
+
+    for (int start = 0; start < numSamples; start += activeControlInterval)
+    {
+        const auto length = juce::jmin(activeControlInterval, numSamples - start);
+
+        applySmoothedSettings(chainSmoother.skip(length), false);
+        applySmoothedBands();
+
+        auto subBlock = block.getSubBlock((size_t) start, (size_t) length);
+        processFilterChain(subBlock);
+    }
+
+    updateTailLength();
+    publishResponseCoefficients();
+}
+
+// [LUCAS] : This function processes a block in sub-blocks, measuring the level of each of them
+//           before the peak filter is redesigned with its gain reduction. The level is measured
+//           on the input of the sub-block, so the gain reacts to the audio it is applied to.
+template<typename SampleType>
+void SimpleEQAudioProcessor::processDynamic(juce::dsp::AudioBlock<SampleType>& block, bool smoothing)
+{
+    const auto numSamples = (int) block.getNumSamples();
+
+    for (int start = 0; start < numSamples; start += activeControlInterval)
+    {
+        const auto length = juce::jmin(activeControlInterval, numSamples - start);
+        auto subBlock = block.getSubBlock((size_t) start, (size_t) length);
+
+        if (smoothing)
+        {
+            applySmoothedSettings(chainSmoother.skip(length), false);
+            applySmoothedBands();
+            dynamicPeakSettings = chainSmoother.getCurrent();
+        }
+
+        const auto gainReductionInDb = dynamicPeak.process(subBlock);
+        applyDynamicPeak(dynamicPeakSettings, dynamicPeakSettings.peakGainInDb + gainReductionInDb);
+
+        processFilterChain(subBlock);
+    }
+
+    if (smoothing)
+    {
+        updateTailLength();
+        publishResponseCoefficients();
+    }
+}
+
+void SimpleEQAudioProcessor::applyDynamicPeak(const ChainSettings& peakSettings, float gainInDb)
+{
+    peakGainDesigner.prepare(peakSettings.peakFreq, peakSettings.peakQ, getPeakSampleRate());
+
+    // [LUCAS] : The peak stays in the plan even at 0 dB, so the gain moves without the
+    //           section being reset each time it crosses the neutral tolerance
+    if (floatFilterChain.getTopology() == FilterTopology::stateVariable)
+        setPeakSection(peakGainDesigner.designStateVariable(gainInDb), false);
+    else
+        setPeakSection(peakGainDesigner.design(gainInDb), false);
+}
+
+// [LUCAS] : This function updates the peak filter coefficients for the
+//           FilterChain based on the current chainSettings
+void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings)
+{
+    // [LUCAS] : Create the peak filter coefficients based on the current chainSettings
+    designPeakCoefficients(designedCoefficients, chainSettings, getSampleRate());
+
+    // [LUCAS] : Update the peak filter coefficients for the FilterChain
+    applyPeakCoefficients(designedCoefficients);
+}
+
+// [LUCAS] : This function updates the low cut filters of the FilterChain 
+//           based on the current chainSettings
+void SimpleEQAudioProcessor::updateLowCutFilter(const ChainSettings &chainSettings)
+{
+    // [LUCAS] : Calculates the high-pass filter coefficients using the Butterworth method 
+    designLowCutCoefficients(designedCoefficients, chainSettings, getSampleRate(), cutCoefficientCache.get());
+
+    // [LUCAS] : Updates the coefficients and slope of the low cut filters
+    //           in both the FilterChain
+    applyLowCutCoefficients(designedCoefficients);
+}
+
+// [LUCAS] : This function updates the high cut filters of the FilterChain 
+//           based on the current chainSettings
+void SimpleEQAudioProcessor::updateHighCutFilter(const ChainSettings &chainSettings)
+{
+    // [LUCAS] : Calculates the low-pass filter coefficients using the Butterworth method 
+    designHighCutCoefficients(designedCoefficients, chainSettings, getSampleRate(), cutCoefficientCache.get());
+
+    // [LUCAS] : Updates the coefficients and slope of the high cut filters
+    //           in both the FilterChain
+    applyHighCutCoefficients(designedCoefficients);
+}
+
+// [LUCAS] : These functions copy the designed coefficients of one filter into the FilterChains.
+//           Only plain values are copied, so they are safe to call from the audio thread.
+void SimpleEQAudioProcessor::applyPeakCoefficients(const CoefficientSet& coefficientSet)
+{
+    setPeakSection(coefficientSet.peak, coefficientSet.peakNeutral);
+}
+
+void SimpleEQAudioProcessor::applyLowCutCoefficients(const CoefficientSet& coefficientSet)
+{
+    forEachFilterChain([this, &coefficientSet](auto& chain)
+    {
+        updateCutFilter(chain, ChainPositions::LowCut, coefficientSet.lowCut, coefficientSet.lowCutSlope, coefficientSet.lowCutNeutral);
+    });
+}
+
+void SimpleEQAudioProcessor::applyHighCutCoefficients(const CoefficientSet& coefficientSet)
+{
+    forEachFilterChain([this, &coefficientSet](auto& chain)
+    {
+        updateCutFilter(chain, ChainPositions::HighCut, coefficientSet.highCut, coefficientSet.highCutSlope, coefficientSet.highCutNeutral);
+    });
+}
+
+// [LUCAS] : This function copies a finished CoefficientSet into the FilterChain
+void SimpleEQAudioProcessor::applyCoefficientSet(const CoefficientSet& coefficientSet)
+{
+    applyPeakCoefficients(coefficientSet);
+    applyLowCutCoefficients(coefficientSet);
+    applyHighCutCoefficients(coefficientSet);
+}
+
+// [LUCAS] : This method selects where the filter coefficients are designed.
+//           It takes effect on the next call to prepareToPlay.
+void SimpleEQAudioProcessor::setCoefficientUpdateMode(CoefficientUpdateMode newMode)
+{
+    coefficientUpdateMode = newMode;
+}
+
+CoefficientUpdateMode SimpleEQAudioProcessor::getCoefficientUpdateMode() const
+{
+    return (coefficientUpdateMode);
+}
+
+// [LUCAS] : These methods set the parameter ramps of CoefficientUpdateMode::smoothed.
+//           They take effect on the next call to prepareToPlay.
+void SimpleEQAudioProcessor::setSmoothingRampLength(double newRampLengthInSeconds)
+{
+    smoothingRampLength = juce::jmax(0.0, newRampLengthInSeconds);
+}
+
+void SimpleEQAudioProcessor::setSmoothingControlInterval(int newControlIntervalInSamples)
+{
+    smoothingControlInterval = juce::jlimit(1, 1024, newControlIntervalInSamples);
+}
+
+void SimpleEQAudioProcessor::setSmoothingTopology(FilterTopology newTopology)
+{
+    smoothingTopology = newTopology;
+}
+
+double SimpleEQAudioProcessor::getSmoothingRampLength() const
+{
+    return (smoothingRampLength);
+}
+
+int SimpleEQAudioProcessor::getSmoothingControlInterval() const
+{
+    return (smoothingControlInterval);
+}
+
+FilterTopology SimpleEQAudioProcessor::getSmoothingTopology() const
+{
+    return (smoothingTopology);
+}
+
+// [LUCAS] : These methods select the linear phase mode.
+//           They take effect on the next call to prepareToPlay.
+void SimpleEQAudioProcessor::setPhaseMode(PhaseMode newMode)
+{
+    phaseMode = newMode;
+}
+
+void SimpleEQAudioProcessor::setLinearPhaseFirLength(int newFirLength)
+{
+    linearPhaseFirLength = juce::jlimit(LinearPhaseEngine::minFirLength,
+                                        LinearPhaseEngine::maxFirLength,
+                                        juce::nextPowerOfTwo(newFirLength));
+}
+
+void SimpleEQAudioProcessor::setLinearPhaseConvolutionLatency(int newLatencyInSamples)
+{
+    linearPhaseConvolutionLatency = juce::jmax(0, newLatencyInSamples);
+}
+
+PhaseMode SimpleEQAudioProcessor::getPhaseMode() const
+{
+    return (phaseMode);
+}
+
+int SimpleEQAudioProcessor::getLinearPhaseFirLength() const
+{
+    return (linearPhaseFirLength);
+}
+
+int SimpleEQAudioProcessor::getLinearPhaseConvolutionLatency() const
+{
+    return (linearPhaseConvolutionLatency);
+}
+
+// [LUCAS] : These methods select the oversampling of the peak filter.
+//           They take effect on the next call to prepareToPlay.
+void SimpleEQAudioProcessor::setPeakOversamplingFactor(int newFactor)
+{
+    peakOversamplingFactor = (newFactor >= 4 ? 4 : newFactor >= 2 ? 2 : 1);
+}
+
+void SimpleEQAudioProcessor::setPeakOversamplingPhase(PhaseMode newPhase)
+{
+    peakOversamplingPhase = newPhase;
+}
+
+int SimpleEQAudioProcessor::getPeakOversamplingFactor() const
+{
+    return (peakOversamplingFactor);
+}
+
+PhaseMode SimpleEQAudioProcessor::getPeakOversamplingPhase() const
+{
+    return (peakOversamplingPhase);
+}
+
+double SimpleEQAudioProcessor::getPeakSampleRate() const
+{
+    return (getSampleRate() * activePeakOversamplingFactor);
+}
+
+// [LUCAS] : This method sets the tolerance under which a filter is left out of the chain.
+//           It takes effect on the next call to prepareToPlay.
+void SimpleEQAudioProcessor::setNeutralStageTolerance(float newToleranceInDb)
+{
+    neutralStageTolerance = newToleranceInDb;
+}
+
+float SimpleEQAudioProcessor::getNeutralStageTolerance() const
+{
+    return (neutralStageTolerance);
+}
+
+// [LUCAS] : This method selects whether silent blocks are skipped once the filters are at rest
+void SimpleEQAudioProcessor::setSilenceDetectionEnabled(bool shouldBeEnabled)
+{
+    silenceDetectionEnabled.store(shouldBeEnabled);
+}
+
+bool SimpleEQAudioProcessor::isSilenceDetectionEnabled() const
+{
+    return (silenceDetectionEnabled.load());
+}
+
+void SimpleEQAudioProcessor::setDualMonoDetectionEnabled(bool shouldBeEnabled)
+{
+    dualMonoDetectionEnabled = shouldBeEnabled;
+}
+
+bool SimpleEQAudioProcessor::isDualMonoDetectionEnabled() const
+{
+    return (dualMonoDetectionEnabled);
+}
+
+// [LUCAS] : This method selects whether prepareToPlay fills the shared cut filter cache
+void SimpleEQAudioProcessor::setCutCoefficientCachePrewarmed(bool shouldBePrewarmed)
+{
+    cutCoefficientCachePrewarmed = shouldBePrewarmed;
+}
+
+bool SimpleEQAudioProcessor::isCutCoefficientCachePrewarmed() const
+{
+    return (cutCoefficientCachePrewarmed);
+}
+
+// [LUCAS] : This method gives access to the timings of processBlock
+PerformanceMonitor& SimpleEQAudioProcessor::getPerformanceMonitor()
+{
+    return (performanceMonitor);
+}
+
+// [LUCAS] : This method gives access to the spectrum of the input and output of the EQ
+SpectrumAnalyzer& SimpleEQAudioProcessor::getSpectrumAnalyzer()
+{
+    return (spectrumAnalyzer);
+}
+
+// [LUCAS] : This function updates the filters in the audio processing chains :
+//           low cut filter, peak filter, and high cut filter
+//           based on the given settings.
+//           Only the filters whose settings (or the sample rate) changed
+//           since the last call are redesigned.
+//           Returns true if any filter was redesigned.
+bool SimpleEQAudioProcessor::updateFilters(const ChainSettings& chainSettings)
+{
+    // A new sample rate invalidates every filter design
+    const auto sampleRate = getSampleRate();
+    const bool sampleRateChanged = (sampleRate != designedSampleRate);
+
+    // Flags the filters that leave the audio unchanged, so they are left out of the FilterChain
+    classifyNeutralStages(designedCoefficients, chainSettings, sampleRate, neutralStageTolerance);
+
+    // Calls the appropriate update functions, only for the filters whose settings changed,
+    // to update the filter coefficients and settings in the FilterChain
+    bool redesigned = false;
+
+    if (sampleRateChanged || peakSettingsChanged(chainSettings, designedSettings))
+    {
+        updatePeakFilter(chainSettings);
+        redesigned = true;
+    }
+
+    if (sampleRateChanged || lowCutSettingsChanged(chainSettings, designedSettings))
+    {
+        updateLowCutFilter(chainSettings);
+        redesigned = true;
+    }
+
+    if (sampleRateChanged || highCutSettingsChanged(chainSettings, designedSettings))
+    {
+        updateHighCutFilter(chainSettings);
+        redesigned = true;
+    }
+
+    designedSettings = chainSettings;
+    designedSampleRate = sampleRate;
+
+    return (redesigned);
+}
+
+//[LUCAS] : This method creates the parameters for my EQ
+juce::AudioProcessorValueTreeState::ParameterLayout
+    SimpleEQAudioProcessor::createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("LowCut Freq", 1),
+        "LowCut Freq",
+        juce::NormalisableRange<float>(minCutFrequency, maxCutFrequency, 1.f, 0.25f),
+        minCutFrequency
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("HighCut Freq", 1),
+        "HighCut Freq",
+        juce::NormalisableRange<float>(minCutFrequency, maxCutFrequency, 1.f, 0.25f),
+        maxCutFrequency
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("Peak Freq", 1),
+        "Peak Freq",
+        juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+        750.f
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("Peak Gain", 1),
+        "Peak Gain",
+        juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
+        0.0f
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID("Peak Quality", 1),
+        "Peak Quality",
+        juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f),
+        1.0f
+    ));
+    
+    juce::StringArray parametersArray;
+    for(int i = 0; i < 4; ++i)
+    {
+        juce::String parameterString;
+        parameterString << (12 + i * 12);
+        parameterString << " db/Oct";
+        parametersArray.add(parameterString);
+    }
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("LowCut Slope", 1),
+        "LowCut Slope",
+        parametersArray,
+        0
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("HighCut Slope", 1),
+        "HighCut Slope",
+        parametersArray,
+        0
+    ));
+
+    // [LUCAS] : The parameters of the parametric bands are generated from the band count
+    addBandParameters(layout, numParametricBands);
+
+    addDynamicParameters(layout);
+
+    return (layout);
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SimpleEQAudioProcessor();
+}
@@ -1,184 +1,527 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-// [LUCAS] : This enum defines and represents the slope of the filters
-enum Slope
-{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
-};
-
-// [LUCAS] : This structure holds the parameters of the EQ
-struct ChainSettings
-{
-    float peakFreq { 0 }, peakGainInDb { 0 }, peakQ { 1.f };
-    float lowCutFreq { 0 }, highCutFreq { 0 };
-    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
-};
-
-// [LUCAS] : This function is a getter for the parameters settings of the EQ.
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& parametersManager);
-
-//==============================================================================
-/**
-*/
-class SimpleEQAudioProcessor  : public juce::AudioProcessor
-                            #if JucePlugin_Enable_ARA
-                             , public juce::AudioProcessorARAExtension
-                            #endif
-{
-public:
-    //==============================================================================
-    SimpleEQAudioProcessor();
-    ~SimpleEQAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-
-    // [LUCAS] : This method creates the parameters of my EQ
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-  
-    // [LUCAS] : This is the object that manages the parameters of my EQ
-    juce::AudioProcessorValueTreeState parametersManager{
-        *this,
-        nullptr,
-        "Parameters",
-        createParameterLayout()
-    };
-
-private:
-
-    // [LUCAS] : This enum defines and represents the positions of
-    //           the different filter types within the MonoChain :
-    //           [0] LowCut [1] Peak [2] HighCut  
-    enum ChainPositions
-    {
-        LowCut,
-        Peak,
-        HighCut
-    };
-
-    // [LUCAS] : This defines an alias type, `Filter`,
-    //           for a single-precision float IIR filter
-    using Filter = juce::dsp::IIR::Filter<float>;
-
-    // [LUCAS] : This defines an alias type, `Coefficients`,
-    //           for a Filter::CoefficientsPtr    
-    using Coefficients = Filter::CoefficientsPtr;
-
-    // [LUCAS] : This defines an alias type, `CutFilter`,
-    //           for a chain of four IIR filters
-    using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-
-    // [LUCAS] : This defines a MonoChain as a chain containing :
-    //           a CutFilter, a single IIR filter, and another CutFilter
-    using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
-
-    // [LUCAS] : Declaration of left and right MonoChains for processing stereo audio
-    MonoChain leftChain, rightChain;
-
-    // [LUCAS] : This template helper function updates the coefficients of
-    //           an index-specific filter within a processing chain
-    template<int Index, typename ChainType, typename CoefficientType>
-    void update(ChainType& chain, const CoefficientType& coefficients)
-    {
-        // [LUCAS] : Updates the coefficients of the filter at the given index in the chain 
-        updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
-
-        // [LUCAS] : Sets the filer bypass status to false (i.e., activate the filter)
-        chain.template setBypassed<Index>(false);
-    }
-
-    // [LUCAS] : This function updates all the filters in the audio processing chains :
-    //           low cut filter, peak filter, and high cut filter
-    //           based on the current parameters
-    void updateFilters();
-
-    // [LUCAS] : This function updates the peak filter coefficients of the
-    //           left and right MonoChains based on the current chainSettings
-    void updatePeakFilter(const ChainSettings& chainSettings);
-
-    // [LUCAS] : This function updates the low cut filter coefficients of the
-    // left and right MonoChains based on the current chainSettings
-    void updateLowCutFilter(const ChainSettings& chainSettings);
-
-    // [LUCAS] : This function updates the high cut filter coefficients of the
-    // left and right MonoChains based on the current chainSettings
-    void updateHighCutFilter(const ChainSettings& chainSettings);
-
-    // [LUCAS] : This template function updates the coefficients of
-    //           a CutFilter within a processing chain, based on the given slope setting
-    template<typename ChainType, typename CoefficientType>
-    void updateCutFilter(
-        ChainType& chain,
-        const CoefficientType& cutCoefficients,
-        const Slope& slope)
-    {
-        // [LUCAS] : Bypasses all filters in the CutFilter chain
-        chain.template setBypassed<0>(true);
-        chain.template setBypassed<1>(true);
-        chain.template setBypassed<2>(true);
-        chain.template setBypassed<3>(true);
-
-        // [LUCAS] : Updates and activate the filters that contribute to the desired slope
-        switch (slope)
-        {
-            case Slope_48:
-                update<3>(chain, cutCoefficients);
-            case Slope_36:
-                update<2>(chain, cutCoefficients);
-            case Slope_24:
-                update<1>(chain, cutCoefficients);
-            case Slope_12:
-                update<0>(chain, cutCoefficients);
-        }
-    }
-
-    // [LUCAS] : This helper function updates the old Coefficients
-    //           with the new updated coefficients
-    static void updateCoefficients(Coefficients& old, const Coefficients& updated);
-
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "CacheAlignedMemory.h"
+#include "ChainSettings.h"
+#include "ChainSmoother.h"
+#include "CoefficientDesigner.h"
+#include "DynamicPeak.h"
+#include "LinearPhaseEngine.h"
+#include "ParametricBands.h"
+#include "PerformanceMonitor.h"
+#include "PolyphaseOversampler.h"
+#include "SpectrumAnalyzer.h"
+
+//==============================================================================
+/**
+*/
+class SimpleEQAudioProcessor  : public juce::AudioProcessor
+                            #if JucePlugin_Enable_ARA
+                             , public juce::AudioProcessorARAExtension
+                            #endif
+{
+public:
+    //==============================================================================
+    SimpleEQAudioProcessor();
+    ~SimpleEQAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    // [LUCAS] : Double precision hosts get their buffers processed as they are,
+    //           without converting them to float and back
+    bool supportsDoublePrecisionProcessing() const override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+    // [LUCAS] : This method creates the parameters of my EQ
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+  
+    // [LUCAS] : This is the object that manages the parameters of my EQ
+    juce::AudioProcessorValueTreeState parametersManager{
+        *this,
+        nullptr,
+        "Parameters",
+        createParameterLayout()
+    };
+
+    // [LUCAS] : This method selects where the filter coefficients are designed.
+    //           It takes effect on the next call to prepareToPlay.
+    void setCoefficientUpdateMode(CoefficientUpdateMode newMode);
+    CoefficientUpdateMode getCoefficientUpdateMode() const;
+
+    // [LUCAS] : These methods set the parameter ramps of CoefficientUpdateMode::smoothed :
+    //           their length, how many samples are processed between two redesigns,
+    //           and the topology of the filters. The control interval is also the rate
+    //           at which the dynamic peak is redesigned, whatever the update mode.
+    //           They take effect on the next call to prepareToPlay.
+    void setSmoothingRampLength(double newRampLengthInSeconds);
+    void setSmoothingControlInterval(int newControlIntervalInSamples);
+    void setSmoothingTopology(FilterTopology newTopology);
+
+    double getSmoothingRampLength() const;
+    int getSmoothingControlInterval() const;
+    FilterTopology getSmoothingTopology() const;
+
+    // [LUCAS] : These methods select between the IIR filter chain and the linear phase FIR,
+    //           the length of the FIR, and the latency of its convolution
+    //           (0 for zero-latency non-uniform partitions, or the size of uniform partitions).
+    //           They take effect on the next call to prepareToPlay, which reports the latency.
+    void setPhaseMode(PhaseMode newMode);
+    void setLinearPhaseFirLength(int newFirLength);
+    void setLinearPhaseConvolutionLatency(int newLatencyInSamples);
+
+    PhaseMode getPhaseMode() const;
+    int getLinearPhaseFirLength() const;
+    int getLinearPhaseConvolutionLatency() const;
+
+    // [LUCAS] : These methods select the oversampling of the peak filter (1 for none, 2 or 4),
+    //           and the phase of its half-band filters. Only the peak runs oversampled, in the
+    //           IIR modes, so its bell keeps its shape near Nyquist, while the cuts and the bands
+    //           stay at the base rate. They take effect on the next call to prepareToPlay,
+    //           which reports the latency of the oversampling.
+    void setPeakOversamplingFactor(int newFactor);
+    void setPeakOversamplingPhase(PhaseMode newPhase);
+
+    int getPeakOversamplingFactor() const;
+    PhaseMode getPeakOversamplingPhase() const;
+
+    // [LUCAS] : This method sets how far from 0 dB the peak filter may be to be left out of the chain.
+    //           Cut filters parked at the end of their range are left out too, unless the tolerance
+    //           is negative, which keeps every filter. It takes effect on the next call to prepareToPlay.
+    void setNeutralStageTolerance(float newToleranceInDb);
+    float getNeutralStageTolerance() const;
+
+    // [LUCAS] : This method selects whether silent blocks are skipped once the filters are at rest
+    void setSilenceDetectionEnabled(bool shouldBeEnabled);
+    bool isSilenceDetectionEnabled() const;
+
+    // [LUCAS] : This method selects whether channels holding the same samples, as dual mono
+    //           material does, are filtered once and copied. It takes effect on the next
+    //           call to prepareToPlay.
+    void setDualMonoDetectionEnabled(bool shouldBeEnabled);
+    bool isDualMonoDetectionEnabled() const;
+
+    // [LUCAS] : This method selects whether prepareToPlay fills the shared cut filter cache
+    //           with every slope at the current cut frequencies
+    void setCutCoefficientCachePrewarmed(bool shouldBePrewarmed);
+    bool isCutCoefficientCachePrewarmed() const;
+
+    // [LUCAS] : These methods give the size of the state block of the DSP, and its address,
+    //           which is on a cache line. It is laid out by prepareToPlay (see dspState).
+    size_t getDspStateSizeInBytes() const;
+    const void* getDspStateData() const;
+
+    // [LUCAS] : This method gives access to the timings of processBlock
+    PerformanceMonitor& getPerformanceMonitor();
+
+    // [LUCAS] : This method gives access to the spectrum of the input and output of the EQ
+    SpectrumAnalyzer& getSpectrumAnalyzer();
+
+    // [LUCAS] : Message thread : returns the coefficients the audio is currently processed with,
+    //           or nullptr before the first call to prepareToPlay
+    const CoefficientSet* getResponseCoefficients() noexcept;
+
+private:
+
+    // [LUCAS] : This enum defines and represents the positions of
+    //           the first section of the different filter types within the FilterChain :
+    //           [0..3] LowCut [4] Peak [5..8] HighCut [9..] parametric Bands
+    enum ChainPositions
+    {
+        LowCut = 0,
+        Peak = 4,
+        HighCut = 5,
+        Bands = 9,
+        NumSections = 9 + numParametricBands
+    };
+
+    // [LUCAS] : This defines a FilterChain as a fused cascade of biquad sections :
+    //           four for the low cut filter, one for the peak filter, four for the high cut filter,
+    //           and one per parametric band, all run in the same loop.
+    //           A single FilterChain processes every channel, packed into SIMD lanes.
+    template<typename SampleType>
+    using FilterChain = BiquadCascade<SampleType, ChainPositions::NumSections>;
+
+    // [LUCAS] : Declaration of the FilterChains processing every channel of the main bus,
+    //           in single and in double precision. Both get the same coefficients,
+    //           and processBlock uses the one matching the sample type of the host.
+    FilterChain<float> floatFilterChain;
+    FilterChain<double> doubleFilterChain;
+
+    // [LUCAS] : The peak filter running oversampled, taken out of the FilterChain,
+    //           in single and in double precision like the FilterChains
+    template<typename SampleType>
+    using PeakFilter = BiquadCascade<SampleType, 1>;
+
+    template<typename SampleType>
+    struct OversampledPeak
+    {
+        PolyphaseOversampler<SampleType> oversampler;
+        PeakFilter<SampleType> filter;
+    };
+
+    OversampledPeak<float> floatOversampledPeak;
+    OversampledPeak<double> doubleOversampledPeak;
+
+    // [LUCAS] : The state block of the DSP, allocated by prepareToPlay : the coefficients, the
+    //           processing plans and the filter states of the oversampled peaks and of the
+    //           FilterChains, each one starting on a cache line, followed by the SIMD tile they
+    //           share. Processing a block only touches this block, the oversampler buffers
+    //           and the audio. With SSE or NEON, and the 8 parametric bands, a stereo instance
+    //           takes 3904 bytes of state, plus a tile of 16 bytes per frame of the largest
+    //           (oversampled) block, up to 512 frames : under 12 KiB, and 4.8 KiB at 64 samples.
+    CacheAlignedMemory dspState;
+
+    // [LUCAS] : The oversampling of the peak, and the factor it runs with since prepareToPlay
+    int peakOversamplingFactor { 1 };
+    PhaseMode peakOversamplingPhase { PhaseMode::minimumPhase };
+    int activePeakOversamplingFactor { 1 };
+
+    // [LUCAS] : The float buffer the linear phase mode converts double blocks into,
+    //           as juce::dsp::Convolution only processes floats
+    juce::AudioBuffer<float> linearPhaseBuffer;
+
+    // [LUCAS] : The settings of the chain, shared with the designer threads as a versioned snapshot
+    ChainSettingsSnapshot chainSettingsSnapshot { parametersManager };
+
+    // [LUCAS] : A sequence that is odd while setStateInformation is setting the parameters.
+    //           It is declared before the designer threads reading it, so it outlives them.
+    std::atomic<juce::uint32> stateSequence { 0 };
+
+    // [LUCAS] : Only touched by the audio thread : the state sequence of the last restored state applied,
+    //           before which the sets of the CoefficientDesigner are out of date
+    juce::uint32 appliedStateSequence { 0 };
+
+    // [LUCAS] : Cached raw parameter values, looked up once in the constructor
+    std::array<BandParameters, numParametricBands> bandParameters;
+
+    // [LUCAS] : The designs of the parametric bands of the FilterChain
+    using ChainBands = ParametricBands<numParametricBands>;
+    ChainBands chainBands;
+
+    // [LUCAS] : The settings and sample rate the current coefficients were designed for.
+    //           A sample rate of 0 means that nothing has been designed yet.
+    ChainSettings designedSettings;
+    double designedSampleRate { 0.0 };
+
+    // [LUCAS] : The coefficients designed in CoefficientUpdateMode::audioThread
+    CoefficientSet designedCoefficients;
+
+    // [LUCAS] : Where the filter coefficients are designed
+    CoefficientUpdateMode coefficientUpdateMode { CoefficientUpdateMode::audioThread };
+    CoefficientUpdateMode activeCoefficientUpdateMode { CoefficientUpdateMode::audioThread };
+
+    // [LUCAS] : The parameter ramps of CoefficientUpdateMode::smoothed
+    ChainSmoother chainSmoother;
+    double smoothingRampLength { 0.05 };
+    int smoothingControlInterval { 32 };
+    FilterTopology smoothingTopology { FilterTopology::transposedDirectForm2 };
+    int activeControlInterval { 32 };
+
+    // [LUCAS] : The dynamic mode of the peak filter, and the peak settings it starts from
+    DynamicParameters dynamicParameters;
+    DynamicPeak dynamicPeak;
+    PeakGainDesigner peakGainDesigner;
+    ChainSettings dynamicPeakSettings;
+    bool dynamicPeakActive { false };
+
+    // [LUCAS] : The linear phase mode
+    LinearPhaseEngine linearPhaseEngine { chainSettingsSnapshot, bandParameters, stateSequence };
+    PhaseMode phaseMode { PhaseMode::minimumPhase };
+    PhaseMode activePhaseMode { PhaseMode::minimumPhase };
+    int linearPhaseFirLength { 4096 };
+    int linearPhaseConvolutionLatency { 0 };
+
+    // [LUCAS] : The decay time of the active filters, reported as the tail length
+    std::atomic<int> tailLengthInSamples { 0 };
+
+    // [LUCAS] : Silence detection : the input level below which a block is silent,
+    //           and how many silent samples were received in a row
+    static constexpr double silenceThreshold = 1.0e-8;
+    std::atomic<bool> silenceDetectionEnabled { true };
+    bool dualMonoDetectionEnabled { true };
+    int numSilentSamples { 0 };
+
+    // [LUCAS] : The tolerance under which a filter is neutral, and left out of the chain
+    float neutralStageTolerance { 0.05f };
+
+    // [LUCAS] : The cut filter designs shared by every instance of the plugin
+    juce::SharedResourcePointer<CutCoefficientCache> cutCoefficientCache;
+    bool cutCoefficientCachePrewarmed { true };
+
+    // [LUCAS] : The thread designing the coefficients in CoefficientUpdateMode::backgroundThread
+    CoefficientDesigner coefficientDesigner { chainSettingsSnapshot, stateSequence };
+
+    // [LUCAS] : The timings of processBlock and of its coefficient update phase
+    PerformanceMonitor performanceMonitor;
+
+    // [LUCAS] : The spectrum analysis shown by the editor, only running while it is open
+    SpectrumAnalyzer spectrumAnalyzer;
+
+    // [LUCAS] : The coefficients of the FilterChain, handed over to the editor for its response curve
+    TripleBuffer<CoefficientSet> responseCoefficients;
+
+    // [LUCAS] : Only touched by the message thread : the newest coefficients handed over
+    CoefficientSet editorCoefficients;
+    bool hasEditorCoefficients { false };
+
+    // [LUCAS] : A state restored by setStateInformation, with the coefficients designed for it
+    struct RestoredState
+    {
+        ChainSettings settings;
+        CoefficientSet coefficients;
+        ChainBands bands;
+        double sampleRate { 0.0 };
+    };
+
+    // [LUCAS] : The restored states handed over to the audio thread
+    TripleBuffer<RestoredState> restoredStates;
+
+    // [LUCAS] : This template helper function returns the FilterChain of the given sample type
+    template<typename SampleType>
+    FilterChain<SampleType>& getFilterChain() noexcept
+    {
+        if constexpr (std::is_same<SampleType, double>::value)
+            return (doubleFilterChain);
+        else
+            return (floatFilterChain);
+    }
+
+    // [LUCAS] : This template helper function calls function with each FilterChain
+    template<typename Function>
+    void forEachFilterChain(Function&& function)
+    {
+        function(floatFilterChain);
+        function(doubleFilterChain);
+    }
+
+    // [LUCAS] : The same helpers, for the oversampled peak
+    template<typename SampleType>
+    OversampledPeak<SampleType>& getOversampledPeak() noexcept
+    {
+        if constexpr (std::is_same<SampleType, double>::value)
+            return (doubleOversampledPeak);
+        else
+            return (floatOversampledPeak);
+    }
+
+    template<typename Function>
+    void forEachOversampledPeak(Function&& function)
+    {
+        function(floatOversampledPeak);
+        function(doubleOversampledPeak);
+    }
+
+    // [LUCAS] : This function returns the rate the peak filter runs at
+    double getPeakSampleRate() const;
+
+    // [LUCAS] : This function allocates dspState, and prepares every cascade in it.
+    //           The coefficients and the bypass flags of the cascades are kept.
+    void prepareDspState(const juce::dsp::ProcessSpec& spec, const juce::dsp::ProcessSpec& oversampledSpec);
+
+    // [LUCAS] : This template helper function sets the peak filter, in the FilterChain,
+    //           or in the oversampled peak while it runs oversampled
+    template<typename CoefficientType>
+    void setPeakSection(const CoefficientType& coefficients, bool bypassed)
+    {
+        const bool oversampled = (activePeakOversamplingFactor > 1);
+
+        forEachFilterChain([&coefficients, bypassed, oversampled](auto& chain)
+        {
+            chain.setCoefficients(ChainPositions::Peak, coefficients);
+            chain.setBypassed(ChainPositions::Peak, bypassed || oversampled);
+        });
+
+        forEachOversampledPeak([&coefficients, bypassed, oversampled](auto& peak)
+        {
+            peak.filter.setCoefficients(0, coefficients);
+            peak.filter.setBypassed(0, bypassed || ! oversampled);
+        });
+    }
+
+    // [LUCAS] : This function processes a block through the oversampled peak, if any,
+    //           then through the FilterChain
+    template<typename SampleType>
+    void processFilterChain(juce::dsp::AudioBlock<SampleType>& block);
+
+    // [LUCAS] : This function holds the processing of processBlock, for both sample types
+    template<typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // [LUCAS] : This function returns true if the block can be skipped : its input is silent,
+    //           and the filters have nothing left to ring out
+    template<typename SampleType>
+    bool canSkipBlock(const juce::dsp::AudioBlock<SampleType>& block);
+
+    // [LUCAS] : This function computes the decay time of the active filters from their pole radii
+    void updateTailLength();
+
+    // [LUCAS] : This function hands the current coefficients over to the editor, without locking
+    void publishResponseCoefficients();
+
+    // [LUCAS] : This function reads the parameters into chainSettings, and returns false
+    //           if a state was being restored at the given sequence or meanwhile
+    bool readChainSettings(juce::uint32 sequence, ChainSettings& chainSettings);
+
+    // [LUCAS] : The same, for the settings of the parametric bands
+    ChainBands::Settings getBandSettings() const;
+    bool readBandSettings(juce::uint32 sequence, ChainBands::Settings& bandSettings);
+
+    // [LUCAS] : This function designs the parametric bands whose settings changed,
+    //           or every band when forced, and returns true if any was.
+    //           The bands within toleranceInDb of neutral are left out of the chain.
+    bool updateBands(const ChainBands::Settings& bandSettings, bool forceRedesign, float toleranceInDb);
+
+    // [LUCAS] : This function designs the bands from their ramped settings, and returns true if any was.
+    //           While they ramp, only the disabled bands are left out, so a gain crossing 0 dB
+    //           never resets its section. They are classified again once the ramps are done.
+    bool applySmoothedBands();
+
+    // [LUCAS] : This function copies the coefficients of a restored state into the FilterChain,
+    //           and returns false if they were not designed for the current mode and sample rate
+    bool applyRestoredState(const RestoredState& restoredState);
+
+    // [LUCAS] : This function processes a block through the linear phase convolutions
+    template<typename SampleType>
+    void processLinearPhase(juce::dsp::AudioBlock<SampleType>& block);
+
+    // [LUCAS] : This template helper function updates the coefficients of
+    //           an index-specific section of a cut filter within a processing chain
+    template<int Index, typename ChainType, typename CoefficientType>
+    void update(ChainType& chain, ChainPositions cutPosition, const CoefficientType& coefficients)
+    {
+        // [LUCAS] : Updates the coefficients of the section at the given index in the cut filter
+        chain.setCoefficients(cutPosition + Index, coefficients[Index]);
+
+        // [LUCAS] : Sets the section bypass status to false (i.e., activate the section)
+        chain.setBypassed(cutPosition + Index, false);
+    }
+
+    // [LUCAS] : This function updates the filters in the audio processing chains :
+    //           low cut filter, peak filter, and high cut filter
+    //           based on the given settings.
+    //           Only the filters whose settings (or the sample rate) changed
+    //           since the last call are redesigned.
+    //           Returns true if any filter was redesigned.
+    bool updateFilters(const ChainSettings& chainSettings);
+
+    // [LUCAS] : This function redesigns the filters whose smoothed settings changed,
+    //           in the topology of the FilterChain, and returns true if any was.
+    //           The designs are closed-form and allocation-free, so this can run
+    //           on the audio thread every few samples.
+    bool applySmoothedSettings(const ChainSettings& chainSettings, bool forceRedesign);
+
+    // [LUCAS] : This function processes a block in sub-blocks of activeControlInterval samples,
+    //           advancing the parameter ramps and redesigning the filters before each of them
+    template<typename SampleType>
+    void processSmoothed(juce::dsp::AudioBlock<SampleType>& block);
+
+    // [LUCAS] : This function processes a block in sub-blocks of activeControlInterval samples,
+    //           measuring the level of each of them and redesigning the peak filter with the
+    //           gain reduction of the dynamic peak. The ramps advance too, if any.
+    template<typename SampleType>
+    void processDynamic(juce::dsp::AudioBlock<SampleType>& block, bool smoothing);
+
+    // [LUCAS] : This function sets the peak filter of the FilterChain to the given gain,
+    //           with the frequency and the Q of peakSettings
+    void applyDynamicPeak(const ChainSettings& peakSettings, float gainInDb);
+
+    // [LUCAS] : This function updates the peak filter coefficients of the
+    //           FilterChain based on the current chainSettings
+    void updatePeakFilter(const ChainSettings& chainSettings);
+
+    // [LUCAS] : This function updates the low cut filter coefficients of the
+    // FilterChain based on the current chainSettings
+    void updateLowCutFilter(const ChainSettings& chainSettings);
+
+    // [LUCAS] : This function updates the high cut filter coefficients of the
+    // FilterChain based on the current chainSettings
+    void updateHighCutFilter(const ChainSettings& chainSettings);
+
+    // [LUCAS] : This template function updates the coefficients of
+    //           a cut filter within a processing chain, based on the given slope setting.
+    //           The bypassed sections are left out of the chain processing plan,
+    //           so the slope is decided here and not for every sample.
+    //           A neutral cut filter leaves all of its sections bypassed.
+    template<typename ChainType, typename CoefficientType>
+    void updateCutFilter(
+        ChainType& chain,
+        ChainPositions cutPosition,
+        const CoefficientType& cutCoefficients,
+        const Slope& slope,
+        bool neutral)
+    {
+        // [LUCAS] : Bypasses all sections of the cut filter
+        chain.setBypassed(cutPosition + 0, true);
+        chain.setBypassed(cutPosition + 1, true);
+        chain.setBypassed(cutPosition + 2, true);
+        chain.setBypassed(cutPosition + 3, true);
+
+        if (neutral)
+            return;
+
+        // [LUCAS] : Updates and activate the sections that contribute to the desired slope
+        switch (slope)
+        {
+            case Slope_48:
+                update<3>(chain, cutPosition, cutCoefficients);
+            case Slope_36:
+                update<2>(chain, cutPosition, cutCoefficients);
+            case Slope_24:
+                update<1>(chain, cutPosition, cutCoefficients);
+            case Slope_12:
+                update<0>(chain, cutPosition, cutCoefficients);
+        }
+    }
+
+    // [LUCAS] : These functions copy the designed coefficients of one filter into the FilterChain.
+    //           Only plain floats are copied, so they are safe to call from the audio thread.
+    void applyPeakCoefficients(const CoefficientSet& coefficientSet);
+    void applyLowCutCoefficients(const CoefficientSet& coefficientSet);
+    void applyHighCutCoefficients(const CoefficientSet& coefficientSet);
+
+    // [LUCAS] : This function copies a finished CoefficientSet into the FilterChain
+    void applyCoefficientSet(const CoefficientSet& coefficientSet);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessor)
+};
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    This file contains how the parameters of the EQ are saved into
+    and restored from the state of a session.
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+#include "ParametricBands.h"
+
+namespace PluginState
+{
+    static constexpr size_t headerSize = 8;
+
+    const juce::StringArray& getParameterIds()
+    {
+        static const juce::StringArray parameterIds = []
+        {
+            juce::StringArray ids { "LowCut Freq", "HighCut Freq", "Peak Freq", "Peak Gain",
+                                    "Peak Quality", "LowCut Slope", "HighCut Slope" };
+
+            for (int band = 1; band <= numParametricBands; ++band)
+                for (const auto* name : { "Enabled", "Type", "Freq", "Gain", "Quality" })
+                    ids.add(getBandParameterId(band, name));
+
+            ids.addArray({ "Dynamic Enabled", "Dynamic Threshold", "Dynamic Ratio", "Dynamic Attack", "Dynamic Release" });
+
+            return (ids);
+        }();
+
+        return (parameterIds);
+    }
+
+    void write(juce::AudioProcessorValueTreeState& parametersManager, juce::MemoryBlock& destData)
+    {
+        const auto& parameterIds = getParameterIds();
+
+        destData.reset();
+        destData.ensureSize(headerSize + (size_t) parameterIds.size() * sizeof(float));
+
+        // [LUCAS] : The streams write in little endian whatever the platform is
+        juce::MemoryOutputStream stream(destData, false);
+
+        stream.writeInt((int) magic);
+        stream.writeShort((short) currentVersion);
+        stream.writeShort((short) parameterIds.size());
+
+        for (const auto& parameterId : parameterIds)
+            stream.writeFloat(parametersManager.getRawParameterValue(parameterId)->load());
+    }
+
+    static bool readBinary(juce::AudioProcessorValueTreeState& parametersManager, const void* data, size_t sizeInBytes)
+    {
+        juce::MemoryInputStream stream(data, sizeInBytes, false);
+
+        if (sizeInBytes < headerSize || (juce::uint32) stream.readInt() != magic)
+            return (false);
+
+        // [LUCAS] : Every version so far has the same layout, a newer one may only append values
+        stream.readShort();
+
+        const auto numValues = juce::jmin((size_t) (juce::uint16) stream.readShort(),
+                                          (sizeInBytes - headerSize) / sizeof(float));
+
+        const auto& parameterIds = getParameterIds();
+
+        for (int i = 0; i < parameterIds.size(); ++i)
+        {
+            auto* parameter = parametersManager.getParameter(parameterIds[i]);
+            const auto value = ((size_t) i < numValues ? stream.readFloat() : 0.0f);
+
+            if (parameter == nullptr)
+                continue;
+
+            parameter->setValueNotifyingHost((size_t) i < numValues ? parameter->convertTo0to1(value)
+                                                           : parameter->getDefaultValue());
+        }
+
+        return (true);
+    }
+
+    static bool readXml(juce::AudioProcessorValueTreeState& parametersManager, const void* data, int sizeInBytes)
+    {
+        const auto xml = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes);
+
+        if (xml == nullptr || ! xml->hasTagName(parametersManager.state.getType()))
+            return (false);
+
+        parametersManager.replaceState(juce::ValueTree::fromXml(*xml));
+        return (true);
+    }
+
+    bool read(juce::AudioProcessorValueTreeState& parametersManager, const void* data, int sizeInBytes)
+    {
+        if (data == nullptr || sizeInBytes <= 0)
+            return (false);
+
+        return (readBinary(parametersManager, data, (size_t) sizeInBytes)
+                || readXml(parametersManager, data, sizeInBytes));
+    }
+}
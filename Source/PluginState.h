@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+    This file contains how the parameters of the EQ are saved into
+    and restored from the state of a session.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// [LUCAS] : The state is a compact binary block :
+//               [magic : 4 bytes] [version : 2 bytes] [count : 2 bytes] [value : 4 bytes] * count
+//           all little endian, with the parameter values in the order of parameterIds.
+//           A state without the magic is read as the XML JUCE's copyXmlToBinary writes,
+//           which is what parametersManager.copyState() based plugins store.
+namespace PluginState
+{
+    constexpr juce::uint32 magic = 0x51455153; // [LUCAS] : "SQEQ"
+    constexpr juce::uint16 currentVersion = 1;
+
+    // [LUCAS] : The parameters in the order they are stored : the cut and peak filters,
+    //           the parametric bands, then the dynamic peak. New parameters go at the end,
+    //           so that older states simply leave them at their default value.
+    const juce::StringArray& getParameterIds();
+
+    // [LUCAS] : Writes the current parameter values into destData
+    void write(juce::AudioProcessorValueTreeState& parametersManager, juce::MemoryBlock& destData);
+
+    // [LUCAS] : Sets the parameters from a binary or XML state, and returns false if it was neither.
+    //           Parameters the state does not hold are set to their default value.
+    bool read(juce::AudioProcessorValueTreeState& parametersManager, const void* data, int sizeInBytes);
+}
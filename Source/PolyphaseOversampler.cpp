@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    This file contains the polyphase half-band oversampler the peak filter
+    can run in, so its bilinear design no longer cramps near Nyquist.
+
+  ==============================================================================
+*/
+
+#include "PolyphaseOversampler.h"
+
+// [LUCAS] : The modified Bessel function of order 0, for the Kaiser window
+static double besselI0(double x) noexcept
+{
+    double term = 1.0, sum = 1.0;
+
+    for (int k = 1; k < 64 && term > sum * 1.0e-17; ++k)
+    {
+        term *= (x * x) / (4.0 * (double) k * (double) k);
+        sum += term;
+    }
+
+    return (sum);
+}
+
+void designLinearPhaseHalfBand(std::vector<double>& taps, int numPairs, double attenuationInDb)
+{
+    jassert(numPairs > 0);
+
+    // [LUCAS] : The beta of Kaiser's formula for the given stop band attenuation
+    const auto beta = (attenuationInDb > 50.0 ? 0.1102 * (attenuationInDb - 8.7)
+                                              : 0.5842 * std::pow(juce::jmax(0.0, attenuationInDb - 21.0), 0.4)
+                                                  + 0.07886 * (attenuationInDb - 21.0));
+
+    const auto halfLength = (double) (2 * numPairs - 1);
+    double sum = 0.0;
+
+    taps.resize((size_t) (2 * numPairs));
+
+    // [LUCAS] : The tap i of the even phase is the tap 2i of the FIR, an odd distance d from its centre,
+    //           where the half-band sinc is sin(pi d / 2) / (pi d) = +-1 / (pi d)
+    for (int i = 0; i < 2 * numPairs; ++i)
+    {
+        const auto distance = (double) (2 * i) - halfLength;
+        const auto ratio = distance / halfLength;
+        const auto window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - ratio * ratio))) / besselI0(beta);
+        const auto sign = ((((int) std::abs(distance) - 1) / 2) % 2 == 0 ? 1.0 : -1.0);
+
+        taps[(size_t) i] = sign * window / (juce::MathConstants<double>::pi * std::abs(distance));
+        sum += taps[(size_t) i];
+    }
+
+    // [LUCAS] : Normalised to a gain of exactly 1 at DC, once both phases are added
+    for (auto& tap : taps)
+        tap *= 0.5 / sum;
+}
+
+//==============================================================================
+// [LUCAS] : The series of the elliptic design, summed until their terms vanish
+static double getNumeratorSum(double q, int order, int c) noexcept
+{
+    double sum = 0.0, term = 0.0;
+    int i = 0;
+    double sign = 1.0;
+
+    do
+    {
+        term = std::pow(q, (double) (i * (i + 1))) * std::sin((double) ((2 * i + 1) * c) * juce::MathConstants<double>::pi / (double) order) * sign;
+        sum += term;
+        sign = -sign;
+        ++i;
+    }
+    while (std::abs(term) > 1.0e-100 && i < 1000);
+
+    return (sum);
+}
+
+static double getDenominatorSum(double q, int order, int c) noexcept
+{
+    double sum = 0.0, term = 0.0;
+    int i = 1;
+    double sign = -1.0;
+
+    do
+    {
+        term = std::pow(q, (double) (i * i)) * std::cos((double) (2 * i * c) * juce::MathConstants<double>::pi / (double) order) * sign;
+        sum += term;
+        sign = -sign;
+        ++i;
+    }
+    while (std::abs(term) > 1.0e-100 && i < 1000);
+
+    return (sum);
+}
+
+void designMinimumPhaseHalfBand(std::vector<double>& coefficients, int numCoefficients, double transitionWidth)
+{
+    jassert(numCoefficients > 0 && transitionWidth > 0.0 && transitionWidth < 0.5);
+
+    // [LUCAS] : The selectivity k of the elliptic filter, and its nome q
+    auto k = std::tan((1.0 - transitionWidth * 2.0) * juce::MathConstants<double>::pi / 4.0);
+    k *= k;
+
+    const auto kk = std::pow(1.0 - k * k, 0.25);
+    const auto e = 0.5 * (1.0 - kk) / (1.0 + kk);
+    const auto e4 = e * e * e * e;
+    const auto q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+    const auto order = numCoefficients * 2 + 1;
+
+    coefficients.resize((size_t) numCoefficients);
+
+    for (int index = 0; index < numCoefficients; ++index)
+    {
+        const auto c = index + 1;
+        const auto numerator = getNumeratorSum(q, order, c) * std::pow(q, 0.25);
+        const auto denominator = getDenominatorSum(q, order, c) + 0.5;
+        const auto ww = numerator / denominator;
+        const auto wwSquared = ww * ww;
+        const auto x = std::sqrt((1.0 - wwSquared * k) * (1.0 - wwSquared / k)) / (1.0 + wwSquared);
+
+        coefficients[(size_t) index] = (1.0 - x) / (1.0 + x);
+    }
+}
@@ -0,0 +1,410 @@
+/*
+  ==============================================================================
+
+    This file contains the polyphase half-band oversampler the peak filter
+    can run in, so its bilinear design no longer cramps near Nyquist.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LinearPhaseEngine.h"
+
+// [LUCAS] : This function writes the 2 * numPairs non-zero taps of the even phase of a
+//           linear phase half-band FIR, windowed with a Kaiser window. The odd phase
+//           is a single 0.5 tap, so the whole FIR has 4 * numPairs - 1 taps.
+//           The taps sum to 0.5, like the odd phase.
+void designLinearPhaseHalfBand(std::vector<double>& taps, int numPairs, double attenuationInDb);
+
+// [LUCAS] : This function writes the coefficients of a minimum phase half-band filter,
+//           made of two branches of first order allpass sections in z^-2, as designed
+//           by the elliptic method of Valenzuela and Constantinides. The transition
+//           width is relative to the oversampled rate, and the coefficients alternate
+//           between the two branches.
+void designMinimumPhaseHalfBand(std::vector<double>& coefficients, int numCoefficients, double transitionWidth);
+
+//==============================================================================
+// [LUCAS] : This class oversamples a block by 2 or 4, in stages of 2, with the same
+//           processSamplesUp / processSamplesDown pair as juce::dsp::Oversampling.
+//
+//           Each stage is a half-band filter split into its two polyphase branches,
+//           so it runs at the lower of its two rates and never multiplies the zeros
+//           of the zero stuffing, nor computes the samples the decimation drops.
+//             - The linear phase FIR accumulates its even branch one tap at a time
+//               over the whole block, with the vectorised FloatVectorOperations,
+//               while its odd branch is a plain delay.
+//             - The minimum phase IIR runs a few first order allpass sections per
+//               branch and per sample, which is cheaper still, and nearly
+//               latency-free, but turns the phase near the top of the band.
+//           The second stage of 4x only has to reject the images of a signal
+//           that the first stage has already band limited, so it is much shorter.
+//
+//           Every buffer is allocated by prepare, and processing never allocates.
+template<typename SampleType>
+class PolyphaseOversampler
+{
+public:
+    static constexpr int maxFactor = 4;
+
+    // [LUCAS] : Allocates the stages of factor (1, 2 or 4), for blocks of up to maxBlockSize samples.
+    //           A factor of 1 leaves the samples at the base rate, untouched.
+    void prepare(int numChannels, int maxBlockSize, int newFactor, PhaseMode newFilterPhase)
+    {
+        jassert(newFactor == 1 || newFactor == 2 || newFactor == 4);
+
+        factor = newFactor;
+        filterPhase = newFilterPhase;
+        stages.clear();
+
+        int stageInputSize = maxBlockSize;
+
+        for (int stageFactor = 2; stageFactor <= factor; stageFactor *= 2)
+        {
+            stages.emplace_back();
+            stages.back().prepare(numChannels, stageInputSize, filterPhase, stageFactor == 2);
+            stageInputSize *= 2;
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& stage : stages)
+            stage.reset();
+    }
+
+    int getFactor() const noexcept
+    {
+        return (factor);
+    }
+
+    PhaseMode getFilterPhase() const noexcept
+    {
+        return (filterPhase);
+    }
+
+    // [LUCAS] : The delay of the up and down sampling, in samples at the base rate.
+    //           The minimum phase delay is the group delay at low frequencies.
+    double getLatencyInSamples() const noexcept
+    {
+        double latency = 0.0;
+        double stageRate = 1.0;
+
+        for (const auto& stage : stages)
+        {
+            latency += stage.getLatencyInSamples() / stageRate;
+            stageRate *= 2.0;
+        }
+
+        return (latency);
+    }
+
+    // [LUCAS] : Returns true if every filter state is below threshold,
+    //           which means that the oversampler outputs silence for a silent input
+    bool isStateSilent(SampleType threshold) const noexcept
+    {
+        return (std::all_of(stages.begin(), stages.end(), [threshold](const Stage& stage) { return (stage.isStateSilent(threshold)); }));
+    }
+
+    // [LUCAS] : Upsamples block, and returns the oversampled block, which is processed in place
+    //           before processSamplesDown. The block may have fewer channels than prepared for.
+    juce::dsp::AudioBlock<SampleType> processSamplesUp(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        auto input = block;
+
+        for (auto& stage : stages)
+            input = stage.upsample(input);
+
+        return (input);
+    }
+
+    // [LUCAS] : Downsamples the oversampled block into block
+    void processSamplesDown(juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        const auto numChannels = block.getNumChannels();
+        auto numSamples = block.getNumSamples() * (size_t) factor;
+
+        for (size_t i = stages.size(); i-- > 0;)
+        {
+            numSamples /= 2;
+
+            auto output = (i == 0 ? block
+                                  : stages[i - 1].getOutput(numChannels, numSamples));
+
+            stages[i].downsample(stages[i].getOutput(numChannels, numSamples * 2), output);
+        }
+    }
+
+private:
+    //==============================================================================
+    // [LUCAS] : One stage of 2x, upsampling into its output buffer,
+    //           and downsampling from it once it has been processed
+    class Stage
+    {
+    public:
+        // [LUCAS] : The first stage has the band of the base rate to keep,
+        //           the next one only a band already limited to half of its input rate
+        static constexpr int firstStagePairs = 18, nextStagePairs = 6;
+        static constexpr double firAttenuationInDb = 90.0;
+
+        static constexpr int firstStageCoefficients = 8, nextStageCoefficients = 3;
+        static constexpr double firstStageTransition = 0.04, nextStageTransition = 0.125;
+
+        void prepare(int numChannels, int maxInputSize, PhaseMode phase, bool firstStage)
+        {
+            linearPhase = (phase == PhaseMode::linearPhase);
+
+            std::vector<double> designed;
+
+            if (linearPhase)
+            {
+                numPairs = (firstStage ? firstStagePairs : nextStagePairs);
+                designLinearPhaseHalfBand(designed, numPairs, firAttenuationInDb);
+
+                const auto historySize = 2 * numPairs - 1;
+
+                upHistory.setSize(numChannels, historySize + maxInputSize);
+                downEvenHistory.setSize(numChannels, historySize + maxInputSize);
+                downOddHistory.setSize(numChannels, numPairs + maxInputSize);
+                scratch.setSize(1, maxInputSize);
+            }
+            else
+            {
+                designMinimumPhaseHalfBand(designed, firstStage ? firstStageCoefficients : nextStageCoefficients,
+                                           firstStage ? firstStageTransition : nextStageTransition);
+
+                allpassStates.assign((size_t) (numChannels * numStateArrays) * designed.size(), SampleType(0));
+            }
+
+            coefficients.assign(designed.begin(), designed.end());
+            output.setSize(numChannels, 2 * maxInputSize);
+        }
+
+        void reset() noexcept
+        {
+            upHistory.clear();
+            downEvenHistory.clear();
+            downOddHistory.clear();
+            std::fill(allpassStates.begin(), allpassStates.end(), SampleType(0));
+        }
+
+        // [LUCAS] : The delay of the up and down sampling, in samples at the input rate of the stage
+        double getLatencyInSamples() const noexcept
+        {
+            if (linearPhase)
+                return ((double) (2 * numPairs - 1));
+
+            // [LUCAS] : A first order allpass (a + z^-1) / (1 + a z^-1) delays the low frequencies
+            //           by (1 - a) / (1 + a) samples, at the input rate of the stage. Going up then
+            //           down averages the two branches twice, so the delays of every section add up :
+            //           the odd branch is one sample late at the oversampled rate, and the downsampler
+            //           takes it back by pairing each odd sample with the even one before it.
+            double delay = 0.0;
+
+            for (auto coefficient : coefficients)
+                delay += (1.0 - (double) coefficient) / (1.0 + (double) coefficient);
+
+            return (delay);
+        }
+
+        bool isStateSilent(SampleType threshold) const noexcept
+        {
+            const auto silent = [threshold](const juce::AudioBuffer<SampleType>& buffer, int historySize)
+            {
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                {
+                    const auto range = juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(channel), historySize);
+
+                    if (juce::jmax(-range.getStart(), range.getEnd()) > threshold)
+                        return (false);
+                }
+
+                return (true);
+            };
+
+            if (linearPhase)
+                return (silent(upHistory, 2 * numPairs - 1)
+                        && silent(downEvenHistory, 2 * numPairs - 1)
+                        && silent(downOddHistory, numPairs));
+
+            return (std::all_of(allpassStates.begin(), allpassStates.end(),
+                                [threshold](SampleType state) { return (std::abs(state) <= threshold); }));
+        }
+
+        juce::dsp::AudioBlock<SampleType> getOutput(size_t numChannels, size_t numSamples) noexcept
+        {
+            return (juce::dsp::AudioBlock<SampleType>(output).getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples));
+        }
+
+        juce::dsp::AudioBlock<SampleType> upsample(const juce::dsp::AudioBlock<SampleType>& input) noexcept
+        {
+            const auto numSamples = (int) input.getNumSamples();
+
+            jassert(numSamples * 2 <= output.getNumSamples());
+
+            for (size_t channel = 0; channel < input.getNumChannels(); ++channel)
+            {
+                if (linearPhase)
+                    upsampleLinearPhase(input.getChannelPointer(channel), output.getWritePointer((int) channel), numSamples, (int) channel);
+                else
+                    upsampleMinimumPhase(input.getChannelPointer(channel), output.getWritePointer((int) channel), numSamples, (int) channel);
+            }
+
+            return (getOutput(input.getNumChannels(), (size_t) numSamples * 2));
+        }
+
+        void downsample(const juce::dsp::AudioBlock<SampleType>& input, juce::dsp::AudioBlock<SampleType>& destination) noexcept
+        {
+            const auto numSamples = (int) destination.getNumSamples();
+
+            for (size_t channel = 0; channel < destination.getNumChannels(); ++channel)
+            {
+                if (linearPhase)
+                    downsampleLinearPhase(input.getChannelPointer(channel), destination.getChannelPointer(channel), numSamples, (int) channel);
+                else
+                    downsampleMinimumPhase(input.getChannelPointer(channel), destination.getChannelPointer(channel), numSamples, (int) channel);
+            }
+        }
+
+    private:
+        // [LUCAS] : The input and output of every allpass section, for the upsampling and the downsampling
+        static constexpr int numStateArrays = 4;
+
+        // [LUCAS] : The even outputs are the even branch, 2 * sum(taps[i] * x[n - i]),
+        //           and the odd outputs are the input delayed by numPairs - 1 samples.
+        //           The history keeps the last 2 * numPairs - 1 input samples in front of the block.
+        void upsampleLinearPhase(const SampleType* input, SampleType* destination, int numSamples, int channel) noexcept
+        {
+            const auto historySize = 2 * numPairs - 1;
+            auto* history = upHistory.getWritePointer(channel);
+            auto* evenBranch = scratch.getWritePointer(0);
+
+            juce::FloatVectorOperations::copy(history + historySize, input, numSamples);
+            juce::FloatVectorOperations::clear(evenBranch, numSamples);
+
+            for (int i = 0; i < 2 * numPairs; ++i)
+                juce::FloatVectorOperations::addWithMultiply(evenBranch, history + historySize - i, SampleType(2) * coefficients[(size_t) i], numSamples);
+
+            const auto* oddBranch = history + historySize - (numPairs - 1);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                destination[2 * i] = evenBranch[i];
+                destination[2 * i + 1] = oddBranch[i];
+            }
+
+            std::memmove(history, history + numSamples, (size_t) historySize * sizeof(SampleType));
+        }
+
+        // [LUCAS] : The output is sum(taps[i] * even[n - i]) + 0.5 * odd[n - numPairs],
+        //           with the even and odd input samples split into their own histories
+        void downsampleLinearPhase(const SampleType* input, SampleType* destination, int numSamples, int channel) noexcept
+        {
+            const auto evenHistorySize = 2 * numPairs - 1;
+            auto* even = downEvenHistory.getWritePointer(channel);
+            auto* odd = downOddHistory.getWritePointer(channel);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                even[evenHistorySize + i] = input[2 * i];
+                odd[numPairs + i] = input[2 * i + 1];
+            }
+
+            juce::FloatVectorOperations::multiply(destination, odd, SampleType(0.5), numSamples);
+
+            for (int i = 0; i < 2 * numPairs; ++i)
+                juce::FloatVectorOperations::addWithMultiply(destination, even + evenHistorySize - i, coefficients[(size_t) i], numSamples);
+
+            std::memmove(even, even + numSamples, (size_t) evenHistorySize * sizeof(SampleType));
+            std::memmove(odd, odd + numSamples, (size_t) numPairs * sizeof(SampleType));
+        }
+
+        // [LUCAS] : Runs one sample of each branch through its allpass sections.
+        //           Each section computes y[n] = a (x[n] - y[n - 1]) + x[n - 1].
+        static void processBranches(SampleType& even, SampleType& odd, const SampleType* a,
+                                    SampleType* x, SampleType* y, size_t numCoefficients) noexcept
+        {
+            size_t i = 0;
+
+            for (; i + 1 < numCoefficients; i += 2)
+            {
+                const auto evenOutput = (even - y[i]) * a[i] + x[i];
+                const auto oddOutput = (odd - y[i + 1]) * a[i + 1] + x[i + 1];
+
+                x[i] = even;
+                x[i + 1] = odd;
+                y[i] = evenOutput;
+                y[i + 1] = oddOutput;
+                even = evenOutput;
+                odd = oddOutput;
+            }
+
+            if (i < numCoefficients)
+            {
+                const auto evenOutput = (even - y[i]) * a[i] + x[i];
+
+                x[i] = even;
+                y[i] = evenOutput;
+                even = evenOutput;
+            }
+        }
+
+        SampleType* getAllpassStates(int channel, int stateArray) noexcept
+        {
+            return (allpassStates.data() + (size_t) (channel * numStateArrays + stateArray) * coefficients.size());
+        }
+
+        // [LUCAS] : Both branches filter the same input, and give the even and odd outputs
+        void upsampleMinimumPhase(const SampleType* input, SampleType* destination, int numSamples, int channel) noexcept
+        {
+            auto* x = getAllpassStates(channel, 0);
+            auto* y = getAllpassStates(channel, 1);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto even = input[i];
+                auto odd = input[i];
+
+                processBranches(even, odd, coefficients.data(), x, y, coefficients.size());
+
+                destination[2 * i] = even;
+                destination[2 * i + 1] = odd;
+            }
+        }
+
+        // [LUCAS] : The even branch filters the odd input samples and the odd branch the even ones,
+        //           and the output is their average
+        void downsampleMinimumPhase(const SampleType* input, SampleType* destination, int numSamples, int channel) noexcept
+        {
+            auto* x = getAllpassStates(channel, 2);
+            auto* y = getAllpassStates(channel, 3);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto even = input[2 * i + 1];
+                auto odd = input[2 * i];
+
+                processBranches(even, odd, coefficients.data(), x, y, coefficients.size());
+
+                destination[i] = SampleType(0.5) * (even + odd);
+            }
+        }
+
+        bool linearPhase { true };
+        int numPairs { 0 };
+
+        std::vector<SampleType> coefficients;
+
+        juce::AudioBuffer<SampleType> upHistory, downEvenHistory, downOddHistory, scratch;
+        std::vector<SampleType> allpassStates;
+
+        juce::AudioBuffer<SampleType> output;
+    };
+
+    std::vector<Stage> stages;
+    int factor { 1 };
+    PhaseMode filterPhase { PhaseMode::minimumPhase };
+};
@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    This file contains the real-time safety audit : a build mode that reports
+    every allocation and every lock taken on the audio thread.
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafety.h"
+
+#if SIMPLEEQ_REALTIME_AUDIT
+ #include <new>
+
+ #if JUCE_LINUX && defined(__GLIBC__)
+  #include <dlfcn.h>
+  #include <pthread.h>
+  #define SIMPLEEQ_INTERCEPT_LIBC 1
+ #else
+  #define SIMPLEEQ_INTERCEPT_LIBC 0
+ #endif
+#endif
+
+namespace RealtimeSafety
+{
+    static std::array<std::atomic<int>, NumViolationTypes> violationCounts {};
+    static std::atomic<int> numLoggedViolations { 0 };
+
+    int getNumViolations(ViolationType type) noexcept
+    {
+        return (violationCounts[(size_t) type].load());
+    }
+
+    int getTotalNumViolations() noexcept
+    {
+        int total = 0;
+
+        for (const auto& count : violationCounts)
+            total += count.load();
+
+        return (total);
+    }
+
+    void resetViolations() noexcept
+    {
+        for (auto& count : violationCounts)
+            count.store(0);
+
+        numLoggedViolations.store(0);
+    }
+
+    const char* getViolationName(ViolationType type) noexcept
+    {
+        switch (type)
+        {
+            case Violation_Allocation:   return ("allocation");
+            case Violation_Deallocation: return ("deallocation");
+            case Violation_Lock:         return ("lock");
+            case NumViolationTypes:
+            default:                     return ("unknown");
+        }
+    }
+
+   #if SIMPLEEQ_REALTIME_AUDIT
+    // [LUCAS] : Plain thread locals with constant initialisers, so that reading them
+    //           from inside malloc never allocates
+    static thread_local int audioThreadDepth = 0;
+    static thread_local bool isReporting = false;
+
+    // [LUCAS] : Called by every interceptor, before it forwards the call.
+    //           The report itself allocates and locks, so it is never reported.
+    static void checkViolation(ViolationType type) noexcept
+    {
+        if (audioThreadDepth == 0 || isReporting)
+            return;
+
+        isReporting = true;
+
+        violationCounts[(size_t) type].fetch_add(1);
+
+        if (numLoggedViolations.fetch_add(1) < maxLoggedViolations)
+            juce::Logger::writeToLog(juce::String("Real-time violation on the audio thread : ")
+                                     + getViolationName(type) + "\n"
+                                     + juce::SystemStats::getStackBacktrace());
+
+        isReporting = false;
+    }
+
+    ScopedAudioThread::ScopedAudioThread() noexcept
+    {
+        ++audioThreadDepth;
+    }
+
+    ScopedAudioThread::~ScopedAudioThread() noexcept
+    {
+        --audioThreadDepth;
+    }
+   #endif
+}
+
+#if SIMPLEEQ_REALTIME_AUDIT
+//==============================================================================
+// [LUCAS] : The allocator the interceptors forward to. On glibc, these are the
+//           functions behind malloc and free, so an operator new is not reported
+//           a second time by the malloc interceptor.
+#if SIMPLEEQ_INTERCEPT_LIBC
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* pointer);
+}
+
+static void* allocateRaw(size_t size) noexcept                             { return (__libc_malloc(size)); }
+static void* allocateAlignedRaw(size_t size, size_t alignment) noexcept    { return (__libc_memalign(alignment, size)); }
+static void freeRaw(void* pointer) noexcept                               { __libc_free(pointer); }
+#else
+static void* allocateRaw(size_t size) noexcept                             { return (std::malloc(size)); }
+static void freeRaw(void* pointer) noexcept                               { std::free(pointer); }
+#endif
+
+static void* allocate(size_t size) noexcept
+{
+    RealtimeSafety::checkViolation(RealtimeSafety::Violation_Allocation);
+    return (allocateRaw(size == 0 ? 1 : size));
+}
+
+static void deallocate(void* pointer) noexcept
+{
+    if (pointer != nullptr)
+        RealtimeSafety::checkViolation(RealtimeSafety::Violation_Deallocation);
+
+    freeRaw(pointer);
+}
+
+//==============================================================================
+// [LUCAS] : The replaceable forms of operator new and delete
+void* operator new(std::size_t size)
+{
+    if (auto* pointer = allocate(size))
+        return (pointer);
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return (operator new(size));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept    { return (allocate(size)); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept  { return (allocate(size)); }
+
+void operator delete(void* pointer) noexcept                            { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept                          { deallocate(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept               { deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept             { deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept     { deallocate(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept   { deallocate(pointer); }
+
+#if SIMPLEEQ_INTERCEPT_LIBC
+static void* allocateAligned(size_t size, std::align_val_t alignment) noexcept
+{
+    RealtimeSafety::checkViolation(RealtimeSafety::Violation_Allocation);
+    return (allocateAlignedRaw(size == 0 ? 1 : size, (size_t) alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto* pointer = allocateAligned(size, alignment))
+        return (pointer);
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return (operator new(size, alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept    { return (allocateAligned(size, alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept  { return (allocateAligned(size, alignment)); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept                          { deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept                        { deallocate(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept             { deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept           { deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept   { deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(pointer); }
+
+//==============================================================================
+// [LUCAS] : The C allocator, which juce::HeapBlock and most C libraries use,
+//           and the mutexes behind std::mutex and juce::CriticalSection.
+//           Try-locks never block, so pthread_mutex_trylock is left alone.
+extern "C"
+{
+    void* malloc(size_t size) noexcept
+    {
+        RealtimeSafety::checkViolation(RealtimeSafety::Violation_Allocation);
+        return (__libc_malloc(size));
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        RealtimeSafety::checkViolation(RealtimeSafety::Violation_Allocation);
+        return (__libc_calloc(count, size));
+    }
+
+    void* realloc(void* pointer, size_t size) noexcept
+    {
+        RealtimeSafety::checkViolation(RealtimeSafety::Violation_Allocation);
+        return (__libc_realloc(pointer, size));
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        RealtimeSafety::checkViolation(RealtimeSafety::Violation_Allocation);
+        return (__libc_memalign(alignment, size));
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        return (memalign(alignment, size));
+    }
+
+    int posix_memalign(void** pointer, size_t alignment, size_t size) noexcept
+    {
+        *pointer = memalign(alignment, size);
+        return (*pointer != nullptr ? 0 : ENOMEM);
+    }
+
+    void free(void* pointer) noexcept
+    {
+        if (pointer != nullptr)
+            RealtimeSafety::checkViolation(RealtimeSafety::Violation_Deallocation);
+
+        __libc_free(pointer);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        using MutexLock = int (*)(pthread_mutex_t*);
+
+        // [LUCAS] : Constant initialised, so no static guard is involved, as one may itself take a lock
+        static std::atomic<MutexLock> nextMutexLock { nullptr };
+
+        auto mutexLock = nextMutexLock.load(std::memory_order_relaxed);
+
+        if (mutexLock == nullptr)
+        {
+            mutexLock = reinterpret_cast<MutexLock>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+            nextMutexLock.store(mutexLock, std::memory_order_relaxed);
+        }
+
+        RealtimeSafety::checkViolation(RealtimeSafety::Violation_Lock);
+        return (mutexLock(mutex));
+    }
+}
+#endif
+#endif
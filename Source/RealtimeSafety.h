@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    This file contains the real-time safety audit : a build mode that reports
+    every allocation and every lock taken on the audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// [LUCAS] : The audit is compiled in with SIMPLEEQ_REALTIME_AUDIT=1, which the
+//           SimpleEQRealtimeTests target and the SIMPLEEQ_REALTIME_AUDIT CMake option set.
+//           Without it, ScopedAudioThread is an empty object and nothing is intercepted.
+#ifndef SIMPLEEQ_REALTIME_AUDIT
+ #define SIMPLEEQ_REALTIME_AUDIT 0
+#endif
+
+//==============================================================================
+// [LUCAS] : In an audit build, malloc, calloc, realloc, free, every form of
+//           operator new and delete, and pthread_mutex_lock are intercepted.
+//           A call made while the current thread is marked as an audio thread
+//           is a violation : it is counted, and the first ones are logged with
+//           a backtrace. The malloc family and the locks are only intercepted
+//           on Linux, other platforms only catch operator new and delete.
+namespace RealtimeSafety
+{
+    enum ViolationType
+    {
+        Violation_Allocation,
+        Violation_Deallocation,
+        Violation_Lock,
+        NumViolationTypes
+    };
+
+    // [LUCAS] : Only this many violations are logged, the next ones are only counted
+    constexpr int maxLoggedViolations = 16;
+
+    constexpr bool isAuditEnabled() noexcept
+    {
+        return (SIMPLEEQ_REALTIME_AUDIT != 0);
+    }
+
+    int getNumViolations(ViolationType type) noexcept;
+    int getTotalNumViolations() noexcept;
+    void resetViolations() noexcept;
+
+    const char* getViolationName(ViolationType type) noexcept;
+
+   #if SIMPLEEQ_REALTIME_AUDIT
+    // [LUCAS] : Marks the current thread as an audio thread, for the lifetime of the object.
+    //           The scopes nest.
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread() noexcept;
+        ~ScopedAudioThread() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioThread)
+    };
+   #else
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread() noexcept {}
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioThread)
+    };
+   #endif
+}
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    This file contains the magnitude response curve of the EQ drawn by the
+    editor, evaluated over a cached frequency grid.
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+
+void ResponseCurve::setGrid(int numPoints, double sampleRate, float minFrequency, float maxFrequency)
+{
+    jassert(numPoints > 1 && sampleRate > 0.0 && minFrequency > 0.0f && maxFrequency > minFrequency);
+
+    frequencies.resize((size_t) numPoints);
+    halfAngleSineSquared.resize((size_t) numPoints);
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto frequency = (double) minFrequency * std::pow((double) maxFrequency / (double) minFrequency,
+                                                                (double) i / (double) (numPoints - 1));
+        const auto halfAngleSine = std::sin(juce::MathConstants<double>::pi * frequency / sampleRate);
+
+        frequencies[(size_t) i] = (float) frequency;
+        halfAngleSineSquared[(size_t) i] = (float) (halfAngleSine * halfAngleSine);
+    }
+
+    for (auto& decibels : stageDecibels)
+        decibels.assign((size_t) numPoints, 0.0f);
+
+    magnitudesInDb.assign((size_t) numPoints, 0.0f);
+
+    oversampledHalfAngleSineSquared.clear();
+    oversampledGridFactor = 1;
+
+    gridSampleRate = sampleRate;
+    evaluated = false;
+}
+
+int ResponseCurve::getNumPoints() const noexcept
+{
+    return ((int) frequencies.size());
+}
+
+double ResponseCurve::getSampleRate() const noexcept
+{
+    return (gridSampleRate);
+}
+
+bool ResponseCurve::update(const CoefficientSet& set)
+{
+    if (frequencies.empty())
+        return (false);
+
+    bool changed = false;
+
+    for (auto stage : { lowCutStage, peakStage, highCutStage, bandsStage })
+    {
+        if (evaluated && stageEquals(stage, set, evaluatedSet))
+            continue;
+
+        evaluateStage(stage, set);
+        changed = true;
+    }
+
+    if (! changed)
+        return (false);
+
+    evaluatedSet = set;
+    evaluated = true;
+
+    const auto numPoints = (int) magnitudesInDb.size();
+
+    juce::FloatVectorOperations::add(magnitudesInDb.data(), stageDecibels[lowCutStage].data(), stageDecibels[peakStage].data(), numPoints);
+    juce::FloatVectorOperations::add(magnitudesInDb.data(), stageDecibels[highCutStage].data(), numPoints);
+    juce::FloatVectorOperations::add(magnitudesInDb.data(), stageDecibels[bandsStage].data(), numPoints);
+
+    return (true);
+}
+
+const std::vector<float>& ResponseCurve::getFrequencies() const noexcept
+{
+    return (frequencies);
+}
+
+const std::vector<float>& ResponseCurve::getMagnitudesInDb() const noexcept
+{
+    return (magnitudesInDb);
+}
+
+int ResponseCurve::getNumStageEvaluations() const noexcept
+{
+    return (numStageEvaluations);
+}
+
+//==============================================================================
+void ResponseCurve::accumulateSection(const BiquadCoefficients& c, const std::vector<float>& sinesSquared,
+                                      float* magnitudes) const noexcept
+{
+    // [LUCAS] : The polynomials in s of the squared numerator and denominator magnitudes
+    const auto n0 = (float) ((c.b0 + c.b1 + c.b2) * (c.b0 + c.b1 + c.b2));
+    const auto n1 = (float) (-4.0 * (c.b0 * c.b1 + c.b1 * c.b2 + 4.0 * c.b0 * c.b2));
+    const auto n2 = (float) (16.0 * c.b0 * c.b2);
+
+    const auto d0 = (float) ((1.0 + c.a1 + c.a2) * (1.0 + c.a1 + c.a2));
+    const auto d1 = (float) (-4.0 * (c.a1 + c.a1 * c.a2 + 4.0 * c.a2));
+    const auto d2 = (float) (16.0 * c.a2);
+
+    const auto* s = sinesSquared.data();
+    const auto numPoints = (int) sinesSquared.size();
+
+    // [LUCAS] : The floor keeps steep cuts far in their stop band from underflowing
+    const auto floor = std::pow(10.0f, minDecibels / 10.0f);
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto numerator = n0 + s[i] * (n1 + s[i] * n2);
+        const auto denominator = d0 + s[i] * (d1 + s[i] * d2);
+
+        magnitudes[i] = juce::jmax(floor, magnitudes[i] * numerator / denominator);
+    }
+}
+
+void ResponseCurve::evaluateStage(Stage stage, const CoefficientSet& set)
+{
+    auto& decibels = stageDecibels[(size_t) stage];
+    const auto numPoints = (int) decibels.size();
+
+    ++numStageEvaluations;
+
+    const auto neutral = (stage == lowCutStage ? set.lowCutNeutral
+                        : stage == peakStage ? set.peakNeutral
+                        : stage == highCutStage ? set.highCutNeutral
+                                                : set.activeBands.none());
+
+    if (neutral)
+    {
+        juce::FloatVectorOperations::clear(decibels.data(), numPoints);
+        return;
+    }
+
+    // [LUCAS] : The squared magnitudes are accumulated in the dB array, then converted in place
+    auto* magnitudes = decibels.data();
+    juce::FloatVectorOperations::fill(magnitudes, 1.0f, numPoints);
+
+    if (stage == peakStage)
+    {
+        accumulateSection(set.peak, getHalfAngleSineSquared(set.peakOversamplingFactor), magnitudes);
+    }
+    else if (stage == bandsStage)
+    {
+        for (size_t i = 0; i < set.bands.size(); ++i)
+            if (set.activeBands.test(i))
+                accumulateSection(set.bands[i], halfAngleSineSquared, magnitudes);
+    }
+    else
+    {
+        const auto& sections = (stage == lowCutStage ? set.lowCut : set.highCut);
+        const auto slope = (stage == lowCutStage ? set.lowCutSlope : set.highCutSlope);
+
+        for (int i = 0; i <= slope; ++i)
+            accumulateSection(sections[(size_t) i], halfAngleSineSquared, magnitudes);
+    }
+
+    for (int i = 0; i < numPoints; ++i)
+        magnitudes[i] = 10.0f * std::log10(magnitudes[i]);
+}
+
+const std::vector<float>& ResponseCurve::getHalfAngleSineSquared(int oversamplingFactor)
+{
+    if (oversamplingFactor <= 1)
+        return (halfAngleSineSquared);
+
+    if (oversamplingFactor != oversampledGridFactor || oversampledHalfAngleSineSquared.size() != frequencies.size())
+    {
+        oversampledHalfAngleSineSquared.resize(frequencies.size());
+
+        for (size_t i = 0; i < frequencies.size(); ++i)
+        {
+            const auto halfAngleSine = std::sin(juce::MathConstants<double>::pi * (double) frequencies[i]
+                                                / (gridSampleRate * oversamplingFactor));
+
+            oversampledHalfAngleSineSquared[i] = (float) (halfAngleSine * halfAngleSine);
+        }
+
+        oversampledGridFactor = oversamplingFactor;
+    }
+
+    return (oversampledHalfAngleSineSquared);
+}
+
+bool ResponseCurve::stageEquals(Stage stage, const CoefficientSet& a, const CoefficientSet& b) noexcept
+{
+    const auto sectionEquals = [](const BiquadCoefficients& x, const BiquadCoefficients& y)
+    {
+        return (x.b0 == y.b0 && x.b1 == y.b1 && x.b2 == y.b2 && x.a1 == y.a1 && x.a2 == y.a2);
+    };
+
+    if (stage == peakStage)
+        return (a.peakNeutral == b.peakNeutral && a.peakOversamplingFactor == b.peakOversamplingFactor
+                && sectionEquals(a.peak, b.peak));
+
+    if (stage == bandsStage)
+    {
+        if (a.activeBands != b.activeBands)
+            return (false);
+
+        for (size_t i = 0; i < a.bands.size(); ++i)
+            if (a.activeBands.test(i) && ! sectionEquals(a.bands[i], b.bands[i]))
+                return (false);
+
+        return (true);
+    }
+
+    const auto& sectionsA = (stage == lowCutStage ? a.lowCut : a.highCut);
+    const auto& sectionsB = (stage == lowCutStage ? b.lowCut : b.highCut);
+    const auto slopeA = (stage == lowCutStage ? a.lowCutSlope : a.highCutSlope);
+    const auto slopeB = (stage == lowCutStage ? b.lowCutSlope : b.highCutSlope);
+    const auto neutralA = (stage == lowCutStage ? a.lowCutNeutral : a.highCutNeutral);
+    const auto neutralB = (stage == lowCutStage ? b.lowCutNeutral : b.highCutNeutral);
+
+    if (slopeA != slopeB || neutralA != neutralB)
+        return (false);
+
+    for (int i = 0; i <= slopeA; ++i)
+        if (! sectionEquals(sectionsA[(size_t) i], sectionsB[(size_t) i]))
+            return (false);
+
+    return (true);
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    This file contains the magnitude response curve of the EQ drawn by the
+    editor, evaluated over a cached frequency grid.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CoefficientDesigner.h"
+
+//==============================================================================
+// [LUCAS] : This class evaluates the magnitude response of a CoefficientSet
+//           over a log frequency grid, typically one point per pixel column.
+//
+//           On the unit circle, with s = sin^2(w / 2), the squared magnitude of
+//           b0 + b1 z^-1 + b2 z^-2 is the polynomial
+//               (b0 + b1 + b2)^2 - 4 (b0 b1 + b1 b2 + 4 b0 b2) s + 16 b0 b2 s^2,
+//           and likewise for the denominator. The polynomial coefficients are
+//           computed once per section in double precision, which keeps the
+//           response of low frequency cuts accurate, and the grid is then swept
+//           with two Horner steps and a division per point, in float loops
+//           the compiler vectorises.
+//
+//           The response of each filter (low cut, peak, high cut, and the parametric bands
+//           together) is cached, and only the filters whose coefficients changed are evaluated again.
+//           An oversampled peak is evaluated over the same frequencies, at its own rate.
+class ResponseCurve
+{
+public:
+    enum Stage
+    {
+        lowCutStage,
+        peakStage,
+        highCutStage,
+        bandsStage,
+        numStages
+    };
+
+    ResponseCurve() = default;
+
+    // [LUCAS] : Builds a grid of numPoints frequencies, log spaced from minFrequency to maxFrequency,
+    //           and clears the cached responses. This allocates.
+    void setGrid(int numPoints, double sampleRate, float minFrequency, float maxFrequency);
+
+    int getNumPoints() const noexcept;
+    double getSampleRate() const noexcept;
+
+    // [LUCAS] : Evaluates the filters of the set whose coefficients changed since the previous call,
+    //           and returns true if any did. Neutral filters are flat.
+    bool update(const CoefficientSet& set);
+
+    // [LUCAS] : The frequencies of the grid, and the response of the whole chain on it, in dB
+    const std::vector<float>& getFrequencies() const noexcept;
+    const std::vector<float>& getMagnitudesInDb() const noexcept;
+
+    // [LUCAS] : How many times a filter was evaluated over the grid
+    int getNumStageEvaluations() const noexcept;
+
+    // [LUCAS] : The response floor, in dB
+    static constexpr float minDecibels = -300.0f;
+
+private:
+    // [LUCAS] : Multiplies magnitudes by the squared magnitude response of the section,
+    //           over the sin^2(w / 2) of the grid at the rate of the section
+    void accumulateSection(const BiquadCoefficients& coefficients, const std::vector<float>& sinesSquared,
+                           float* magnitudes) const noexcept;
+
+    // [LUCAS] : Returns sin^2(w / 2) over the grid at the given multiple of its sample rate.
+    //           This allocates the first time a new factor is asked for.
+    const std::vector<float>& getHalfAngleSineSquared(int oversamplingFactor);
+
+    void evaluateStage(Stage stage, const CoefficientSet& set);
+
+    static bool stageEquals(Stage stage, const CoefficientSet& a, const CoefficientSet& b) noexcept;
+
+    std::vector<float> frequencies;
+
+    // [LUCAS] : sin^2(w / 2) at each frequency of the grid, and at the oversampled rate of the peak
+    std::vector<float> halfAngleSineSquared;
+    std::vector<float> oversampledHalfAngleSineSquared;
+    int oversampledGridFactor { 1 };
+
+    std::array<std::vector<float>, numStages> stageDecibels;
+    std::vector<float> magnitudesInDb;
+
+    CoefficientSet evaluatedSet;
+    bool evaluated { false };
+    double gridSampleRate { 0.0 };
+    int numStageEvaluations { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponseCurve)
+};
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    This file contains the spectrum analyzer of the editor : samples pushed
+    by the audio thread without locks, and analysed on a background thread.
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : juce::Thread("SimpleEQ Spectrum Analyzer")
+{
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    setActive(false);
+}
+
+void SpectrumAnalyzer::prepare(double newSampleRate)
+{
+    sampleRate.store(newSampleRate);
+}
+
+double SpectrumAnalyzer::getSampleRate() const noexcept
+{
+    return (sampleRate.load());
+}
+
+void SpectrumAnalyzer::setActive(bool shouldBeActive)
+{
+    active.store(shouldBeActive);
+
+    if (shouldBeActive)
+        startThread();
+    else
+        stopThread(1000);
+}
+
+bool SpectrumAnalyzer::isActive() const noexcept
+{
+    return (active.load());
+}
+
+void SpectrumAnalyzer::setFftOrder(int newOrder)
+{
+    fftOrder.store(juce::jlimit(minFftOrder, maxFftOrder, newOrder));
+}
+
+void SpectrumAnalyzer::setOverlap(int newOverlap)
+{
+    overlap.store(juce::jlimit(1, maxOverlap, juce::nextPowerOfTwo(newOverlap)));
+}
+
+int SpectrumAnalyzer::getFftOrder() const noexcept
+{
+    return (fftOrder.load());
+}
+
+int SpectrumAnalyzer::getOverlap() const noexcept
+{
+    return (overlap.load());
+}
+
+void SpectrumAnalyzer::setDisplaySize(int width, int height)
+{
+    displayWidth.store(width);
+    displayHeight.store(height);
+}
+
+const SpectrumAnalyzer::Spectra* SpectrumAnalyzer::getNewSpectra() noexcept
+{
+    return (spectraBuffer.read());
+}
+
+//==============================================================================
+void SpectrumAnalyzer::run()
+{
+    // [LUCAS] : Whatever was pushed before the analyzer was last stopped is out of date
+    for (auto& tapFifo : fifos)
+        tapFifo.fifo.read(tapFifo.fifo.getNumReady());
+
+    configuredOrder = 0;
+
+    while (! threadShouldExit())
+    {
+        if (fftOrder.load() != configuredOrder)
+            configure();
+
+        const auto fftSize = 1 << configuredOrder;
+        const auto hopSize = fftSize / overlap.load();
+
+        bool analysed = false;
+
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            auto& tapFifo = fifos[(size_t) tap];
+            auto& state = taps[(size_t) tap];
+
+            // [LUCAS] : Slides the newest samples into the history, one FFT frame per hop
+            while (tapFifo.fifo.getNumReady() > 0)
+            {
+                const auto numSamples = juce::jmin(tapFifo.fifo.getNumReady(), juce::jmax(1, hopSize - state.newSamples));
+                const auto scope = tapFifo.fifo.read(numSamples);
+
+                std::move(state.history.begin() + numSamples, state.history.end(), state.history.begin());
+
+                auto* destination = state.history.data() + fftSize - numSamples;
+                std::copy_n(tapFifo.buffer.data() + scope.startIndex1, scope.blockSize1, destination);
+                std::copy_n(tapFifo.buffer.data() + scope.startIndex2, scope.blockSize2, destination + scope.blockSize1);
+
+                state.newSamples += numSamples;
+
+                if (state.newSamples >= hopSize)
+                {
+                    analyse(tap);
+                    state.newSamples = 0;
+                    analysed = true;
+                }
+            }
+        }
+
+        if (analysed && juce::Time::getMillisecondCounter() - lastPublishMs >= (juce::uint32) (1000 / maxFrameRate))
+        {
+            publishSpectra();
+            lastPublishMs = juce::Time::getMillisecondCounter();
+        }
+
+        wait(pollIntervalMs);
+    }
+}
+
+void SpectrumAnalyzer::configure()
+{
+    configuredOrder = fftOrder.load();
+
+    const auto fftSize = 1 << configuredOrder;
+
+    fft = std::make_unique<juce::dsp::FFT>(configuredOrder);
+    fftData.assign((size_t) (2 * fftSize), 0.0f);
+
+    // [LUCAS] : The window is normalised so that it sums up to fftSize,
+    //           which makes a full scale sine read 0 dB once scaled by 2 / fftSize
+    window.assign((size_t) fftSize, 0.0f);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), (size_t) fftSize,
+                                                             juce::dsp::WindowingFunction<float>::hann, true);
+
+    for (auto& state : taps)
+    {
+        state.history.assign((size_t) fftSize, 0.0f);
+        state.levels.assign((size_t) (fftSize / 2 + 1), minDecibels);
+        state.newSamples = 0;
+    }
+}
+
+void SpectrumAnalyzer::analyse(int tap)
+{
+    auto& state = taps[(size_t) tap];
+
+    const auto fftSize = 1 << configuredOrder;
+    const auto scale = 2.0f / (float) fftSize;
+
+    // [LUCAS] : The levels fall by the release of one hop at most
+    const auto release = releaseDecibelsPerSecond * (float) (fftSize / overlap.load()) / (float) sampleRate.load();
+
+    juce::FloatVectorOperations::multiply(fftData.data(), state.history.data(), window.data(), fftSize);
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    for (size_t bin = 0; bin < state.levels.size(); ++bin)
+    {
+        const auto level = juce::Decibels::gainToDecibels(fftData[bin] * scale, minDecibels);
+        state.levels[bin] = juce::jmax(level, state.levels[bin] - release);
+    }
+}
+
+void SpectrumAnalyzer::publishSpectra()
+{
+    const auto width = displayWidth.load();
+    const auto height = displayHeight.load();
+
+    if (width <= 0 || height <= 0)
+        return;
+
+    const auto fftSize = 1 << configuredOrder;
+    const auto nyquist = (float) sampleRate.load() * 0.5f;
+    const auto binsPerHertz = (float) fftSize / (2.0f * nyquist);
+
+    auto& spectra = spectraBuffer.getWriteBuffer();
+    spectra.width = width;
+    spectra.height = height;
+
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        const auto& levels = taps[(size_t) tap].levels;
+        auto& path = spectra.paths[(size_t) tap];
+        path.clear();
+        path.preallocateSpace(3 * (width + 1));
+
+        // [LUCAS] : One point per pixel column, on a log frequency axis :
+        //           the loudest bin of the column, or the nearest one where the bins
+        //           are wider than the columns
+        for (int x = 0; x <= width; ++x)
+        {
+            const auto lowFrequency = minFrequency * std::pow(nyquist / minFrequency, ((float) x - 0.5f) / (float) width);
+            const auto highFrequency = minFrequency * std::pow(nyquist / minFrequency, ((float) x + 0.5f) / (float) width);
+
+            const auto firstBin = juce::jlimit(0, (int) levels.size() - 1, juce::roundToInt(lowFrequency * binsPerHertz));
+            const auto lastBin = juce::jlimit(firstBin, (int) levels.size() - 1, juce::roundToInt(highFrequency * binsPerHertz));
+
+            auto level = levels[(size_t) firstBin];
+
+            for (int bin = firstBin + 1; bin <= lastBin; ++bin)
+                level = juce::jmax(level, levels[(size_t) bin]);
+
+            const auto y = juce::jmap(level, minDecibels, maxDecibels, (float) height, 0.0f);
+
+            if (x == 0)
+                path.startNewSubPath(0.0f, y);
+            else
+                path.lineTo((float) x, y);
+        }
+    }
+
+    spectraBuffer.publish();
+}
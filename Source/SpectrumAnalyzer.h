@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    This file contains the spectrum analyzer of the editor : samples pushed
+    by the audio thread without locks, and analysed on a background thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TripleBuffer.h"
+
+//==============================================================================
+// [LUCAS] : This class measures the spectrum of the input and of the output of the EQ.
+//
+//           The audio thread mixes each block down to mono and pushes it into a
+//           wait-free FIFO per tap, or returns straight away when the analyzer is
+//           inactive, which is the case whenever no editor is open.
+//           A background thread runs windowed FFTs over the FIFOs, with a configurable
+//           order and overlap, and turns the spectra into paths of one point per pixel
+//           column on a log frequency axis. The paths are handed over to the editor
+//           through a TripleBuffer, at most maxFrameRate times per second.
+class SpectrumAnalyzer : private juce::Thread
+{
+public:
+    // [LUCAS] : Where the samples are taken from
+    enum Tap
+    {
+        preEq,
+        postEq,
+        numTaps
+    };
+
+    // [LUCAS] : The paths of both taps, for a display of the given size
+    struct Spectra
+    {
+        std::array<juce::Path, numTaps> paths;
+        int width { 0 }, height { 0 };
+    };
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
+
+    // [LUCAS] : The FFT orders and overlap factors that can be selected
+    static constexpr int minFftOrder = 9;
+    static constexpr int maxFftOrder = 14;
+    static constexpr int maxOverlap = 8;
+
+    // [LUCAS] : The most paths built per second, and the range they show
+    static constexpr int maxFrameRate = 30;
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float minDecibels = -96.0f;
+    static constexpr float maxDecibels = 6.0f;
+
+    // [LUCAS] : Can be called from any thread
+    void prepare(double sampleRate);
+    double getSampleRate() const noexcept;
+
+    // [LUCAS] : Message thread : starts or stops the analysis. The editor activates
+    //           the analyzer while it is open, so it costs nothing otherwise.
+    void setActive(bool shouldBeActive);
+    bool isActive() const noexcept;
+
+    // [LUCAS] : These settings are picked up by the analysis thread on its next frame.
+    //           The overlap is the number of FFT frames per FFT length.
+    void setFftOrder(int newOrder);
+    void setOverlap(int newOverlap);
+    int getFftOrder() const noexcept;
+    int getOverlap() const noexcept;
+
+    // [LUCAS] : Message thread : the size of the display the paths are built for
+    void setDisplaySize(int width, int height);
+
+    // [LUCAS] : Audio thread : mixes the block down to mono and pushes it,
+    //           dropping what the FIFO has no room for
+    template<typename SampleType>
+    void pushSamples(Tap tap, const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        if (! active.load(std::memory_order_relaxed) || block.getNumChannels() == 0)
+            return;
+
+        auto& fifo = fifos[(size_t) tap];
+        const auto numChannels = block.getNumChannels();
+        const auto gain = 1.0f / (float) numChannels;
+
+        const auto scope = fifo.fifo.write((int) block.getNumSamples());
+
+        const auto mix = [&](int start, int size, int offset)
+        {
+            auto* destination = fifo.buffer.data() + start;
+            std::fill_n(destination, size, 0.0f);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* source = block.getChannelPointer(channel) + offset;
+
+                for (int i = 0; i < size; ++i)
+                    destination[i] += (float) source[i] * gain;
+            }
+        };
+
+        mix(scope.startIndex1, scope.blockSize1, 0);
+        mix(scope.startIndex2, scope.blockSize2, scope.blockSize1);
+    }
+
+    // [LUCAS] : Message thread : returns the newest paths, or nullptr if there are none
+    const Spectra* getNewSpectra() noexcept;
+
+private:
+    void run() override;
+
+    // [LUCAS] : Reallocates the analysis buffers for the current order
+    void configure();
+
+    // [LUCAS] : Runs one FFT over the newest samples of the tap, and updates its levels
+    void analyse(int tap);
+
+    // [LUCAS] : Builds the paths of both taps, and hands them over to the editor
+    void publishSpectra();
+
+    // [LUCAS] : Enough for two frames of the largest FFT
+    static constexpr int fifoSize = 2 << maxFftOrder;
+
+    // [LUCAS] : Samples pushed by the audio thread, for one tap
+    struct TapFifo
+    {
+        juce::AbstractFifo fifo { fifoSize };
+        std::vector<float> buffer = std::vector<float>((size_t) fifoSize);
+    };
+
+    // [LUCAS] : The analysis state of one tap
+    struct TapState
+    {
+        std::vector<float> history;
+        std::vector<float> levels;
+        int newSamples { 0 };
+    };
+
+    // [LUCAS] : How fast the displayed levels fall, in dB per second
+    static constexpr float releaseDecibelsPerSecond = 48.0f;
+
+    // [LUCAS] : How often the analysis thread looks for new samples
+    static constexpr int pollIntervalMs = 5;
+
+    std::atomic<bool> active { false };
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<int> fftOrder { 11 };
+    std::atomic<int> overlap { 4 };
+    std::atomic<int> displayWidth { 0 }, displayHeight { 0 };
+
+    std::array<TapFifo, numTaps> fifos;
+
+    // [LUCAS] : Only touched by the analysis thread
+    std::array<TapState, numTaps> taps;
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window;
+    std::vector<float> fftData;
+    int configuredOrder { 0 };
+    juce::uint32 lastPublishMs { 0 };
+
+    TripleBuffer<Spectra> spectraBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};
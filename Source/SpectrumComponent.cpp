@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    This file contains the editor panel showing the spectrum of the input
+    and of the output of the EQ, under its response curve.
+
+  ==============================================================================
+*/
+
+#include "SpectrumComponent.h"
+
+SpectrumComponent::SpectrumComponent(SimpleEQAudioProcessor& processor)
+    : audioProcessor(processor),
+      spectrumAnalyzer(processor.getSpectrumAnalyzer())
+{
+    setOpaque(true);
+
+    spectrumAnalyzer.setActive(true);
+    startTimerHz(SpectrumAnalyzer::maxFrameRate);
+}
+
+SpectrumComponent::~SpectrumComponent()
+{
+    stopTimer();
+
+    // [LUCAS] : Without an editor, the audio thread stops pushing samples
+    spectrumAnalyzer.setActive(false);
+}
+
+void SpectrumComponent::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    // [LUCAS] : A grid line per decade, and per 24 dB
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+
+    for (auto frequency : { 100.0f, 1000.0f, 10000.0f })
+        g.drawVerticalLine(juce::roundToInt(getPositionForFrequency(frequency)), 0.0f, (float) getHeight());
+
+    for (auto decibels = SpectrumAnalyzer::maxDecibels - 6.0f; decibels > SpectrumAnalyzer::minDecibels; decibels -= 24.0f)
+    {
+        const auto y = juce::jmap(decibels, SpectrumAnalyzer::minDecibels, SpectrumAnalyzer::maxDecibels, (float) getHeight(), 0.0f);
+        g.drawHorizontalLine(juce::roundToInt(y), 0.0f, (float) getWidth());
+    }
+
+    // [LUCAS] : The paths were built for the current size, unless the component was just resized
+    if (spectra.width == getWidth() && spectra.height == getHeight())
+    {
+        g.setColour(juce::Colours::grey);
+        g.strokePath(spectra.paths[SpectrumAnalyzer::preEq], juce::PathStrokeType(1.0f));
+
+        g.setColour(juce::Colours::skyblue);
+        g.strokePath(spectra.paths[SpectrumAnalyzer::postEq], juce::PathStrokeType(1.5f));
+    }
+
+    g.setColour(juce::Colours::white);
+    g.strokePath(responsePath, juce::PathStrokeType(2.0f));
+}
+
+void SpectrumComponent::resized()
+{
+    spectrumAnalyzer.setDisplaySize(getWidth(), getHeight());
+    updateResponseGrid();
+}
+
+void SpectrumComponent::timerCallback()
+{
+    bool changed = false;
+
+    if (const auto* newSpectra = spectrumAnalyzer.getNewSpectra())
+    {
+        spectra = *newSpectra;
+        changed = true;
+    }
+
+    if (responseCurve.getSampleRate() != spectrumAnalyzer.getSampleRate())
+        updateResponseGrid();
+
+    // [LUCAS] : Only the filters whose coefficients changed are evaluated again
+    if (const auto* coefficients = audioProcessor.getResponseCoefficients())
+    {
+        if (responseCurve.update(*coefficients))
+        {
+            updateResponsePath();
+            changed = true;
+        }
+    }
+
+    if (changed)
+        repaint();
+}
+
+void SpectrumComponent::updateResponseGrid()
+{
+    const auto sampleRate = spectrumAnalyzer.getSampleRate();
+
+    if (getWidth() <= 0 || sampleRate <= 0.0)
+        return;
+
+    // [LUCAS] : The same log axis as the spectrum, one point per pixel column
+    responseCurve.setGrid(getWidth() + 1, sampleRate, SpectrumAnalyzer::minFrequency, (float) sampleRate * 0.5f);
+
+    if (const auto* coefficients = audioProcessor.getResponseCoefficients())
+        responseCurve.update(*coefficients);
+
+    updateResponsePath();
+}
+
+void SpectrumComponent::updateResponsePath()
+{
+    const auto& magnitudes = responseCurve.getMagnitudesInDb();
+    const auto height = (float) getHeight();
+
+    responsePath.clear();
+
+    if (magnitudes.empty())
+        return;
+
+    responsePath.preallocateSpace(3 * (int) magnitudes.size());
+
+    for (size_t x = 0; x < magnitudes.size(); ++x)
+    {
+        const auto decibels = juce::jlimit(-responseRangeInDb, responseRangeInDb, magnitudes[x]);
+        const auto y = juce::jmap(decibels, -responseRangeInDb, responseRangeInDb, height, 0.0f);
+
+        if (x == 0)
+            responsePath.startNewSubPath(0.0f, y);
+        else
+            responsePath.lineTo((float) x, y);
+    }
+}
+
+float SpectrumComponent::getPositionForFrequency(float frequency) const noexcept
+{
+    const auto nyquist = juce::jmax(SpectrumAnalyzer::minFrequency * 2.0f, (float) spectrumAnalyzer.getSampleRate() * 0.5f);
+
+    return ((float) getWidth() * std::log(frequency / SpectrumAnalyzer::minFrequency)
+                               / std::log(nyquist / SpectrumAnalyzer::minFrequency));
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    This file contains the editor panel showing the spectrum of the input
+    and of the output of the EQ, under its response curve.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "ResponseCurve.h"
+#include "SpectrumAnalyzer.h"
+
+//==============================================================================
+// [LUCAS] : This component draws the paths built by a SpectrumAnalyzer :
+//           the input of the EQ in grey, and its output on top,
+//           then the magnitude response of the coefficients the audio is processed with.
+//           It activates the analyzer for as long as it exists, and only repaints
+//           when new paths or coefficients came in, at most SpectrumAnalyzer::maxFrameRate
+//           times per second. The response is evaluated once per pixel column.
+class SpectrumComponent : public juce::Component,
+                          private juce::Timer
+{
+public:
+    SpectrumComponent(SimpleEQAudioProcessor& processor);
+    ~SpectrumComponent() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void timerCallback() override;
+
+    // [LUCAS] : The horizontal position of a frequency, on the log axis of the analyzer
+    float getPositionForFrequency(float frequency) const noexcept;
+
+    // [LUCAS] : Rebuilds the grid of the response curve for the current width and sample rate
+    void updateResponseGrid();
+    void updateResponsePath();
+
+    // [LUCAS] : The range of the response curve
+    static constexpr float responseRangeInDb = 24.0f;
+
+    SimpleEQAudioProcessor& audioProcessor;
+    SpectrumAnalyzer& spectrumAnalyzer;
+
+    SpectrumAnalyzer::Spectra spectra;
+
+    ResponseCurve responseCurve;
+    juce::Path responsePath;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumComponent)
+};
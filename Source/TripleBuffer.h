@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    This file contains a wait-free triple buffer, used to hand values over
+    from one producer thread to one consumer thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// [LUCAS] : This class hands the latest value written by a single producer thread
+//           over to a single consumer thread, without locks and without allocations.
+//           The producer writes into a back buffer and publishes it; the consumer
+//           only ever sees fully written values, and always the newest one.
+template<typename ValueType>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // [LUCAS] : Producer side : returns the buffer to write the next value into
+    ValueType& getWriteBuffer() noexcept
+    {
+        return (buffers[(size_t) writeIndex]);
+    }
+
+    // [LUCAS] : Producer side : makes the write buffer visible to the consumer,
+    //           and takes back whichever buffer the consumer is not using
+    void publish() noexcept
+    {
+        writeIndex = sharedState.exchange(writeIndex | newValueFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // [LUCAS] : Consumer side : returns the newest published value,
+    //           or nullptr if nothing was published since the last call
+    const ValueType* read() noexcept
+    {
+        if ((sharedState.load(std::memory_order_relaxed) & newValueFlag) == 0)
+            return (nullptr);
+
+        readIndex = sharedState.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+
+        return (&buffers[(size_t) readIndex]);
+    }
+
+private:
+    static constexpr int indexMask = 0x3;
+    static constexpr int newValueFlag = 0x4;
+
+    std::array<ValueType, 3> buffers;
+
+    // [LUCAS] : The index of the buffer in the middle, plus the new value flag
+    std::atomic<int> sharedState { 1 };
+
+    int writeIndex { 0 };
+    int readIndex { 2 };
+
+    JUCE_DECLARE_NON_COPYABLE (TripleBuffer)
+};
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the closed-form designs, against the
+    juce::dsp designs they replace.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CascadeDesign.h"
+
+//==============================================================================
+class CascadeDesignTests : public juce::UnitTest
+{
+public:
+    CascadeDesignTests() : juce::UnitTest("Cascade design", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("Butterworth Q tables");
+        {
+            for (auto slope : slopes)
+            {
+                const int order = 2 * (slope + 1);
+
+                for (int i = 0; i <= slope; ++i)
+                {
+                    const auto q = 1.0 / (2.0 * std::cos((2.0 * i + 1.0) * juce::MathConstants<double>::pi / (order * 2.0)));
+                    expectWithinAbsoluteError(ButterworthTables::qs[(size_t) slope][(size_t) i], q, 1.0e-12);
+                }
+            }
+        }
+
+        beginTest("Low cut matches FilterDesign");
+        {
+            for (auto sampleRate : sampleRates)
+                for (auto slope : slopes)
+                    for (auto frequency : getCutFrequencies(sampleRate))
+                    {
+                        std::array<BiquadCoefficients, 4> sections;
+                        designButterworthHighPass(sections, frequency, slope, sampleRate);
+
+                        const auto reference = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(
+                            frequency, sampleRate, 2 * (slope + 1));
+
+                        expectEquals(reference.size(), slope + 1);
+
+                        for (int i = 0; i < reference.size(); ++i)
+                            expectMatches(sections[(size_t) i], *reference[i]);
+                    }
+        }
+
+        beginTest("High cut matches FilterDesign");
+        {
+            for (auto sampleRate : sampleRates)
+                for (auto slope : slopes)
+                    for (auto frequency : getCutFrequencies(sampleRate))
+                    {
+                        std::array<BiquadCoefficients, 4> sections;
+                        designButterworthLowPass(sections, frequency, slope, sampleRate);
+
+                        const auto reference = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
+                            frequency, sampleRate, 2 * (slope + 1));
+
+                        expectEquals(reference.size(), slope + 1);
+
+                        for (int i = 0; i < reference.size(); ++i)
+                            expectMatches(sections[(size_t) i], *reference[i]);
+                    }
+        }
+
+        beginTest("Peak matches makePeakFilter");
+        {
+            for (auto sampleRate : sampleRates)
+                for (auto frequency : getCutFrequencies(sampleRate))
+                    for (float q = 0.1f; q <= 10.0f; q *= 1.5f)
+                        for (float gainInDb = -24.0f; gainInDb <= 24.0f; gainInDb += 3.0f)
+                        {
+                            const auto reference = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
+                                sampleRate, frequency, q, juce::Decibels::decibelsToGain(gainInDb));
+
+                            expectMatches(designPeakFilter(frequency, q, gainInDb, sampleRate), *reference);
+                        }
+        }
+    }
+
+private:
+    // [LUCAS] : The closed-form designs are computed in double precision,
+    //           and juce::dsp in float : they differ by a few float roundings
+    static constexpr double tolerance = 1.0e-5;
+
+    static constexpr std::array<double, 5> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 };
+    static constexpr std::array<Slope, 4> slopes { Slope_12, Slope_24, Slope_36, Slope_48 };
+
+    // [LUCAS] : Whole frequencies, roughly a third of an octave apart, over the range of the parameters
+    static std::vector<float> getCutFrequencies(double sampleRate)
+    {
+        std::vector<float> frequencies;
+
+        for (double frequency = 20.0; frequency <= juce::jmin(20000.0, sampleRate * 0.5); frequency *= 1.26)
+            frequencies.push_back((float) std::round(frequency));
+
+        return (frequencies);
+    }
+
+    void expectMatches(const BiquadCoefficients& coefficients, const juce::dsp::IIR::Coefficients<float>& reference)
+    {
+        const auto* raw = reference.getRawCoefficients();
+        const std::array<double, 5> designed { coefficients.b0, coefficients.b1, coefficients.b2, coefficients.a1, coefficients.a2 };
+
+        for (size_t i = 0; i < designed.size(); ++i)
+            expectWithinAbsoluteError(designed[i], (double) raw[i], tolerance);
+    }
+};
+
+static CascadeDesignTests cascadeDesignTests;
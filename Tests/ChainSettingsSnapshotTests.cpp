@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the settings snapshot : its version,
+    and the consistency of what it hands out while being written.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <thread>
+#include "ChainSettings.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+class ChainSettingsSnapshotTests : public juce::UnitTest
+{
+public:
+    ChainSettingsSnapshotTests() : juce::UnitTest("Chain settings snapshot", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("The snapshot follows the parameters, and its version grows with every change");
+        {
+            SimpleEQAudioProcessor processor;
+            ChainSettingsSnapshot snapshot(processor.parametersManager);
+
+            juce::uint32 version = 0;
+            auto settings = snapshot.read(&version);
+
+            expectEquals((int) (version & 1u), 0);
+            expectEquals(snapshot.getVersion(), version);
+
+            set(processor, "Peak Gain", 7.5f);
+            set(processor, "LowCut Slope", 2.0f);
+
+            juce::uint32 newVersion = 0;
+            settings = snapshot.read(&newVersion);
+
+            expectGreaterThan(newVersion, version);
+            expectEquals((int) (newVersion & 1u), 0);
+            expectEquals(settings.peakGainInDb, 7.5f);
+            expectEquals((int) settings.lowCutSlope, (int) Slope::Slope_36);
+
+            // [LUCAS] : Without a change, the version stays put
+            expectEquals(snapshot.getVersion(), newVersion);
+        }
+
+        beginTest("Concurrent writers never leave a reader with a torn or stale snapshot");
+        {
+            SimpleEQAudioProcessor processor;
+            ChainSettingsSnapshot snapshot(processor.parametersManager);
+
+            std::atomic<bool> running { true };
+
+            const auto write = [&processor, &running](int seed)
+            {
+                juce::Random random(seed);
+
+                while (running.load())
+                {
+                    set(processor, "Peak Freq", 1000.0f + (float) random.nextInt(1000));
+                    set(processor, "Peak Gain", (float) random.nextInt(24) * 0.5f);
+                }
+            };
+
+            std::thread first(write, 1), second(write, 2);
+
+            int numReads = 0;
+            juce::uint32 previousVersion = 0;
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                ChainSettings settings;
+                juce::uint32 version = 0;
+
+                if (! snapshot.tryRead(settings, &version))
+                    continue;
+
+                ++numReads;
+
+                // [LUCAS] : Only whole publications are read, in order, with values the writers stored
+                expectEquals((int) (version & 1u), 0);
+                expect(version >= previousVersion);
+                expect(settings.peakFreq == 750.0f || (settings.peakFreq >= 1000.0f && settings.peakFreq < 2000.0f));
+                expect(settings.peakGainInDb >= 0.0f && settings.peakGainInDb < 12.0f);
+
+                previousVersion = version;
+            }
+
+            running.store(false);
+            first.join();
+            second.join();
+
+            expectGreaterThan(numReads, 0);
+
+            // [LUCAS] : A write given up to another writer must still be published by it
+            const auto settings = snapshot.read();
+            expectEquals(settings.peakFreq, processor.parametersManager.getRawParameterValue("Peak Freq")->load());
+            expectEquals(settings.peakGainInDb, processor.parametersManager.getRawParameterValue("Peak Gain")->load());
+        }
+    }
+
+private:
+    static void set(SimpleEQAudioProcessor& processor, const juce::String& parameterId, float value)
+    {
+        auto* parameter = processor.parametersManager.getParameter(parameterId);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+};
+
+static ChainSettingsSnapshotTests chainSettingsSnapshotTests;
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the smoothed mode : the filters ramping
+    towards the automated parameters, in both topologies.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ChainSmoother.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+class ChainSmootherTests : public juce::UnitTest
+{
+public:
+    ChainSmootherTests() : juce::UnitTest("Chain smoother", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        for (auto topology : { FilterTopology::transposedDirectForm2, FilterTopology::stateVariable })
+        {
+            const juce::String name = (topology == FilterTopology::stateVariable ? "state variables" : "biquads");
+
+            beginTest("The peak reaches the automated settings after the ramp, with " + name);
+            {
+                SimpleEQAudioProcessor processor;
+                prepare(processor, topology);
+
+                set(processor, "Peak Gain", 12.0f);
+                set(processor, "Peak Freq", 4000.0f);
+
+                CoefficientSet target;
+                designPeakCoefficients(target, getChainSettings(processor.parametersManager), sampleRate);
+
+                // [LUCAS] : One block is not the whole ramp
+                render(processor, 1, 0.0);
+                expect(! peaksEqual(processor, target));
+
+                const auto rampLengthInBlocks = (int) std::ceil(processor.getSmoothingRampLength() * sampleRate / blockSize);
+                render(processor, rampLengthInBlocks, 0.0);
+                expect(peaksEqual(processor, target));
+
+                processor.releaseResources();
+            }
+
+            beginTest("A step of the peak gain ramps without a jump, with " + name);
+            {
+                SimpleEQAudioProcessor processor;
+                set(processor, "Peak Freq", 1000.0f);
+                prepare(processor, topology);
+
+                // [LUCAS] : A sine at the peak frequency, through the whole ramp, then once it is done
+                const auto rampLengthInBlocks = (int) std::ceil(processor.getSmoothingRampLength() * sampleRate / blockSize);
+                render(processor, 4, 1000.0);
+
+                set(processor, "Peak Gain", 12.0f);
+                const auto rampStep = render(processor, rampLengthInBlocks, 1000.0);
+                const auto settledStep = render(processor, 8, 1000.0);
+
+                // [LUCAS] : The output grows with the gain, without a step larger than the sine makes at +12 dB
+                expectGreaterThan(settledStep, 0.0f);
+                expectLessOrEqual(rampStep, settledStep * 1.25f);
+
+                processor.releaseResources();
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    double phase { 0.0 };
+    float lastSample { 0.0f };
+
+    static void set(SimpleEQAudioProcessor& processor, const juce::String& parameterId, float value)
+    {
+        auto* parameter = processor.parametersManager.getParameter(parameterId);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    void prepare(SimpleEQAudioProcessor& processor, FilterTopology topology)
+    {
+        processor.setCoefficientUpdateMode(CoefficientUpdateMode::smoothed);
+        processor.setSmoothingTopology(topology);
+        processor.setSilenceDetectionEnabled(false);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        phase = 0.0;
+        lastSample = 0.0f;
+    }
+
+    // [LUCAS] : Processes numBlocks blocks of a sine at the given frequency, or silence for 0 Hz,
+    //           and returns the largest difference between two consecutive output samples
+    float render(SimpleEQAudioProcessor& processor, int numBlocks, double frequency)
+    {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midiMessages;
+        float largestStep = 0.0f;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const auto sample = (float) (0.5 * std::sin(phase));
+                phase += juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+                for (int channel = 0; channel < 2; ++channel)
+                    buffer.setSample(channel, i, sample);
+            }
+
+            processor.processBlock(buffer, midiMessages);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                largestStep = juce::jmax(largestStep, std::abs(buffer.getSample(0, i) - lastSample));
+                lastSample = buffer.getSample(0, i);
+            }
+        }
+
+        return (largestStep);
+    }
+
+    static bool peaksEqual(SimpleEQAudioProcessor& processor, const CoefficientSet& target)
+    {
+        const auto* coefficients = processor.getResponseCoefficients();
+
+        if (coefficients == nullptr)
+            return (false);
+
+        const auto& peak = coefficients->peak;
+
+        return (std::abs(peak.b0 - target.peak.b0) < 1.0e-9 && std::abs(peak.b1 - target.peak.b1) < 1.0e-9
+             && std::abs(peak.b2 - target.peak.b2) < 1.0e-9 && std::abs(peak.a1 - target.peak.a1) < 1.0e-9
+             && std::abs(peak.a2 - target.peak.a2) < 1.0e-9);
+    }
+};
+
+static ChainSmootherTests chainSmootherTests;
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the double precision processing path.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CascadeDesign.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+class DoublePrecisionTests : public juce::UnitTest
+{
+public:
+    DoublePrecisionTests() : juce::UnitTest("Double precision", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("The processor processes doubles natively");
+        {
+            SimpleEQAudioProcessor processor;
+            expect(processor.supportsDoublePrecisionProcessing());
+        }
+
+        beginTest("A 20 Hz 48 dB/oct low cut at 192 kHz is accurate in double precision");
+        {
+            constexpr double sampleRate = 192000.0;
+            constexpr int numSamples = 2 * (int) sampleRate;
+
+            std::array<BiquadCoefficients, 4> sections;
+            designButterworthHighPass(sections, 20.0f, Slope_48, sampleRate);
+
+            std::vector<double> input((size_t) numSamples);
+
+            for (size_t i = 0; i < input.size(); ++i)
+                input[i] = 0.5 * std::sin(juce::MathConstants<double>::twoPi * 60.0 * (double) i / sampleRate);
+
+            // [LUCAS] : The reference runs the same coefficients in long double precision
+            std::vector<long double> reference(input.begin(), input.end());
+
+            for (const auto& section : sections)
+            {
+                long double s1 = 0, s2 = 0;
+
+                for (auto& x : reference)
+                {
+                    const auto y = section.b0 * x + s1;
+                    s1 = section.b1 * x - section.a1 * y + s2;
+                    s2 = section.b2 * x - section.a2 * y;
+                    x = y;
+                }
+            }
+
+            const auto floatError = getRelativeError(process<float>(sections, input, sampleRate), reference);
+            const auto doubleError = getRelativeError(process<double>(sections, input, sampleRate), reference);
+
+            logMessage("Relative error : float " + juce::String(floatError) + ", double " + juce::String(doubleError));
+
+            expectLessThan(doubleError, 1.0e-8);
+            expectLessThan(doubleError * 1000.0, floatError);
+        }
+    }
+
+private:
+    template<typename SampleType>
+    static std::vector<double> process(const std::array<BiquadCoefficients, 4>& sections, const std::vector<double>& input, double sampleRate)
+    {
+        BiquadCascade<SampleType, 4> cascade;
+        cascade.prepare({ sampleRate, (juce::uint32) input.size(), 1 });
+
+        for (int i = 0; i < 4; ++i)
+        {
+            cascade.setCoefficients(i, sections[(size_t) i]);
+            cascade.setBypassed(i, false);
+        }
+
+        std::vector<SampleType> samples(input.begin(), input.end());
+        auto* channel = samples.data();
+
+        juce::dsp::AudioBlock<SampleType> block(&channel, 1, samples.size());
+        cascade.process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+
+        return (std::vector<double>(samples.begin(), samples.end()));
+    }
+
+    // [LUCAS] : The RMS error over the second half, once the filters have settled
+    static double getRelativeError(const std::vector<double>& output, const std::vector<long double>& reference)
+    {
+        double error = 0.0, energy = 0.0;
+
+        for (size_t i = output.size() / 2; i < output.size(); ++i)
+        {
+            const auto difference = output[i] - (double) reference[i];
+            error += difference * difference;
+            energy += (double) (reference[i] * reference[i]);
+        }
+
+        return (std::sqrt(error / energy));
+    }
+};
+
+static DoublePrecisionTests doublePrecisionTests;
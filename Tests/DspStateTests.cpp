@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the state block of the DSP : its size,
+    its alignment, and the cascades prepared in memory they do not own.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CascadeDesign.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+class DspStateTests : public juce::UnitTest
+{
+public:
+    DspStateTests() : juce::UnitTest("DSP state", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("A cascade prepared in given memory processes like one owning its state");
+        {
+            expectSameOutput<float>();
+            expectSameOutput<double>();
+        }
+
+        beginTest("The state block of an instance is aligned on a cache line, and stays within its documented size");
+        {
+            // [LUCAS] : The sizes documented next to SimpleEQAudioProcessor::dspState, for a stereo instance
+            for (const auto& [blockSize, maxBytes] : { std::make_pair(64, 4928), std::make_pair(512, 12096) })
+            {
+                SimpleEQAudioProcessor processor;
+                processor.setRateAndBufferSizeDetails(48000.0, blockSize);
+                processor.prepareToPlay(48000.0, blockSize);
+
+                const auto address = reinterpret_cast<std::uintptr_t>(processor.getDspStateData());
+
+                expect(address != 0);
+                expectEquals((int) (address % CacheAlignedMemory::cacheLineSize), 0);
+                expectEquals((int) (processor.getDspStateSizeInBytes() % CacheAlignedMemory::cacheLineSize), 0);
+                expectLessOrEqual((int) processor.getDspStateSizeInBytes(), maxBytes);
+
+                processor.releaseResources();
+            }
+        }
+
+        beginTest("The filters are kept when prepareToPlay moves them into a new state block");
+        {
+            SimpleEQAudioProcessor processor, reference;
+
+            for (auto* instance : { &processor, &reference })
+            {
+                auto* peakGain = instance->parametersManager.getParameter("Peak Gain");
+                peakGain->setValueNotifyingHost(peakGain->convertTo0to1(9.0f));
+
+                instance->setRateAndBufferSizeDetails(48000.0, 128);
+                instance->prepareToPlay(48000.0, 128);
+            }
+
+            // [LUCAS] : A second prepare, with a new block, must not lose the coefficients designed in the first one
+            processor.prepareToPlay(48000.0, 256);
+
+            juce::AudioBuffer<float> first(2, 128), second(2, 128);
+            juce::MidiBuffer midiMessages;
+            juce::Random random(7);
+
+            for (int block = 0; block < 16; ++block)
+            {
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < 128; ++i)
+                        first.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+                second.makeCopyOf(first);
+                processor.processBlock(first, midiMessages);
+                reference.processBlock(second, midiMessages);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < 128; ++i)
+                        expectWithinAbsoluteError(first.getSample(channel, i), second.getSample(channel, i), 1.0e-6f);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 96;
+    static constexpr int numChannels = 3;
+
+    // [LUCAS] : The cascade in given memory is prepared twice, the coefficients being set before the first one
+    template<typename SampleType>
+    void expectSameOutput()
+    {
+        using Cascade = BiquadCascade<SampleType, 2>;
+
+        Cascade owning, external;
+        const juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels };
+
+        for (auto* cascade : { &owning, &external })
+        {
+            cascade->setCoefficients(0, designPeakFilter(1000.0f, 2.0f, 9.0f, sampleRate));
+            cascade->setCoefficients(1, designPeakFilter(8000.0f, 0.5f, -6.0f, sampleRate));
+            cascade->setBypassed(0, false);
+            cascade->setBypassed(1, false);
+        }
+
+        owning.prepare(spec);
+        external.prepare(spec);
+
+        const auto stateSize = Cascade::getStateSizeInBytes(numChannels);
+
+        CacheAlignedMemory memory;
+        memory.allocate(stateSize + Cascade::getScratchSizeInBytes(numChannels, blockSize));
+        external.prepare(spec, memory.getData(), memory.getData() + stateSize);
+
+        juce::Random random(42);
+        juce::AudioBuffer<SampleType> first(numChannels, blockSize), second;
+
+        for (int block = 0; block < 10; ++block)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    first.setSample(channel, i, (SampleType) (random.nextFloat() * 2.0f - 1.0f));
+
+            second.makeCopyOf(first);
+
+            juce::dsp::AudioBlock<SampleType> firstBlock(first), secondBlock(second);
+            owning.process(juce::dsp::ProcessContextReplacing<SampleType>(firstBlock));
+            external.process(juce::dsp::ProcessContextReplacing<SampleType>(secondBlock));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    if (first.getSample(channel, i) != second.getSample(channel, i))
+                    {
+                        expect(false, "block " + juce::String(block) + ", channel " + juce::String(channel));
+                        return;
+                    }
+        }
+    }
+};
+
+static DspStateTests dspStateTests;
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the dynamic mode of the peak filter.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CascadeDesign.h"
+#include "DynamicPeak.h"
+
+//==============================================================================
+class DynamicPeakTests : public juce::UnitTest
+{
+public:
+    DynamicPeakTests() : juce::UnitTest("Dynamic peak", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+
+        beginTest("The gain designer matches the peak designs");
+        {
+            PeakGainDesigner designer;
+
+            for (auto frequency : { 20.f, 750.f, 15000.f })
+            {
+                for (auto q : { 0.1f, 1.f, 10.f })
+                {
+                    designer.prepare(frequency, q, sampleRate);
+
+                    for (float gainInDb = -24.f; gainInDb <= 24.f; gainInDb += 1.5f)
+                    {
+                        // [LUCAS] : The references go through the float decibels of juce::Decibels
+                        const auto biquad = designer.design(gainInDb);
+                        const auto reference = designPeakFilter(frequency, q, gainInDb, sampleRate);
+
+                        expectWithinAbsoluteError(biquad.b0, reference.b0, 1.0e-5);
+                        expectWithinAbsoluteError(biquad.b1, reference.b1, 1.0e-5);
+                        expectWithinAbsoluteError(biquad.b2, reference.b2, 1.0e-5);
+                        expectWithinAbsoluteError(biquad.a1, reference.a1, 1.0e-5);
+                        expectWithinAbsoluteError(biquad.a2, reference.a2, 1.0e-5);
+
+                        const auto stateVariable = designer.designStateVariable(gainInDb);
+                        const auto stateVariableReference = designStateVariablePeak(frequency, q, gainInDb, sampleRate);
+
+                        expectWithinAbsoluteError(stateVariable.g, stateVariableReference.g, 1.0e-5);
+                        expectWithinAbsoluteError(stateVariable.k, stateVariableReference.k, 1.0e-5);
+                        expectWithinAbsoluteError(stateVariable.m1, stateVariableReference.m1, 1.0e-5);
+                    }
+                }
+            }
+        }
+
+        beginTest("The envelope compresses above the threshold, and releases in silence");
+        {
+            DynamicSettings settings;
+            settings.thresholdInDb = -20.f;
+            settings.ratio = 4.f;
+            settings.attackInMs = 1.f;
+            settings.releaseInMs = 50.f;
+
+            DynamicPeak dynamicPeak;
+            dynamicPeak.prepare(sampleRate);
+            dynamicPeak.setSettings(settings);
+
+            std::array<float, 32> samples;
+            samples.fill(0.5f);
+            auto* channel = samples.data();
+            juce::dsp::AudioBlock<float> block(&channel, 1, samples.size());
+
+            for (int i = 0; i < 100; ++i)
+                dynamicPeak.process(block);
+
+            // [LUCAS] : 0.5 is about -6 dB, 14 dB above the threshold, reduced by 1 - 1 / 4
+            const auto expectedInDb = -(juce::Decibels::gainToDecibels(0.5f) + 20.f) * 0.75f;
+            expectWithinAbsoluteError(dynamicPeak.getGainReductionInDb(), expectedInDb, 0.01f);
+
+            for (int i = 0; i < 3000; ++i)
+                dynamicPeak.skip(32);
+
+            expectEquals(dynamicPeak.getGainReductionInDb(), 0.f);
+        }
+
+        beginTest("A quiet input is left alone");
+        {
+            DynamicPeak dynamicPeak;
+            dynamicPeak.prepare(sampleRate);
+
+            std::array<float, 32> samples;
+            samples.fill(0.01f);
+            auto* channel = samples.data();
+            juce::dsp::AudioBlock<float> block(&channel, 1, samples.size());
+
+            for (int i = 0; i < 100; ++i)
+                expectEquals(dynamicPeak.process(block), 0.f);
+        }
+    }
+};
+
+static DynamicPeakTests dynamicPeakTests;
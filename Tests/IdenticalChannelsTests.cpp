@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the identical channels, filtered once
+    by the cascade and copied.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CascadeDesign.h"
+
+//==============================================================================
+class IdenticalChannelsTests : public juce::UnitTest
+{
+public:
+    IdenticalChannelsTests() : juce::UnitTest("Identical channels", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        for (auto topology : { FilterTopology::transposedDirectForm2, FilterTopology::stateVariable })
+        {
+            const juce::String name = (topology == FilterTopology::stateVariable ? "state variables" : "biquads");
+
+            for (int numChannels : { 2, 3, 5 })
+            {
+                beginTest("The detection leaves the output unchanged : " + name + ", " + juce::String(numChannels) + " channels");
+
+                expectSameOutput<float>(topology, numChannels);
+                expectSameOutput<double>(topology, numChannels);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 128;
+
+    // [LUCAS] : Identical channels for a while, then independent ones, so the states
+    //           copied from the first channel must carry on exactly as if filtered apart
+    template<typename SampleType>
+    void expectSameOutput(FilterTopology topology, int numChannels)
+    {
+        BiquadCascade<SampleType, 2> detecting, separate;
+        separate.setIdenticalChannelDetection(false);
+
+        for (auto* cascade : { &detecting, &separate })
+        {
+            cascade->setTopology(topology);
+            cascade->prepare({ sampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels });
+
+            if (topology == FilterTopology::stateVariable)
+            {
+                cascade->setCoefficients(0, designStateVariablePeak(1000.0f, 2.0f, 9.0f, sampleRate));
+                cascade->setCoefficients(1, designStateVariablePeak(8000.0f, 0.5f, -6.0f, sampleRate));
+            }
+            else
+            {
+                cascade->setCoefficients(0, designPeakFilter(1000.0f, 2.0f, 9.0f, sampleRate));
+                cascade->setCoefficients(1, designPeakFilter(8000.0f, 0.5f, -6.0f, sampleRate));
+            }
+
+            cascade->setBypassed(0, false);
+            cascade->setBypassed(1, false);
+        }
+
+        juce::Random random(42);
+        juce::AudioBuffer<SampleType> input(numChannels, blockSize), first, second;
+
+        for (int block = 0; block < 20; ++block)
+        {
+            const bool identical = (block < 10);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                if (identical && channel > 0)
+                    input.copyFrom(channel, 0, input, 0, 0, blockSize);
+                else
+                    for (int i = 0; i < blockSize; ++i)
+                        input.setSample(channel, i, (SampleType) (random.nextFloat() * 2.0f - 1.0f));
+            }
+
+            first.makeCopyOf(input);
+            second.makeCopyOf(input);
+
+            juce::dsp::AudioBlock<SampleType> firstBlock(first), secondBlock(second);
+            detecting.process(juce::dsp::ProcessContextReplacing<SampleType>(firstBlock));
+            separate.process(juce::dsp::ProcessContextReplacing<SampleType>(secondBlock));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    if (first.getSample(channel, i) != second.getSample(channel, i))
+                    {
+                        expect(false, "block " + juce::String(block) + ", channel " + juce::String(channel));
+                        return;
+                    }
+        }
+    }
+};
+
+static IdenticalChannelsTests identicalChannelsTests;
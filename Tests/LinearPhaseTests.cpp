@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the linear phase mode : the response of
+    its kernel, and the latency it reports.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <complex>
+#include "PluginProcessor.h"
+
+//==============================================================================
+class LinearPhaseTests : public juce::UnitTest
+{
+public:
+    LinearPhaseTests() : juce::UnitTest("Linear phase", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        SimpleEQAudioProcessor processor;
+        set(processor, "Peak Freq", 1000.0f);
+        set(processor, "Peak Gain", 9.0f);
+        set(processor, "LowCut Freq", 150.0f);
+        set(processor, "HighCut Freq", 9000.0f);
+
+        processor.setSilenceDetectionEnabled(false);
+        processor.setPhaseMode(PhaseMode::linearPhase);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        // [LUCAS] : Lets the convolutions load their kernel and finish their crossfade,
+        //           which only happens while they process
+        juce::Thread::sleep(200);
+        render(processor, 32);
+
+        const auto latency = processor.getLatencySamples();
+        const auto impulseResponse = render(processor, (processor.getLinearPhaseFirLength() + latency) / blockSize + 2);
+
+        beginTest("The latency is the delay of the kernel centre");
+        {
+            const auto maximum = std::max_element(impulseResponse.begin(), impulseResponse.end(),
+                                                  [](float a, float b) { return (std::abs(a) < std::abs(b)); });
+
+            expectEquals((int) std::distance(impulseResponse.begin(), maximum), latency);
+
+            // [LUCAS] : And the impulse response is symmetric around it
+            for (int i = 1; i < processor.getLinearPhaseFirLength() / 2; ++i)
+                expectWithinAbsoluteError(impulseResponse[(size_t) (latency + i)], impulseResponse[(size_t) (latency - i)], 1.0e-4f);
+        }
+
+        beginTest("The kernel has the magnitude response of the peak and the cuts");
+        {
+            const auto* coefficients = processor.getResponseCoefficients();
+            expect(coefficients != nullptr);
+
+            if (coefficients != nullptr)
+            {
+                for (auto frequency : { 300.0, 700.0, 1000.0, 2500.0, 5000.0, 12000.0 })
+                {
+                    std::complex<double> response;
+                    const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+                    for (size_t i = 0; i < impulseResponse.size(); ++i)
+                        response += (double) impulseResponse[i] * std::polar(1.0, -omega * (double) i);
+
+                    expectWithinAbsoluteError(juce::Decibels::gainToDecibels(std::abs(response)),
+                                              juce::Decibels::gainToDecibels(getMagnitudeForFrequency(*coefficients, frequency, sampleRate)),
+                                              0.2);
+                }
+            }
+        }
+
+        processor.releaseResources();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    static void set(SimpleEQAudioProcessor& processor, const juce::String& parameterId, float value)
+    {
+        auto* parameter = processor.parametersManager.getParameter(parameterId);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    // [LUCAS] : Processes an impulse followed by silence, numBlocks blocks long, and returns the left channel
+    static std::vector<float> render(SimpleEQAudioProcessor& processor, int numBlocks)
+    {
+        std::vector<float> output;
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midiMessages;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            buffer.clear();
+
+            if (block == 0)
+                for (int channel = 0; channel < 2; ++channel)
+                    buffer.setSample(channel, 0, 1.0f);
+
+            processor.processBlock(buffer, midiMessages);
+            output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+        }
+
+        return (output);
+    }
+};
+
+static LinearPhaseTests linearPhaseTests;
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    This file contains the entry point of the SimpleEQ tests.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// [LUCAS] : Runs every juce::UnitTest of the "SimpleEQ" category,
+//           or only the tests whose name is given on the command line,
+//           and returns 1 if any of them failed
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; ++i)
+            for (auto* test : juce::UnitTest::getTestsInCategory("SimpleEQ"))
+                if (test->getName() == juce::String(argv[i]))
+                    runner.runTests({ test });
+    }
+    else
+    {
+        runner.runTestsInCategory("SimpleEQ");
+    }
+
+    int numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult(i)->failures;
+
+    return (numFailures > 0 ? 1 : 0);
+}
@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the neutral filters left out of the chain.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CascadeDesign.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+class NeutralStageTests : public juce::UnitTest
+{
+public:
+    NeutralStageTests() : juce::UnitTest("Neutral stages", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("The default settings are neutral");
+        {
+            ChainSettings settings;
+            settings.peakFreq = 750.f;
+            settings.lowCutFreq = minCutFrequency;
+            settings.highCutFreq = maxCutFrequency;
+
+            expect(isPeakNeutral(settings, 0.05f));
+            expect(isLowCutNeutral(settings, 0.05f));
+            expect(isHighCutNeutral(settings, 0.05f, 48000.0));
+
+            // [LUCAS] : A negative tolerance keeps every filter
+            expect(! isPeakNeutral(settings, -1.f));
+            expect(! isLowCutNeutral(settings, -1.f));
+            expect(! isHighCutNeutral(settings, -1.f, 48000.0));
+
+            settings.peakGainInDb = 0.5f;
+            settings.lowCutFreq = 21.f;
+            settings.highCutFreq = 19999.f;
+
+            expect(! isPeakNeutral(settings, 0.05f));
+            expect(! isLowCutNeutral(settings, 0.05f));
+            expect(! isHighCutNeutral(settings, 0.05f, 48000.0));
+
+            // [LUCAS] : A high cut above Nyquist has nothing left to cut
+            expect(isHighCutNeutral(settings, 0.05f, 32000.0));
+        }
+
+        beginTest("The default settings pass the audio through unchanged");
+        {
+            SimpleEQAudioProcessor processor;
+            expect(! renderChangesInput(processor));
+        }
+
+        beginTest("Filters off their neutral settings are processed");
+        {
+            SimpleEQAudioProcessor processor;
+            auto* peakGain = processor.parametersManager.getParameter("Peak Gain");
+            peakGain->setValueNotifyingHost(peakGain->convertTo0to1(6.0f));
+
+            expect(renderChangesInput(processor));
+        }
+
+        beginTest("A negative tolerance processes the neutral filters");
+        {
+            SimpleEQAudioProcessor processor;
+            processor.setNeutralStageTolerance(-1.0f);
+
+            expect(renderChangesInput(processor));
+        }
+
+        beginTest("A section coming back into the plan starts from rest");
+        {
+            BiquadCascade<float, 1> cascade;
+            cascade.prepare({ 48000.0, 64, 1 });
+            cascade.setCoefficients(0, designPeakFilter(1000.0f, 1.0f, 12.0f, 48000.0));
+            cascade.setBypassed(0, false);
+
+            std::array<float, 64> samples {};
+            samples[0] = 1.0f;
+            auto* channel = samples.data();
+            juce::dsp::AudioBlock<float> block(&channel, 1, samples.size());
+
+            cascade.process(juce::dsp::ProcessContextReplacing<float>(block));
+            expect(! cascade.isStateSilent());
+
+            // [LUCAS] : Like the processor, nothing is processed while the cascade is a pass-through
+            cascade.setBypassed(0, true);
+            expect(cascade.isPassThrough());
+
+            // [LUCAS] : Without the reset, the section would ring out its old state into the silence
+            samples.fill(0.0f);
+            cascade.setBypassed(0, false);
+            cascade.process(juce::dsp::ProcessContextReplacing<float>(block));
+
+            for (auto sample : samples)
+                expectEquals(sample, 0.0f);
+        }
+
+        beginTest("A peak filter made neutral and back does not ring out its old state");
+        {
+            constexpr double sampleRate = 48000.0;
+            constexpr int blockSize = 256;
+
+            SimpleEQAudioProcessor processor;
+            processor.setSilenceDetectionEnabled(false);
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+
+            auto* peakGain = processor.parametersManager.getParameter("Peak Gain");
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midiMessages;
+            juce::Random random(3);
+
+            // [LUCAS] : Noise through a +6 dB peak leaves energy in its state
+            peakGain->setValueNotifyingHost(peakGain->convertTo0to1(6.0f));
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+            processor.processBlock(buffer, midiMessages);
+
+            // [LUCAS] : A block through the pass-through branch, which does not process the chain
+            peakGain->setValueNotifyingHost(peakGain->convertTo0to1(0.0f));
+            processor.processBlock(buffer, midiMessages);
+
+            // [LUCAS] : The peak is back, and must start from rest on silence
+            peakGain->setValueNotifyingHost(peakGain->convertTo0to1(6.0f));
+            buffer.clear();
+            processor.processBlock(buffer, midiMessages);
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    expectEquals(buffer.getSample(channel, i), 0.0f);
+
+            processor.releaseResources();
+        }
+
+        beginTest("A smoothed cut stays in the chain until its ramp is done");
+        {
+            for (auto topology : { FilterTopology::transposedDirectForm2, FilterTopology::stateVariable })
+            {
+                SimpleEQAudioProcessor processor;
+                auto* lowCutFreq = processor.parametersManager.getParameter("LowCut Freq");
+                lowCutFreq->setValueNotifyingHost(lowCutFreq->convertTo0to1(200.0f));
+
+                processor.setCoefficientUpdateMode(CoefficientUpdateMode::smoothed);
+                processor.setSmoothingTopology(topology);
+                processor.setSilenceDetectionEnabled(false);
+                processor.setRateAndBufferSizeDetails(48000.0, 256);
+                processor.prepareToPlay(48000.0, 256);
+
+                juce::AudioBuffer<float> buffer(2, 256);
+                juce::MidiBuffer midiMessages;
+                buffer.clear();
+
+                // [LUCAS] : The cut ramps down to the end of its range, where it is neutral
+                lowCutFreq->setValueNotifyingHost(lowCutFreq->convertTo0to1(minCutFrequency));
+                processor.processBlock(buffer, midiMessages);
+
+                const auto* coefficients = processor.getResponseCoefficients();
+                expect(coefficients != nullptr && ! coefficients->lowCutNeutral);
+
+                const auto rampLengthInBlocks = (int) std::ceil(processor.getSmoothingRampLength() * 48000.0 / 256.0);
+
+                for (int block = 0; block < rampLengthInBlocks; ++block)
+                    processor.processBlock(buffer, midiMessages);
+
+                coefficients = processor.getResponseCoefficients();
+                expect(coefficients != nullptr && coefficients->lowCutNeutral);
+
+                processor.releaseResources();
+            }
+        }
+
+        beginTest("Both phase modes leave the same filters out of the response");
+        {
+            std::array<const CoefficientSet*, 2> sets {};
+            std::array<CoefficientSet, 2> copies;
+            std::array<SimpleEQAudioProcessor, 2> processors;
+
+            for (size_t i = 0; i < processors.size(); ++i)
+            {
+                auto& processor = processors[i];
+
+                // [LUCAS] : A +0.5 dB peak is neutral within 1 dB, while the low cut is not
+                auto* peakGain = processor.parametersManager.getParameter("Peak Gain");
+                auto* lowCutFreq = processor.parametersManager.getParameter("LowCut Freq");
+                peakGain->setValueNotifyingHost(peakGain->convertTo0to1(0.5f));
+                lowCutFreq->setValueNotifyingHost(lowCutFreq->convertTo0to1(200.0f));
+
+                processor.setNeutralStageTolerance(1.0f);
+                processor.setPhaseMode(i == 0 ? PhaseMode::minimumPhase : PhaseMode::linearPhase);
+                processor.setRateAndBufferSizeDetails(48000.0, 256);
+                processor.prepareToPlay(48000.0, 256);
+
+                sets[i] = processor.getResponseCoefficients();
+                expect(sets[i] != nullptr);
+
+                if (sets[i] != nullptr)
+                    copies[i] = *sets[i];
+
+                processor.releaseResources();
+            }
+
+            if (sets[0] != nullptr && sets[1] != nullptr)
+            {
+                for (const auto& set : copies)
+                {
+                    expect(set.peakNeutral);
+                    expect(! set.lowCutNeutral);
+                    expect(set.highCutNeutral);
+                }
+
+                for (auto frequency : { 50.0, 200.0, 750.0, 5000.0 })
+                    expectWithinAbsoluteError(getMagnitudeForFrequency(copies[1], frequency, 48000.0),
+                                              getMagnitudeForFrequency(copies[0], frequency, 48000.0), 1.0e-9);
+            }
+        }
+    }
+
+private:
+    // [LUCAS] : Processes a block of noise, and tells if it came out different
+    static bool renderChangesInput(SimpleEQAudioProcessor& processor)
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 512;
+
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::Random random(42);
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        juce::AudioBuffer<float> input;
+        input.makeCopyOf(buffer);
+
+        juce::MidiBuffer midiMessages;
+        processor.processBlock(buffer, midiMessages);
+        processor.releaseResources();
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                if (buffer.getSample(channel, i) != input.getSample(channel, i))
+                    return (true);
+
+        return (false);
+    }
+};
+
+static NeutralStageTests neutralStageTests;
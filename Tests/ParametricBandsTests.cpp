@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the parametric bands.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <complex>
+#include "ParametricBands.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+class ParametricBandsTests : public juce::UnitTest
+{
+public:
+    ParametricBandsTests() : juce::UnitTest("Parametric bands", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+
+        beginTest("Both topologies design the same bands");
+        {
+            for (auto type : { Band_Peak, Band_LowShelf, Band_HighShelf, Band_Notch })
+            {
+                ParametricBands<1>::Settings settings;
+                settings[0] = { true, type, 1500.f, -9.f, 0.8f };
+
+                BiquadCascade<double, 1> biquad, stateVariable;
+                stateVariable.setTopology(FilterTopology::stateVariable);
+
+                ParametricBands<1> biquadBands, stateVariableBands;
+                biquadBands.design(settings, sampleRate, biquad.getTopology(), 0.05f, false);
+                stateVariableBands.design(settings, sampleRate, stateVariable.getTopology(), 0.05f, false);
+
+                const auto biquadResponse = renderImpulse(biquad, biquadBands);
+                const auto stateVariableResponse = renderImpulse(stateVariable, stateVariableBands);
+
+                for (size_t i = 0; i < biquadResponse.size(); ++i)
+                    expectWithinAbsoluteError(stateVariableResponse[i], biquadResponse[i], 1.0e-9);
+            }
+        }
+
+        beginTest("Disabled and flat bands are bypassed, notches are not");
+        {
+            ParametricBands<4>::Settings settings;
+            settings[0] = { false, Band_Peak, 1000.f, 6.f, 1.f };
+            settings[1] = { true, Band_Peak, 1000.f, 0.f, 1.f };
+            settings[2] = { true, Band_Notch, 1000.f, 0.f, 1.f };
+            settings[3] = { true, Band_LowShelf, 200.f, 3.f, 0.7f };
+
+            BiquadCascade<float, 4> cascade;
+            ParametricBands<4> bands;
+
+            bands.design(settings, sampleRate, cascade.getTopology(), 0.05f, false);
+            bands.apply(cascade, 0);
+
+            expect(cascade.isBypassed(0));
+            expect(cascade.isBypassed(1));
+            expect(! cascade.isBypassed(2));
+            expect(! cascade.isBypassed(3));
+            expectEquals(bands.getNumActiveBands(), 2);
+        }
+
+        beginTest("Only the bands that changed are designed again");
+        {
+            ParametricBands<4>::Settings settings;
+            ParametricBands<4> bands;
+
+            expectEquals((int) bands.design(settings, sampleRate, FilterTopology::transposedDirectForm2, 0.05f, false).count(), 4);
+            expectEquals((int) bands.design(settings, sampleRate, FilterTopology::transposedDirectForm2, 0.05f, false).count(), 0);
+
+            settings[2].enabled = true;
+            settings[2].gainInDb = 3.f;
+
+            const auto designed = bands.design(settings, sampleRate, FilterTopology::transposedDirectForm2, 0.05f, false);
+            expectEquals((int) designed.count(), 1);
+            expect(designed.test(2));
+
+            expectEquals((int) bands.design(settings, 96000.0, FilterTopology::transposedDirectForm2, 0.05f, false).count(), 4);
+        }
+
+        beginTest("The linear phase kernel includes the enabled bands");
+        {
+            constexpr int firLength = 4096;
+
+            ChainSettings chainSettings;
+            chainSettings.peakFreq = 750.f;
+            chainSettings.lowCutFreq = minCutFrequency;
+            chainSettings.highCutFreq = maxCutFrequency;
+
+            std::array<BandSettings, numParametricBands> bandSettings;
+            bandSettings[0] = { true, Band_Peak, 1000.f, 12.f, 1.f };
+
+            CoefficientSet set;
+            designPeakCoefficients(set, chainSettings, sampleRate);
+            designLowCutCoefficients(set, chainSettings, sampleRate);
+            designHighCutCoefficients(set, chainSettings, sampleRate);
+            designParametricBands(set, bandSettings, sampleRate, -1.0f);
+
+            const auto kernel = LinearPhaseEngine::designKernel(set, sampleRate, firLength);
+
+            // [LUCAS] : The magnitude of the kernel at the centre of the band
+            const auto omega = juce::MathConstants<double>::twoPi * 1000.0 / sampleRate;
+            std::complex<double> response;
+
+            for (int i = 0; i < firLength; ++i)
+                response += (double) kernel.getSample(0, i) * std::polar(1.0, -omega * i);
+
+            expectWithinAbsoluteError(juce::Decibels::gainToDecibels(std::abs(response)), 12.0, 0.1);
+        }
+
+        beginTest("The response of the processor includes the enabled bands in both phase modes");
+        {
+            for (auto phaseMode : { PhaseMode::minimumPhase, PhaseMode::linearPhase })
+            {
+                SimpleEQAudioProcessor processor;
+
+                auto* enabled = processor.parametersManager.getParameter(getBandParameterId(3, "Enabled"));
+                auto* gain = processor.parametersManager.getParameter(getBandParameterId(3, "Gain"));
+                enabled->setValueNotifyingHost(1.0f);
+                gain->setValueNotifyingHost(gain->convertTo0to1(6.0f));
+
+                processor.setPhaseMode(phaseMode);
+                processor.setRateAndBufferSizeDetails(sampleRate, 256);
+                processor.prepareToPlay(sampleRate, 256);
+
+                const auto* coefficients = processor.getResponseCoefficients();
+
+                expect(coefficients != nullptr);
+
+                if (coefficients != nullptr)
+                    expect(coefficients->activeBands.test(2));
+
+                processor.releaseResources();
+            }
+        }
+
+        beginTest("The bands ramp towards their settings in the smoothed mode");
+        {
+            for (auto topology : { FilterTopology::transposedDirectForm2, FilterTopology::stateVariable })
+            {
+                SimpleEQAudioProcessor processor;
+                processor.setCoefficientUpdateMode(CoefficientUpdateMode::smoothed);
+                processor.setSmoothingTopology(topology);
+
+                auto* enabled = processor.parametersManager.getParameter(getBandParameterId(3, "Enabled"));
+                auto* gain = processor.parametersManager.getParameter(getBandParameterId(3, "Gain"));
+                const auto frequency = (double) processor.parametersManager.getRawParameterValue(getBandParameterId(3, "Freq"))->load();
+                enabled->setValueNotifyingHost(1.0f);
+
+                processor.setRateAndBufferSizeDetails(sampleRate, 256);
+                processor.prepareToPlay(sampleRate, 256);
+
+                // [LUCAS] : The gain ramps linearly in decibels, so after one block it is a fraction of the way
+                gain->setValueNotifyingHost(gain->convertTo0to1(12.0f));
+                const auto rampLengthInSamples = processor.getSmoothingRampLength() * sampleRate;
+                expectWithinAbsoluteError(renderBandGainInDb(processor, 2, frequency), 12.0 * 256.0 / rampLengthInSamples, 0.01);
+
+                // [LUCAS] : And at the gain of the parameter once the ramp is done
+                for (int block = 0; block < 10; ++block)
+                    renderBandGainInDb(processor, 2, frequency);
+
+                expectWithinAbsoluteError(renderBandGainInDb(processor, 2, frequency), 12.0, 0.01);
+
+                processor.releaseResources();
+            }
+        }
+
+        beginTest("Every band has its parameters");
+        {
+            SimpleEQAudioProcessor processor;
+
+            for (int band = 1; band <= numParametricBands; ++band)
+                for (const auto* name : { "Enabled", "Type", "Freq", "Gain", "Quality" })
+                    expect(processor.parametersManager.getParameter(getBandParameterId(band, name)) != nullptr);
+        }
+    }
+
+private:
+    // [LUCAS] : Processes a block of noise, and returns the gain of a band in the response of the processor
+    double renderBandGainInDb(SimpleEQAudioProcessor& processor, size_t band, double frequency)
+    {
+        juce::AudioBuffer<float> buffer(2, 256);
+        juce::MidiBuffer midiMessages;
+        juce::Random random(5);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        processor.processBlock(buffer, midiMessages);
+
+        const auto* coefficients = processor.getResponseCoefficients();
+        expect(coefficients != nullptr && coefficients->activeBands.test(band));
+
+        if (coefficients == nullptr || ! coefficients->activeBands.test(band))
+            return (0.0);
+
+        return (juce::Decibels::gainToDecibels(getMagnitudeForFrequency(coefficients->bands[band], frequency, processor.getSampleRate())));
+    }
+
+    template<typename CascadeType, typename BandsType>
+    static std::array<double, 256> renderImpulse(CascadeType& cascade, const BandsType& bands)
+    {
+        cascade.prepare({ 48000.0, 256, 1 });
+        bands.apply(cascade, 0);
+
+        std::array<double, 256> samples {};
+        samples[0] = 1.0;
+        auto* channel = samples.data();
+        juce::dsp::AudioBlock<double> block(&channel, 1, samples.size());
+
+        cascade.process(juce::dsp::ProcessContextReplacing<double>(block));
+
+        return (samples);
+    }
+};
+
+static ParametricBandsTests parametricBandsTests;
@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the saved and restored state of the plugin.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <thread>
+#include "PluginProcessor.h"
+#include "PluginState.h"
+
+//==============================================================================
+class PluginStateTests : public juce::UnitTest
+{
+public:
+    PluginStateTests() : juce::UnitTest("Plugin state", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        SimpleEQAudioProcessor source;
+        set(source, "LowCut Freq", 120.0f);
+        set(source, "HighCut Freq", 9000.0f);
+        set(source, "Peak Freq", 2500.0f);
+        set(source, "Peak Gain", -7.5f);
+        set(source, "Peak Quality", 3.0f);
+        set(source, "LowCut Slope", 2.0f);
+        set(source, "HighCut Slope", 1.0f);
+        set(source, "Band 2 Enabled", 1.0f);
+        set(source, "Band 2 Type", 1.0f);
+        set(source, "Band 2 Gain", 4.5f);
+
+        beginTest("The binary state restores every parameter");
+        {
+            juce::MemoryBlock state;
+            source.getStateInformation(state);
+
+            expectEquals((int) state.getSize(), 8 + PluginState::getParameterIds().size() * 4);
+
+            SimpleEQAudioProcessor destination;
+            destination.setStateInformation(state.getData(), (int) state.getSize());
+
+            expectParametersEqual(source, destination);
+        }
+
+        beginTest("The XML of older sessions is still restored");
+        {
+            juce::MemoryBlock state;
+            juce::AudioProcessor::copyXmlToBinary(*source.parametersManager.copyState().createXml(), state);
+
+            SimpleEQAudioProcessor destination;
+            destination.setStateInformation(state.getData(), (int) state.getSize());
+
+            expectParametersEqual(source, destination);
+        }
+
+        beginTest("Parameters missing from the state get their default value");
+        {
+            juce::MemoryBlock state;
+            source.getStateInformation(state);
+
+            // [LUCAS] : Keeps the two cut frequencies only
+            state.setSize(8 + 2 * 4);
+            state[6] = 2;
+            state[7] = 0;
+
+            SimpleEQAudioProcessor destination;
+            set(destination, "Peak Gain", 12.0f);
+            destination.setStateInformation(state.getData(), (int) state.getSize());
+
+            expectEquals(get(destination, "HighCut Freq"), 9000.0f);
+            expectEquals(get(destination, "Peak Gain"), 0.0f);
+        }
+
+        beginTest("Unknown data leaves the parameters alone");
+        {
+            SimpleEQAudioProcessor destination;
+            set(destination, "Peak Gain", 12.0f);
+
+            const char garbage[] = "not a state";
+            destination.setStateInformation(garbage, (int) sizeof(garbage));
+
+            expectEquals(get(destination, "Peak Gain"), 12.0f);
+        }
+
+        beginTest("The first block after a restore sounds like the restored settings");
+        {
+            expectRestoredSettingsHeard(source, CoefficientUpdateMode::audioThread);
+        }
+
+        beginTest("The designer thread does not override a restore with older settings");
+        {
+            expectRestoredSettingsHeard(source, CoefficientUpdateMode::backgroundThread);
+        }
+
+        beginTest("The linear phase kernel is never designed from a half restored state");
+        {
+            expectWholeStatesDesigned(source);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    static void set(SimpleEQAudioProcessor& processor, const juce::String& parameterId, float value)
+    {
+        auto* parameter = processor.parametersManager.getParameter(parameterId);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    static float get(SimpleEQAudioProcessor& processor, const juce::String& parameterId)
+    {
+        return (processor.parametersManager.getRawParameterValue(parameterId)->load());
+    }
+
+    static void prepare(SimpleEQAudioProcessor& processor)
+    {
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    // [LUCAS] : Restores the state of source into a prepared processor, and compares its first blocks
+    //           with a processor prepared after the restore
+    void expectRestoredSettingsHeard(SimpleEQAudioProcessor& source, CoefficientUpdateMode updateMode)
+    {
+        juce::MemoryBlock state;
+        source.getStateInformation(state);
+
+        SimpleEQAudioProcessor restored;
+        restored.setCoefficientUpdateMode(updateMode);
+        prepare(restored);
+
+        // [LUCAS] : Lets the designer thread publish the set of the settings before the restore
+        if (updateMode == CoefficientUpdateMode::backgroundThread)
+            juce::Thread::sleep(50);
+
+        restored.setStateInformation(state.getData(), (int) state.getSize());
+
+        SimpleEQAudioProcessor reference;
+        reference.setStateInformation(state.getData(), (int) state.getSize());
+        prepare(reference);
+
+        juce::AudioBuffer<float> restoredBuffer(2, blockSize), referenceBuffer(2, blockSize);
+        juce::MidiBuffer midiMessages;
+        juce::Random random(7);
+
+        for (int block = 0; block < 4; ++block)
+        {
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    restoredBuffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+            referenceBuffer.makeCopyOf(restoredBuffer);
+
+            restored.processBlock(restoredBuffer, midiMessages);
+            reference.processBlock(referenceBuffer, midiMessages);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    expectEquals(restoredBuffer.getSample(channel, i), referenceBuffer.getSample(channel, i));
+        }
+
+        restored.releaseResources();
+    }
+
+    // [LUCAS] : The filters of a set that tell two states apart
+    static std::array<double, 5> getStateFingerprint(const CoefficientSet& set)
+    {
+        return { set.peak.b0, set.lowCut[0].b0, set.highCut[0].b0,
+                 (double) set.lowCutSlope, (double) set.activeBands.to_ulong() };
+    }
+
+    static std::array<double, 5> getStateFingerprint(SimpleEQAudioProcessor& processor)
+    {
+        CoefficientSet set;
+        const auto chainSettings = getChainSettings(processor.parametersManager);
+        designPeakCoefficients(set, chainSettings, sampleRate);
+        designLowCutCoefficients(set, chainSettings, sampleRate);
+        designHighCutCoefficients(set, chainSettings, sampleRate);
+
+        // [LUCAS] : Only the band of the source is enabled, with a gain far from neutral
+        set.activeBands.set(1, get(processor, "Band 2 Enabled") > 0.5f);
+
+        return (getStateFingerprint(set));
+    }
+
+    // [LUCAS] : Restores two states in turn into a linear phase processor, while another thread
+    //           checks that every kernel it designs is the one of either state, never a mix of both
+    void expectWholeStatesDesigned(SimpleEQAudioProcessor& source)
+    {
+        juce::MemoryBlock sourceState, defaultState;
+        source.getStateInformation(sourceState);
+
+        SimpleEQAudioProcessor restored;
+        restored.getStateInformation(defaultState);
+        restored.setPhaseMode(PhaseMode::linearPhase);
+        prepare(restored);
+
+        SimpleEQAudioProcessor defaults;
+        const auto sourceFingerprint = getStateFingerprint(source);
+        const auto defaultFingerprint = getStateFingerprint(defaults);
+
+        std::atomic<bool> done { false };
+        std::atomic<int> numMixedSets { 0 }, numChanges { 0 };
+
+        std::thread reader([&]
+        {
+            std::array<double, 5> lastFingerprint {};
+
+            while (! done.load())
+            {
+                if (const auto* set = restored.getResponseCoefficients(); set != nullptr)
+                {
+                    const auto fingerprint = getStateFingerprint(*set);
+
+                    if (fingerprint != lastFingerprint)
+                    {
+                        if (fingerprint != sourceFingerprint && fingerprint != defaultFingerprint)
+                            ++numMixedSets;
+
+                        ++numChanges;
+                        lastFingerprint = fingerprint;
+                    }
+                }
+
+                juce::Thread::yield();
+            }
+        });
+
+        for (int i = 0; i < 40; ++i)
+        {
+            const auto& state = (i % 2 == 0 ? sourceState : defaultState);
+            restored.setStateInformation(state.getData(), (int) state.getSize());
+            juce::Thread::sleep(7);
+        }
+
+        juce::Thread::sleep(50);
+        done = true;
+        reader.join();
+
+        expectGreaterThan(numChanges.load(), 1);
+        expectEquals(numMixedSets.load(), 0);
+
+        restored.releaseResources();
+    }
+
+    void expectParametersEqual(SimpleEQAudioProcessor& a, SimpleEQAudioProcessor& b)
+    {
+        for (const auto& parameterId : PluginState::getParameterIds())
+            expectEquals(get(a, parameterId), get(b, parameterId), parameterId);
+    }
+};
+
+static PluginStateTests pluginStateTests;
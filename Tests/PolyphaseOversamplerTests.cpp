@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the polyphase oversampler of the peak filter.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "PolyphaseOversampler.h"
+
+//==============================================================================
+class PolyphaseOversamplerTests : public juce::UnitTest
+{
+public:
+    PolyphaseOversamplerTests() : juce::UnitTest("Polyphase oversampler", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        for (auto phase : { PhaseMode::linearPhase, PhaseMode::minimumPhase })
+        {
+            const juce::String name = (phase == PhaseMode::linearPhase ? "linear phase" : "minimum phase");
+
+            for (int factor : { 2, 4 })
+            {
+                beginTest("Going up and down keeps the band and delays it by the latency : "
+                          + name + ", x" + juce::String(factor));
+                {
+                    PolyphaseOversampler<float> oversampler;
+                    oversampler.prepare(1, blockSize, factor, phase);
+
+                    const auto latency = oversampler.getLatencyInSamples();
+                    expectGreaterThan(latency, 0.0);
+
+                    for (auto frequency : { 0.01, 0.1, 0.4 })
+                    {
+                        const auto response = measure(oversampler, frequency, nullptr);
+
+                        expectWithinAbsoluteError(std::abs(response), 1.0, 0.01);
+
+                        // [LUCAS] : The minimum phase delay is only flat at low frequencies
+                        if (phase == PhaseMode::linearPhase || frequency < 0.05)
+                            expectWithinAbsoluteError(getDelay(response, frequency, latency), latency, 0.05);
+                    }
+                }
+
+                beginTest("The images of the upsampling are rejected : " + name + ", x" + juce::String(factor));
+                {
+                    PolyphaseOversampler<double> oversampler;
+                    oversampler.prepare(1, blockSize, factor, phase);
+
+                    for (auto frequency : { 0.1, 0.3, 0.4 })
+                    {
+                        std::complex<double> image;
+                        measure(oversampler, frequency, &image);
+
+                        expectLessThan(juce::Decibels::gainToDecibels(std::abs(image)), -80.0);
+                    }
+                }
+            }
+        }
+
+        beginTest("The processor reports the latency of the oversampled peak, and delays the audio by it");
+        {
+            SimpleEQAudioProcessor processor;
+            processor.setPeakOversamplingFactor(2);
+            processor.setPeakOversamplingPhase(PhaseMode::linearPhase);
+            processor.setRateAndBufferSizeDetails(48000.0, blockSize);
+            processor.prepareToPlay(48000.0, blockSize);
+
+            const auto latency = processor.getLatencySamples();
+            expectGreaterThan(latency, 0);
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midiMessages;
+            std::vector<float> input, output;
+
+            for (int block = 0; block < 8; ++block)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    const auto sample = (float) std::sin(0.02 * juce::MathConstants<double>::twoPi * (block * blockSize + i));
+
+                    input.push_back(sample);
+                    buffer.setSample(0, i, sample);
+                    buffer.setSample(1, i, sample);
+                }
+
+                processor.processBlock(buffer, midiMessages);
+
+                for (int i = 0; i < blockSize; ++i)
+                    output.push_back(buffer.getSample(0, i));
+            }
+
+            processor.releaseResources();
+
+            // [LUCAS] : The default peak is neutral, so only the half-band filters are heard
+            for (size_t i = (size_t) blockSize; i < output.size(); ++i)
+                expectWithinAbsoluteError(output[i], input[i - (size_t) latency], 1.0e-3f);
+
+            processor.setPeakOversamplingFactor(1);
+            processor.prepareToPlay(48000.0, blockSize);
+            expectEquals(processor.getLatencySamples(), 0);
+        }
+    }
+
+private:
+    static constexpr int blockSize = 64;
+    static constexpr int numBlocks = 256;
+
+    // [LUCAS] : Runs a sine of frequency (relative to the base rate) up and down, and returns
+    //           the complex response of the round trip, measured over the second half.
+    //           The image of the sine in the upsampled signal goes into image, if given.
+    template<typename SampleType>
+    static std::complex<double> measure(PolyphaseOversampler<SampleType>& oversampler, double frequency, std::complex<double>* image)
+    {
+        oversampler.reset();
+
+        const auto factor = oversampler.getFactor();
+        const auto imageFrequency = (1.0 - frequency) / (double) factor;
+        const auto numSamples = blockSize * numBlocks;
+
+        std::array<SampleType, blockSize> samples;
+        std::complex<double> response, imageResponse;
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+                samples[(size_t) i] = (SampleType) std::sin(juce::MathConstants<double>::twoPi * frequency * (start + i));
+
+            auto* channel = samples.data();
+            juce::dsp::AudioBlock<SampleType> block(&channel, 1, (size_t) blockSize);
+
+            auto oversampledBlock = oversampler.processSamplesUp(block);
+
+            if (start >= numSamples / 2)
+                for (int i = 0; i < blockSize * factor; ++i)
+                    imageResponse += (double) oversampledBlock.getSample(0, i)
+                                   * std::polar(1.0, -juce::MathConstants<double>::twoPi * imageFrequency * (start * factor + i));
+
+            oversampler.processSamplesDown(block);
+
+            if (start >= numSamples / 2)
+                for (int i = 0; i < blockSize; ++i)
+                    response += (double) samples[(size_t) i]
+                              * std::polar(1.0, -juce::MathConstants<double>::twoPi * frequency * (start + i));
+        }
+
+        if (image != nullptr)
+            *image = imageResponse * (2.0 / (numSamples / 2 * factor));
+
+        // [LUCAS] : The sine is the imaginary part of the phasor, a quarter turn behind it
+        return (response * (2.0 / (numSamples / 2)) * std::complex<double>(0.0, 1.0));
+    }
+
+    // [LUCAS] : Returns the delay of the response in samples, the one closest to expectedDelay
+    static double getDelay(std::complex<double> response, double frequency, double expectedDelay)
+    {
+        const auto period = 1.0 / frequency;
+        const auto delay = -std::arg(response) / (juce::MathConstants<double>::twoPi * frequency);
+
+        return (delay + period * std::round((expectedDelay - delay) / period));
+    }
+};
+
+static PolyphaseOversamplerTests polyphaseOversamplerTests;
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    This file contains the real-time safety tests : the processor is driven
+    with automation in every mode, and no allocation or lock may happen
+    inside processBlock. It only runs in the SimpleEQRealtimeTests target,
+    which is built with SIMPLEEQ_REALTIME_AUDIT=1.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "RealtimeSafety.h"
+
+//==============================================================================
+class RealtimeSafetyTests : public juce::UnitTest
+{
+public:
+    RealtimeSafetyTests() : juce::UnitTest("Real-time safety", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("The audit is compiled in");
+        {
+            expect(RealtimeSafety::isAuditEnabled(), "SIMPLEEQ_REALTIME_AUDIT is not set for this target");
+        }
+
+        // [LUCAS] : Makes sure the interceptors are linked in, or every next test would pass for nothing
+        beginTest("The audit catches an allocation and a lock");
+        {
+            RealtimeSafety::resetViolations();
+
+            juce::CriticalSection lock;
+            std::unique_ptr<std::vector<float>> allocated;
+
+            {
+                RealtimeSafety::ScopedAudioThread audioThread;
+
+                allocated = std::make_unique<std::vector<float>>(64);
+                const juce::ScopedLock scopedLock(lock);
+            }
+
+            expectGreaterThan(RealtimeSafety::getNumViolations(RealtimeSafety::Violation_Allocation), 0);
+           #if JUCE_LINUX
+            expectGreaterThan(RealtimeSafety::getNumViolations(RealtimeSafety::Violation_Lock), 0);
+           #endif
+
+            RealtimeSafety::resetViolations();
+        }
+
+        const std::vector<Setup> setups
+        {
+            { "audio thread designs",      CoefficientUpdateMode::audioThread,      FilterTopology::transposedDirectForm2, PhaseMode::minimumPhase, false },
+            { "background thread designs", CoefficientUpdateMode::backgroundThread, FilterTopology::transposedDirectForm2, PhaseMode::minimumPhase, false },
+            { "smoothed biquads",          CoefficientUpdateMode::smoothed,         FilterTopology::transposedDirectForm2, PhaseMode::minimumPhase, false },
+            { "smoothed state variables",  CoefficientUpdateMode::smoothed,         FilterTopology::stateVariable,         PhaseMode::minimumPhase, false },
+            { "linear phase",              CoefficientUpdateMode::audioThread,      FilterTopology::transposedDirectForm2, PhaseMode::linearPhase,  false },
+            { "double precision",          CoefficientUpdateMode::audioThread,      FilterTopology::transposedDirectForm2, PhaseMode::minimumPhase, true },
+            { "oversampled peak",          CoefficientUpdateMode::smoothed,         FilterTopology::transposedDirectForm2, PhaseMode::minimumPhase, false, 4 }
+        };
+
+        for (const auto& setup : setups)
+        {
+            beginTest(juce::String("No allocation or lock in processBlock : ") + setup.name);
+
+            if (setup.doublePrecision)
+                expectNoViolations(setup, juce::AudioBuffer<double>());
+            else
+                expectNoViolations(setup, juce::AudioBuffer<float>());
+        }
+    }
+
+private:
+    struct Setup
+    {
+        const char* name;
+        CoefficientUpdateMode updateMode;
+        FilterTopology topology;
+        PhaseMode phaseMode;
+        bool doublePrecision;
+        int peakOversamplingFactor { 1 };
+    };
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int numBlocks = 400;
+
+    // [LUCAS] : Every parameter jumps on every block, and a saved state is restored
+    //           every 50 blocks, all from the test thread, between two blocks.
+    //           Only processBlock runs as the audio thread.
+    template<typename SampleType>
+    void expectNoViolations(const Setup& setup, juce::AudioBuffer<SampleType> buffer)
+    {
+        SimpleEQAudioProcessor processor;
+
+        processor.setCoefficientUpdateMode(setup.updateMode);
+        processor.setSmoothingTopology(setup.topology);
+        processor.setPhaseMode(setup.phaseMode);
+        processor.setPeakOversamplingFactor(setup.peakOversamplingFactor);
+        processor.setProcessingPrecision(setup.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                               : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        buffer.setSize(2, blockSize);
+
+        juce::MemoryBlock savedState;
+        processor.getStateInformation(savedState);
+
+        juce::Random random(42);
+        juce::MidiBuffer midiMessages;
+
+        RealtimeSafety::resetViolations();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (auto* parameter : processor.getParameters())
+                parameter->setValueNotifyingHost(random.nextFloat());
+
+            if (block % 50 == 49)
+                processor.setStateInformation(savedState.getData(), (int) savedState.getSize());
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(channel, i, (SampleType) (random.nextFloat() * 2.0f - 1.0f));
+
+            processor.processBlock(buffer, midiMessages);
+
+            // [LUCAS] : Gives the designer threads some time to publish their results
+            if (setup.updateMode == CoefficientUpdateMode::backgroundThread || setup.phaseMode == PhaseMode::linearPhase)
+                juce::Thread::sleep(1);
+        }
+
+        const auto numAllocations = RealtimeSafety::getNumViolations(RealtimeSafety::Violation_Allocation);
+        const auto numDeallocations = RealtimeSafety::getNumViolations(RealtimeSafety::Violation_Deallocation);
+        const auto numLocks = RealtimeSafety::getNumViolations(RealtimeSafety::Violation_Lock);
+
+        processor.releaseResources();
+
+        expectEquals(numAllocations, 0, "allocations");
+        expectEquals(numDeallocations, 0, "deallocations");
+        expectEquals(numLocks, 0, "locks");
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
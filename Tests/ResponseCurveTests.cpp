@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the response curve of the editor.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ResponseCurve.h"
+
+//==============================================================================
+class ResponseCurveTests : public juce::UnitTest
+{
+public:
+    ResponseCurveTests() : juce::UnitTest("Response curve", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int numPoints = 1001;
+
+        ChainSettings settings;
+        settings.lowCutFreq = 20.0f;
+        settings.lowCutSlope = Slope_48;
+        settings.highCutFreq = 15000.0f;
+        settings.highCutSlope = Slope_36;
+        settings.peakFreq = 1000.0f;
+        settings.peakGainInDb = 12.0f;
+        settings.peakQ = 2.0f;
+
+        CoefficientSet set;
+        designPeakCoefficients(set, settings, sampleRate);
+        designLowCutCoefficients(set, settings, sampleRate);
+        designHighCutCoefficients(set, settings, sampleRate);
+
+        ResponseCurve curve;
+        curve.setGrid(numPoints, sampleRate, 20.0f, (float) sampleRate * 0.5f);
+
+        beginTest("The curve matches the magnitude of the chain");
+        {
+            expect(curve.update(set));
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                const auto frequency = (double) curve.getFrequencies()[(size_t) i];
+                const auto reference = juce::Decibels::gainToDecibels(getMagnitudeForFrequency(set, frequency, sampleRate), -200.0);
+
+                // [LUCAS] : Deep in the stop bands, a float is not expected to keep up
+                if (reference > -120.0)
+                    expectWithinAbsoluteError((double) curve.getMagnitudesInDb()[(size_t) i], reference, 0.01);
+            }
+        }
+
+        beginTest("Only the filters that changed are evaluated again");
+        {
+            const auto evaluations = curve.getNumStageEvaluations();
+
+            expect(! curve.update(set));
+            expectEquals(curve.getNumStageEvaluations(), evaluations);
+
+            settings.peakGainInDb = 6.0f;
+            designPeakCoefficients(set, settings, sampleRate);
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            expect(curve.update(set));
+            const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+            expectEquals(curve.getNumStageEvaluations(), evaluations + 1);
+            logMessage("Peak drag update over " + juce::String(numPoints) + " points : "
+                       + juce::String(seconds * 1.0e6, 1) + " us");
+        }
+
+        beginTest("The curve includes the active parametric bands");
+        {
+            const auto evaluations = curve.getNumStageEvaluations();
+
+            std::array<BandSettings, numParametricBands> bandSettings;
+            bandSettings[2] = { true, Band_LowShelf, 200.f, -6.f, 0.7f };
+            bandSettings[5] = { true, Band_Notch, 5000.f, 0.f, 4.f };
+            designParametricBands(set, bandSettings, sampleRate, 0.05f);
+
+            expect(curve.update(set));
+            expectEquals(curve.getNumStageEvaluations(), evaluations + 1);
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                const auto frequency = (double) curve.getFrequencies()[(size_t) i];
+                const auto reference = juce::Decibels::gainToDecibels(getMagnitudeForFrequency(set, frequency, sampleRate), -200.0);
+
+                if (reference > -120.0)
+                    expectWithinAbsoluteError((double) curve.getMagnitudesInDb()[(size_t) i], reference, 0.01);
+            }
+
+            set.activeBands.reset();
+        }
+
+        beginTest("Neutral filters are flat");
+        {
+            set.peakNeutral = true;
+            set.lowCutNeutral = true;
+            set.highCutNeutral = true;
+
+            expect(curve.update(set));
+
+            for (auto decibels : curve.getMagnitudesInDb())
+                expectEquals(decibels, 0.0f);
+
+            expectEquals(getMagnitudeForFrequency(set, 1000.0, sampleRate), 1.0);
+        }
+    }
+};
+
+static ResponseCurveTests responseCurveTests;
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    This file contains the tests of the silence detection : the tail length
+    of the filters, and the blocks skipped once they have decayed.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <complex>
+#include "BiquadCascade.h"
+#include "CascadeDesign.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+class SilenceDetectionTests : public juce::UnitTest
+{
+public:
+    SilenceDetectionTests() : juce::UnitTest("Silence detection", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("The tail of a cascade adds up the decays of its active sections");
+        {
+            const auto peak = designPeakFilter(1000.0f, 4.0f, 12.0f, sampleRate);
+            const auto lowPeak = designPeakFilter(60.0f, 0.7f, -6.0f, sampleRate);
+
+            BiquadCascade<float, 3> cascade;
+            cascade.prepare({ sampleRate, blockSize, 1 });
+            cascade.setCoefficients(0, peak);
+            cascade.setCoefficients(1, lowPeak);
+            cascade.setCoefficients(2, designPeakFilter(5000.0f, 1.0f, 3.0f, sampleRate));
+            cascade.setBypassed(0, false);
+            cascade.setBypassed(1, false);
+            cascade.setBypassed(2, true);
+
+            for (auto level : { 1.0e-6, 1.0e-8 })
+            {
+                const auto expected = std::ceil(std::log(level) / std::log(getPoleRadius(peak))
+                                              + std::log(level) / std::log(getPoleRadius(lowPeak)));
+
+                // [LUCAS] : One sample either way, for the rounding of the radii
+                expectWithinAbsoluteError(cascade.getTailLengthInSamples(level), (int) expected, 1);
+            }
+        }
+
+        beginTest("Skipping the silent blocks does not change the output");
+        {
+            SimpleEQAudioProcessor detecting, reference;
+            reference.setSilenceDetectionEnabled(false);
+
+            for (auto* processor : { &detecting, &reference })
+            {
+                set(*processor, "Peak Gain", 9.0f);
+                set(*processor, "Peak Quality", 6.0f);
+                set(*processor, "LowCut Freq", 80.0f);
+                set(*processor, "LowCut Slope", 3.0f);
+                set(*processor, "Band 1 Enabled", 1.0f);
+                set(*processor, "Band 1 Gain", -4.0f);
+                prepare(*processor);
+            }
+
+            // [LUCAS] : Noise, a gap long enough for the states to be flushed, and the noise again
+            const auto numSilentBlocks = 2 * (int) std::ceil(reference.getTailLengthSeconds() * sampleRate / blockSize) + 4;
+            juce::Random random(11);
+
+            expectIdenticalRenders(detecting, reference, random, 8, 0);
+            expectIdenticalRenders(detecting, reference, random, 0, numSilentBlocks);
+            expectIdenticalRenders(detecting, reference, random, 8, 0);
+
+            detecting.releaseResources();
+            reference.releaseResources();
+        }
+
+        beginTest("The linear phase convolutions are skipped once the whole FIR has been fed silence");
+        {
+            SimpleEQAudioProcessor detecting, reference;
+
+            for (auto* processor : { &detecting, &reference })
+            {
+                set(*processor, "Peak Gain", 9.0f);
+                set(*processor, "HighCut Freq", 4000.0f);
+                processor->setSilenceDetectionEnabled(false);
+                processor->setPhaseMode(PhaseMode::linearPhase);
+                prepare(*processor);
+            }
+
+            // [LUCAS] : Lets both convolutions load their kernel and finish their crossfade,
+            //           which only happens while they process
+            juce::Thread::sleep(200);
+            juce::Random random(13);
+            expectIdenticalRenders(detecting, reference, random, 24, 0);
+
+            detecting.setSilenceDetectionEnabled(true);
+
+            const auto decayLength = detecting.getLinearPhaseFirLength() + detecting.getLatencySamples();
+            const auto numSilentBlocks = decayLength / blockSize + 4;
+
+            expectIdenticalRenders(detecting, reference, random, 4, 0);
+            const auto lastNonZero = expectIdenticalRenders(detecting, reference, random, 0, numSilentBlocks);
+            expectIdenticalRenders(detecting, reference, random, 4, 0);
+
+            // [LUCAS] : The kernel rings past its centre, so an earlier skip would cut it off,
+            //           and it is over by the time the convolutions are skipped
+            expectGreaterThan(lastNonZero, detecting.getLatencySamples());
+            expectLessThan(lastNonZero, decayLength);
+
+            detecting.releaseResources();
+            reference.releaseResources();
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    static void set(SimpleEQAudioProcessor& processor, const juce::String& parameterId, float value)
+    {
+        auto* parameter = processor.parametersManager.getParameter(parameterId);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    static void prepare(SimpleEQAudioProcessor& processor)
+    {
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    // [LUCAS] : The largest radius of the poles of a biquad, the roots of z^2 + a1 z + a2
+    static double getPoleRadius(const BiquadCoefficients& coefficients)
+    {
+        const auto root = std::sqrt(std::complex<double>(coefficients.a1 * coefficients.a1 - 4.0 * coefficients.a2));
+
+        return (juce::jmax(std::abs(-coefficients.a1 + root), std::abs(-coefficients.a1 - root)) / 2.0);
+    }
+
+    // [LUCAS] : Processes numNoiseBlocks blocks of noise then numSilentBlocks silent blocks through both
+    //           processors, and expects the same output. Returns the index of the last sample of the
+    //           reference that is not zero, counted from the first block, or -1 if there is none.
+    int expectIdenticalRenders(SimpleEQAudioProcessor& detecting, SimpleEQAudioProcessor& reference,
+                               juce::Random& random, int numNoiseBlocks, int numSilentBlocks)
+    {
+        juce::AudioBuffer<float> detectingBuffer(2, blockSize), referenceBuffer(2, blockSize);
+        juce::MidiBuffer midiMessages;
+        int lastNonZero = -1;
+
+        for (int block = 0; block < numNoiseBlocks + numSilentBlocks; ++block)
+        {
+            detectingBuffer.clear();
+
+            if (block < numNoiseBlocks)
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < blockSize; ++i)
+                        detectingBuffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+            referenceBuffer.makeCopyOf(detectingBuffer);
+
+            detecting.processBlock(detectingBuffer, midiMessages);
+            reference.processBlock(referenceBuffer, midiMessages);
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    expectEquals(detectingBuffer.getSample(channel, i), referenceBuffer.getSample(channel, i));
+
+                    if (referenceBuffer.getSample(channel, i) != 0.0f)
+                        lastNonZero = juce::jmax(lastNonZero, block * blockSize + i);
+                }
+            }
+        }
+
+        return (lastNonZero);
+    }
+};
+
+static SilenceDetectionTests silenceDetectionTests;
@@ -0,0 +1,542 @@
+/*
+  ==============================================================================
+
+    This file contains the headless batch renderer of SimpleEQAudioProcessor.
+
+    It renders a list of audio files through the EQ with fixed presets,
+    spreading the files over every core with a work-stealing pool of workers.
+    Each worker owns a processor, reused from one file to the next, and a
+    disk thread that reads ahead of the EQ and writes behind it, so the disk
+    and the DSP overlap. It reports the aggregate throughput, and can check
+    that every file is bit-exact with a single-threaded render.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+// [LUCAS] : This structure holds the options of a batch
+struct BatchOptions
+{
+    juce::File jobFile;
+    int numWorkers { juce::SystemStats::getNumCpus() };
+    int blockSize { 4096 };
+    int readAheadSamples { 65536 };
+    bool verify { false };
+    bool json { false };
+};
+
+// [LUCAS] : A file to render, and the state of the preset it is rendered with
+struct RenderJob
+{
+    juce::File input;
+    juce::File output;
+    juce::String preset;
+    juce::MemoryBlock state;
+    juce::int64 inputSize { 0 };
+};
+
+// [LUCAS] : What became of a job. Each one is only written by the worker that rendered it.
+struct JobResult
+{
+    juce::String error;
+    juce::int64 numFrames { 0 };
+    int numChannels { 0 };
+    double sampleRate { 0.0 };
+    double dspSeconds { 0.0 };
+    bool stolen { false };
+    bool verified { false };
+};
+
+static void printUsage()
+{
+    std::cout << "Usage: SimpleEQBatchRenderer --jobs=jobs.json [options]\n"
+                 "  --jobs=jobs.json               the presets and the files to render\n"
+                 "  --threads=N                    number of workers (default : one per core)\n"
+                 "  --block-size=4096              samples per processBlock\n"
+                 "  --read-ahead=65536             samples buffered ahead of and behind the EQ\n"
+                 "  --verify                       render every job again on a single thread,\n"
+                 "                                 in memory, and compare the files byte for byte\n"
+                 "  --json                         print the report as JSON\n"
+                 "\n"
+                 "The job file is JSON, its paths are relative to its own folder :\n"
+                 "  {\n"
+                 "    \"presets\" : { \"vocal\" : { \"LowCut Freq\" : 80, \"Peak Freq\" : 3000, \"Peak Gain\" : 2.5 } },\n"
+                 "    \"jobs\" : [ { \"input\" : \"stems/vox.wav\", \"output\" : \"eq/vox.wav\", \"preset\" : \"vocal\" } ]\n"
+                 "  }\n"
+                 "A preset sets the parameters it lists, the others keep their default value.\n"
+                 "The slopes are given as 0, 1, 2, 3 for 12, 24, 36, 48 dB/Oct.\n";
+}
+
+//==============================================================================
+// [LUCAS] : This function reads the job file, and stores the state of each preset
+//           as getStateInformation writes it, so a worker loads it like a host would
+static bool loadJobs(const juce::File& jobFile, std::vector<RenderJob>& jobs, juce::String& error)
+{
+    const auto json = juce::JSON::parse(jobFile.loadFileAsString());
+
+    if (! json.isObject())
+    {
+        error = "Cannot parse " + jobFile.getFullPathName();
+        return (false);
+    }
+
+    std::map<juce::String, juce::MemoryBlock> presetStates;
+
+    // [LUCAS] : The preset of a job that names none
+    {
+        SimpleEQAudioProcessor presetProcessor;
+        presetProcessor.getStateInformation(presetStates[juce::String()]);
+    }
+
+    if (auto* presets = json["presets"].getDynamicObject())
+    {
+        for (const auto& preset : presets->getProperties())
+        {
+            SimpleEQAudioProcessor presetProcessor;
+
+            if (auto* values = preset.value.getDynamicObject())
+            {
+                for (const auto& value : values->getProperties())
+                {
+                    auto* parameter = presetProcessor.parametersManager.getParameter(value.name.toString());
+
+                    if (parameter == nullptr)
+                    {
+                        error = "Unknown parameter \"" + value.name.toString() + "\" in preset \"" + preset.name.toString() + "\"";
+                        return (false);
+                    }
+
+                    parameter->setValueNotifyingHost(parameter->convertTo0to1((float) value.value));
+                }
+            }
+
+            presetProcessor.getStateInformation(presetStates[preset.name.toString()]);
+        }
+    }
+
+    const auto folder = jobFile.getParentDirectory();
+
+    if (auto* jobArray = json["jobs"].getArray())
+    {
+        for (const auto& item : *jobArray)
+        {
+            RenderJob job;
+
+            job.input = folder.getChildFile(item["input"].toString());
+            job.output = folder.getChildFile(item["output"].toString());
+            job.preset = item["preset"].toString();
+            job.inputSize = job.input.getSize();
+
+            const auto state = presetStates.find(job.preset);
+
+            if (state == presetStates.end())
+            {
+                error = "Unknown preset \"" + job.preset + "\" for " + job.input.getFullPathName();
+                return (false);
+            }
+
+            job.state = state->second;
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    if (jobs.empty())
+    {
+        error = "No job in " + jobFile.getFullPathName();
+        return (false);
+    }
+
+    return (true);
+}
+
+//==============================================================================
+// [LUCAS] : This function renders a job through the processor.
+//           With an I/O thread, the file is read ahead and written behind on that thread.
+//           Without one, it is read and written in place, into destination if given.
+//           Returns an error message, or an empty string once the job is done.
+static juce::String renderJob(SimpleEQAudioProcessor& processor,
+                              juce::AudioFormatManager& formatManager,
+                              const RenderJob& job,
+                              const BatchOptions& options,
+                              juce::TimeSliceThread* ioThread,
+                              std::unique_ptr<juce::OutputStream> destination,
+                              JobResult& result)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(job.input));
+
+    if (reader == nullptr)
+        return ("Cannot read " + job.input.getFullPathName());
+
+    const auto numChannels = (int) reader->numChannels;
+    const auto sampleRate = reader->sampleRate;
+    const auto numFrames = reader->lengthInSamples;
+
+    auto* format = formatManager.findFormatForFileExtension(job.output.getFileExtension());
+
+    if (format == nullptr)
+        return ("No audio format writes " + job.output.getFileName());
+
+    // [LUCAS] : Keeps the bit depth of the input when the output format has it
+    const auto bitDepths = format->getPossibleBitDepths();
+    const auto inputBitDepth = (int) reader->bitsPerSample;
+    const auto bitDepth = bitDepths.contains(inputBitDepth) ? inputBitDepth : bitDepths.getLast();
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+    layout.outputBuses.add(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+
+    if (! processor.setBusesLayout(layout))
+        return (juce::String(numChannels) + " channels are not supported : " + job.input.getFullPathName());
+
+    // [LUCAS] : The state is loaded first, so prepareToPlay designs the filters of the preset
+    //           and resets everything the previous job left in the processor
+    processor.setStateInformation(job.state.getData(), (int) job.state.getSize());
+    processor.setNonRealtime(true);
+    processor.setRateAndBufferSizeDetails(sampleRate, options.blockSize);
+    processor.prepareToPlay(sampleRate, options.blockSize);
+
+    if (destination == nullptr)
+    {
+        job.output.getParentDirectory().createDirectory();
+        job.output.deleteFile();
+
+        destination = std::make_unique<juce::FileOutputStream>(job.output);
+
+        if (static_cast<juce::FileOutputStream*>(destination.get())->failedToOpen())
+            return ("Cannot write " + job.output.getFullPathName());
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(destination.get(), sampleRate,
+                                                                            (unsigned int) numChannels, bitDepth, {}, 0));
+
+    if (writer == nullptr)
+        return ("Cannot write " + job.output.getFullPathName() + " in " + format->getFormatName());
+
+    // [LUCAS] : The writer owns the stream now
+    destination.release();
+
+    std::unique_ptr<juce::AudioFormatReader> source;
+    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter;
+
+    if (ioThread != nullptr)
+    {
+        // [LUCAS] : The reader never gives up and returns silence, the render waits for the disk instead
+        auto bufferingReader = std::make_unique<juce::BufferingAudioReader>(reader.release(), *ioThread, options.readAheadSamples);
+        bufferingReader->setReadTimeout(-1);
+
+        source = std::move(bufferingReader);
+        threadedWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(writer.release(), *ioThread, options.readAheadSamples);
+    }
+    else
+    {
+        source = std::move(reader);
+    }
+
+    juce::AudioBuffer<float> buffer(numChannels, options.blockSize);
+    juce::MidiBuffer midiMessages;
+
+    for (juce::int64 start = 0; start < numFrames; start += options.blockSize)
+    {
+        const auto numBlockFrames = (int) juce::jmin((juce::int64) options.blockSize, numFrames - start);
+
+        buffer.setSize(numChannels, numBlockFrames, false, false, true);
+        source->read(&buffer, 0, numBlockFrames, start, true, true);
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        processor.processBlock(buffer, midiMessages);
+        result.dspSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+        if (threadedWriter != nullptr)
+        {
+            // [LUCAS] : The write FIFO is full when the disk is behind the EQ
+            while (! threadedWriter->write(buffer.getArrayOfReadPointers(), numBlockFrames))
+                juce::Thread::sleep(1);
+        }
+        else if (! writer->writeFromAudioSampleBuffer(buffer, 0, numBlockFrames))
+        {
+            return ("Cannot write " + job.output.getFullPathName());
+        }
+    }
+
+    // [LUCAS] : Flushes what is left in the write FIFO, and closes the file
+    threadedWriter.reset();
+    writer.reset();
+
+    processor.releaseResources();
+
+    result.numFrames = numFrames;
+    result.numChannels = numChannels;
+    result.sampleRate = sampleRate;
+
+    return (juce::String());
+}
+
+//==============================================================================
+// [LUCAS] : This class holds a job queue per worker. A worker takes the next job at the front
+//           of its own queue, and once it is empty, steals the last job of another queue.
+//           No job is added once the workers run, so a worker is done when every queue is empty.
+class JobQueues
+{
+public:
+    JobQueues(int numWorkers, const std::vector<RenderJob>& jobs)
+    {
+        for (int i = 0; i < numWorkers; ++i)
+            queues.push_back(std::make_unique<Queue>());
+
+        // [LUCAS] : The largest files are dealt first, so the smallest are the ones left to steal
+        std::vector<int> order((size_t) jobs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&jobs](int a, int b)
+        {
+            return (jobs[(size_t) a].inputSize > jobs[(size_t) b].inputSize);
+        });
+
+        for (size_t i = 0; i < order.size(); ++i)
+            queues[i % queues.size()]->jobs.push_back(order[i]);
+    }
+
+    // [LUCAS] : Returns false once there is nothing left to render
+    bool pop(int worker, int& jobIndex, bool& stolen)
+    {
+        {
+            auto& queue = *queues[(size_t) worker];
+            const juce::ScopedLock lock(queue.lock);
+
+            if (! queue.jobs.empty())
+            {
+                jobIndex = queue.jobs.front();
+                queue.jobs.pop_front();
+                stolen = false;
+                return (true);
+            }
+        }
+
+        for (size_t i = 1; i < queues.size(); ++i)
+        {
+            auto& victim = *queues[((size_t) worker + i) % queues.size()];
+            const juce::ScopedLock lock(victim.lock);
+
+            if (! victim.jobs.empty())
+            {
+                jobIndex = victim.jobs.back();
+                victim.jobs.pop_back();
+                stolen = true;
+                return (true);
+            }
+        }
+
+        return (false);
+    }
+
+private:
+    struct Queue
+    {
+        juce::CriticalSection lock;
+        std::deque<int> jobs;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+};
+
+// [LUCAS] : A worker renders jobs with its own processor and its own disk thread
+class RenderWorker : public juce::Thread
+{
+public:
+    RenderWorker(int index, JobQueues& queues, const std::vector<RenderJob>& jobs,
+                 std::vector<JobResult>& results, const BatchOptions& options)
+        : juce::Thread("SimpleEQ Render Worker " + juce::String(index)),
+          index(index), queues(queues), jobs(jobs), results(results), options(options)
+    {
+        formatManager.registerBasicFormats();
+    }
+
+    ~RenderWorker() override
+    {
+        stopThread(-1);
+    }
+
+    void run() override
+    {
+        ioThread.startThread();
+
+        int jobIndex = 0;
+        bool stolen = false;
+
+        while (! threadShouldExit() && queues.pop(index, jobIndex, stolen))
+        {
+            auto& result = results[(size_t) jobIndex];
+
+            result.stolen = stolen;
+            result.error = renderJob(processor, formatManager, jobs[(size_t) jobIndex], options, &ioThread, nullptr, result);
+        }
+
+        ioThread.stopThread(-1);
+    }
+
+private:
+    int index;
+    JobQueues& queues;
+    const std::vector<RenderJob>& jobs;
+    std::vector<JobResult>& results;
+    const BatchOptions& options;
+
+    SimpleEQAudioProcessor processor;
+    juce::AudioFormatManager formatManager;
+    juce::TimeSliceThread ioThread { "SimpleEQ Render I/O" };
+};
+
+//==============================================================================
+// [LUCAS] : This function renders every job again on the calling thread, into memory,
+//           and compares the result with the file the workers wrote
+static void verifyJobs(const std::vector<RenderJob>& jobs, std::vector<JobResult>& results, const BatchOptions& options)
+{
+    SimpleEQAudioProcessor processor;
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        if (results[i].error.isNotEmpty())
+            continue;
+
+        juce::MemoryBlock reference;
+        JobResult referenceResult;
+
+        const auto error = renderJob(processor, formatManager, jobs[i], options, nullptr,
+                                     std::make_unique<juce::MemoryOutputStream>(reference, false), referenceResult);
+
+        if (error.isNotEmpty())
+        {
+            results[i].error = "Verification : " + error;
+            continue;
+        }
+
+        juce::MemoryBlock rendered;
+        jobs[i].output.loadFileAsData(rendered);
+
+        results[i].verified = (rendered == reference);
+
+        if (! results[i].verified)
+            results[i].error = "Not bit-exact with the single-threaded render : " + jobs[i].output.getFullPathName();
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList arguments(argc, argv);
+
+    if (arguments.containsOption("--help|-h") || ! arguments.containsOption("--jobs"))
+    {
+        printUsage();
+        return (arguments.containsOption("--help|-h") ? 0 : 1);
+    }
+
+    BatchOptions options;
+
+    options.jobFile = juce::File::getCurrentWorkingDirectory().getChildFile(arguments.getValueForOption("--jobs").unquoted());
+
+    if (arguments.containsOption("--threads"))
+        options.numWorkers = juce::jmax(1, arguments.getValueForOption("--threads").getIntValue());
+
+    if (arguments.containsOption("--block-size"))
+        options.blockSize = juce::jmax(1, arguments.getValueForOption("--block-size").getIntValue());
+
+    if (arguments.containsOption("--read-ahead"))
+        options.readAheadSamples = juce::jmax(options.blockSize, arguments.getValueForOption("--read-ahead").getIntValue());
+
+    options.verify = arguments.containsOption("--verify");
+    options.json = arguments.containsOption("--json");
+
+    std::vector<RenderJob> jobs;
+    juce::String error;
+
+    if (! loadJobs(options.jobFile, jobs, error))
+    {
+        std::cerr << error << std::endl;
+        return (1);
+    }
+
+    std::vector<JobResult> results(jobs.size());
+
+    const auto numWorkers = juce::jmin(options.numWorkers, (int) jobs.size());
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    {
+        JobQueues queues(numWorkers, jobs);
+        std::vector<std::unique_ptr<RenderWorker>> workers;
+
+        for (int i = 0; i < numWorkers; ++i)
+            workers.push_back(std::make_unique<RenderWorker>(i, queues, jobs, results, options));
+
+        for (auto& worker : workers)
+            worker->startThread();
+
+        for (auto& worker : workers)
+            worker->waitForThreadToExit(-1);
+    }
+
+    const auto wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+    if (options.verify)
+        verifyJobs(jobs, results, options);
+
+    // [LUCAS] : The aggregate throughput, over the jobs that were rendered
+    int numFailed = 0, numStolen = 0;
+    double audioSeconds = 0.0, dspSeconds = 0.0, numSamples = 0.0;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+
+        if (result.error.isNotEmpty())
+        {
+            ++numFailed;
+            std::cerr << result.error << std::endl;
+            continue;
+        }
+
+        audioSeconds += (double) result.numFrames / result.sampleRate;
+        dspSeconds += result.dspSeconds;
+        numSamples += (double) result.numFrames * result.numChannels;
+        numStolen += result.stolen ? 1 : 0;
+    }
+
+    const auto realtimeFactor = wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0;
+    const auto megasamplesPerSecond = wallSeconds > 0.0 ? numSamples / wallSeconds * 1.0e-6 : 0.0;
+
+    if (options.json)
+    {
+        auto* report = new juce::DynamicObject();
+
+        report->setProperty("jobs", (int) jobs.size());
+        report->setProperty("failed", numFailed);
+        report->setProperty("stolen", numStolen);
+        report->setProperty("workers", numWorkers);
+        report->setProperty("verified", options.verify);
+        report->setProperty("audioSeconds", audioSeconds);
+        report->setProperty("wallSeconds", wallSeconds);
+        report->setProperty("dspSeconds", dspSeconds);
+        report->setProperty("realtimeFactor", realtimeFactor);
+        report->setProperty("megasamplesPerSecond", megasamplesPerSecond);
+
+        std::cout << juce::JSON::toString(juce::var(report)) << std::endl;
+    }
+    else
+    {
+        std::cout << (int) jobs.size() - numFailed << " of " << (int) jobs.size() << " files rendered"
+                  << (options.verify ? " and verified bit-exact" : "")
+                  << " by " << numWorkers << " workers (" << numStolen << " jobs stolen)\n"
+                  << juce::String(audioSeconds, 1) << " s of audio in " << juce::String(wallSeconds, 2) << " s"
+                  << "  realtime x" << juce::String(realtimeFactor, 1)
+                  << "  " << juce::String(megasamplesPerSecond, 2) << " Msamples/s"
+                  << "  (DSP " << juce::String(dspSeconds, 2) << " s over every worker)"
+                  << std::endl;
+    }
+
+    return (numFailed == 0 ? 0 : 1);
+}
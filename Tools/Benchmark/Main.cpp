@@ -0,0 +1,1085 @@
+/*
+  ==============================================================================
+
+    This file contains the headless benchmark of SimpleEQAudioProcessor.
+
+    It runs the processor without a host or a GUI, streams a WAV file or a
+    synthetic signal through processBlock at the requested sample rates,
+    block sizes and automation patterns, and reports the realtime factor,
+    the cost per sample and the per-block latency percentiles.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+// [LUCAS] : This structure holds the options of a benchmark session
+struct BenchmarkOptions
+{
+    juce::Array<double> sampleRates { 48000.0 };
+    juce::Array<int> blockSizes { 32, 64, 128, 512 };
+    juce::StringArray automations { "none" };
+    double seconds { 10.0 };
+    int numChannels { 2 };
+    juce::String signal { "noise" };
+    juce::File inputFile;
+    juce::File filterGraphFile;
+    CoefficientUpdateMode updateMode { CoefficientUpdateMode::audioThread };
+    FilterTopology topology { FilterTopology::transposedDirectForm2 };
+    int controlInterval { 32 };
+    PhaseMode phaseMode { PhaseMode::minimumPhase };
+    int firLength { 4096 };
+    bool doublePrecision { false };
+    bool silenceDetection { true };
+    bool dualMonoDetection { true };
+    bool json { false };
+    bool stateBenchmark { false };
+    int numInstances { 64 };
+    bool xmlState { false };
+    juce::Array<int> bandCounts;
+    bool dynamicPeak { false };
+    juce::Array<int> oversamplingFactors { 1 };
+    PhaseMode oversamplingPhase { PhaseMode::minimumPhase };
+    juce::Array<int> densityCounts;
+};
+
+// [LUCAS] : This structure holds the measurements of a single benchmark run
+struct BenchmarkResult
+{
+    double sampleRate { 0.0 };
+    int blockSize { 0 };
+    int numChannels { 0 };
+    juce::String automation;
+    int oversamplingFactor { 1 };
+    int latencySamples { 0 };
+    double realtimeFactor { 0.0 };
+    double nsPerSample { 0.0 };
+    double p50BlockMicroseconds { 0.0 };
+    double p99BlockMicroseconds { 0.0 };
+    double maxBlockMicroseconds { 0.0 };
+    double budgetMicroseconds { 0.0 };
+};
+
+// [LUCAS] : This structure holds the measurements of a save/restore run, averaged per instance
+struct StateBenchmarkResult
+{
+    double sampleRate { 0.0 };
+    int blockSize { 0 };
+    int numInstances { 0 };
+    juce::String format;
+    int stateBytes { 0 };
+    double saveMicroseconds { 0.0 };
+    double restoreMicroseconds { 0.0 };
+    double firstBlockMicroseconds { 0.0 };
+    double nextBlockMicroseconds { 0.0 };
+};
+
+// [LUCAS] : This structure holds the measurements of a parametric band run
+struct BandBenchmarkResult
+{
+    double sampleRate { 0.0 };
+    int blockSize { 0 };
+    int numChannels { 0 };
+    int numBands { 0 };
+    double nsPerSample { 0.0 };
+    double nsPerSamplePerBand { 0.0 };
+};
+
+// [LUCAS] : This structure holds the measurements of an instance density run :
+//           the memory of an instance, and the time of a callback processing them all
+struct DensityBenchmarkResult
+{
+    double sampleRate { 0.0 };
+    int blockSize { 0 };
+    int numChannels { 0 };
+    int numInstances { 0 };
+    int dspStateBytes { 0 };
+    int processorBytes { 0 };
+    double p50CallbackMicroseconds { 0.0 };
+    double p99CallbackMicroseconds { 0.0 };
+    double instanceMicroseconds { 0.0 };
+    double budgetMicroseconds { 0.0 };
+};
+
+// [LUCAS] : The cascade and the bands of --bands, sized for the largest band count it compares
+constexpr int maxBenchmarkBands = 16;
+using BandCascade = BiquadCascade<float, maxBenchmarkBands>;
+using BenchmarkBands = ParametricBands<maxBenchmarkBands>;
+
+// [LUCAS] : The plugin setup found in a .filtergraph file
+struct FilterGraphSetup
+{
+    int numChannels { 2 };
+    juce::MemoryBlock state;
+};
+
+static void printUsage()
+{
+    std::cout << "Usage: SimpleEQBenchmark [options]\n"
+                 "  --sample-rates=48000,96000     sample rates to run\n"
+                 "  --block-sizes=32,64,128,512    block sizes to run\n"
+                 "  --automation=none,sweep,steps,random\n"
+                 "                                 parameter automation patterns to run\n"
+                 "  --seconds=10                   length of the rendered audio\n"
+                 "  --channels=2                   number of channels\n"
+                 "  --signal=noise|dual-mono|sine|silence\n"
+                 "                                 synthetic input signal, dual-mono being the same noise on every channel\n"
+                 "  --input=file.wav               render a file instead of a synthetic signal\n"
+                 "  --filtergraph=SimpleEQ.filtergraph\n"
+                 "                                 reproduce the SimpleEQ node of a filter graph\n"
+                 "  --update-mode=audio|background|smoothed\n"
+                 "                                 where and how often the coefficients are designed\n"
+                 "  --topology=tdf2|svf            filter topology of the smoothed mode\n"
+                 "  --control-interval=32          samples between two redesigns of the smoothed mode\n"
+                 "  --phase=minimum|linear         IIR filter chain or linear phase FIR\n"
+                 "  --fir-length=4096              length of the linear phase FIR\n"
+                 "  --double                       process in double precision, like a double host\n"
+                 "  --no-silence-skip              process silent blocks instead of skipping them\n"
+                 "  --no-dual-mono                 filter identical channels apart instead of once\n"
+                 "  --state                        time the state save and restore instead of the processing\n"
+                 "  --instances=64                 number of plugin instances of --state\n"
+                 "  --state-format=binary|xml      restore the binary state, or the XML of older sessions\n"
+                 "  --bands=1,16                   time a cascade of that many enabled parametric bands\n"
+                 "  --dynamic                      run the peak filter in its dynamic mode\n"
+                 "  --oversampling=1,2,4           oversampling factors of the peak filter to compare\n"
+                 "  --oversampling-phase=minimum|linear\n"
+                 "                                 phase of the half-band filters of the oversampling\n"
+                 "  --density=1,100,500            time callbacks processing that many instances, and give their memory\n"
+                 "  --json                         print the results as JSON\n"
+                 "\n"
+                 "ns/sample is the processing time per sample of each channel.\n"
+                 "The --state timings are per instance, the first block being the one right after the restore.\n"
+                 "The --bands timings also give the cost of a single band, which should stay close to one biquad.\n"
+                 "The --density timings are per callback, every instance processing its own buffer once.\n";
+}
+
+static juce::File getFileForOption(const juce::ArgumentList& arguments, const juce::String& option)
+{
+    return (juce::File::getCurrentWorkingDirectory().getChildFile(arguments.getValueForOption(option).unquoted()));
+}
+
+template<typename ValueType>
+static juce::Array<ValueType> parseList(const juce::String& text)
+{
+    juce::Array<ValueType> values;
+
+    for (const auto& token : juce::StringArray::fromTokens(text, ",", ""))
+        values.add(static_cast<ValueType>(token.trim().getDoubleValue()));
+
+    return (values);
+}
+
+//==============================================================================
+// [LUCAS] : This function removes the private data that JUCE's VST3 wrapper
+//           appends after the plugin state
+static juce::MemoryBlock stripJucePrivateData(const juce::MemoryBlock& componentState)
+{
+    static constexpr const char identifier[] = "JUCEPrivateData";
+    constexpr auto identifierSize = sizeof(identifier) - 1;
+
+    const auto* data = static_cast<const char*>(componentState.getData());
+    auto size = componentState.getSize();
+
+    if (size >= identifierSize + sizeof(juce::int64)
+        && std::memcmp(data + size - identifierSize, identifier, identifierSize) == 0)
+    {
+        const auto privateDataSize = (size_t) juce::ByteOrder::littleEndianInt64(data + size - identifierSize - sizeof(juce::int64));
+        const auto trailerSize = identifierSize + sizeof(juce::int64) + privateDataSize;
+
+        size = trailerSize <= size ? size - trailerSize : 0;
+    }
+
+    return (juce::MemoryBlock(data, size));
+}
+
+// [LUCAS] : This function extracts the plugin state from the state of a VST3 node,
+//           as saved by JUCE's AudioPluginHost
+static juce::MemoryBlock unwrapVST3State(const juce::MemoryBlock& nodeState)
+{
+    const auto* data = static_cast<const char*>(nodeState.getData());
+    const auto headerSize = 4 + sizeof(juce::int32);
+
+    if (nodeState.getSize() <= headerSize || std::memcmp(data, "VC2!", 4) != 0)
+        return (nodeState);
+
+    const auto xmlSize = (size_t) juce::ByteOrder::littleEndianInt(data + 4);
+    const juce::String xmlText = juce::String::fromUTF8(data + headerSize,
+                                                        (int) juce::jmin(xmlSize, nodeState.getSize() - headerSize));
+
+    if (auto xml = juce::parseXML(xmlText))
+    {
+        if (auto* component = xml->getChildByName("IComponent"))
+        {
+            juce::MemoryBlock componentState;
+
+            if (componentState.fromBase64Encoding(component->getAllSubText().trim()))
+                return (stripJucePrivateData(componentState));
+        }
+    }
+
+    return (juce::MemoryBlock());
+}
+
+// [LUCAS] : This function reads the layout and the state of the SimpleEQ node of a filter graph
+static bool loadFilterGraph(const juce::File& file, FilterGraphSetup& setup)
+{
+    auto xml = juce::parseXML(file);
+
+    if (xml == nullptr || ! xml->hasTagName("FILTERGRAPH"))
+        return (false);
+
+    for (auto* filter : xml->getChildWithTagNameIterator("FILTER"))
+    {
+        auto* plugin = filter->getChildByName("PLUGIN");
+
+        if (plugin == nullptr || plugin->getStringAttribute("name") != "SimpleEQ")
+            continue;
+
+        if (auto* layout = filter->getChildByName("LAYOUT"))
+            if (auto* inputs = layout->getChildByName("INPUTS"))
+                if (auto* bus = inputs->getChildByName("BUS"))
+                    setup.numChannels = juce::jmax(1, juce::AudioChannelSet::fromAbbreviatedString(bus->getStringAttribute("layout")).size());
+
+        if (auto* state = filter->getChildByName("STATE"))
+        {
+            juce::MemoryBlock nodeState;
+
+            if (nodeState.fromBase64Encoding(state->getAllSubText().trim()))
+                setup.state = unwrapVST3State(nodeState);
+        }
+
+        return (true);
+    }
+
+    return (false);
+}
+
+//==============================================================================
+// [LUCAS] : This function creates the input signal of the benchmark
+static bool createInput(const BenchmarkOptions& options, double sampleRate, juce::AudioBuffer<float>& input)
+{
+    const auto numSamples = (int) (options.seconds * sampleRate);
+
+    input.setSize(options.numChannels, numSamples);
+    input.clear();
+
+    if (options.inputFile != juce::File())
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(options.inputFile));
+
+        if (reader == nullptr || reader->lengthInSamples <= 0)
+            return (false);
+
+        juce::AudioBuffer<float> file((int) reader->numChannels, (int) reader->lengthInSamples);
+        reader->read(&file, 0, file.getNumSamples(), 0, true, true);
+
+        // [LUCAS] : Loops the file over the requested length, and spreads its channels
+        for (int channel = 0; channel < options.numChannels; ++channel)
+            for (int start = 0; start < numSamples; start += file.getNumSamples())
+                input.copyFrom(channel, start, file, channel % file.getNumChannels(), 0,
+                               juce::jmin(file.getNumSamples(), numSamples - start));
+
+        return (true);
+    }
+
+    juce::Random random(0x5e1e0);
+
+    for (int channel = 0; channel < options.numChannels; ++channel)
+    {
+        auto* samples = input.getWritePointer(channel);
+
+        // [LUCAS] : Every channel of dual mono material is a copy of the first one
+        if (options.signal == "dual-mono" && channel > 0)
+        {
+            input.copyFrom(channel, 0, input, 0, 0, numSamples);
+            continue;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (options.signal == "sine")
+                samples[i] = 0.5f * std::sin(juce::MathConstants<float>::twoPi * 440.f * (float) i / (float) sampleRate);
+            else if (options.signal == "noise" || options.signal == "dual-mono")
+                samples[i] = random.nextFloat() * 2.f - 1.f;
+        }
+    }
+
+    return (true);
+}
+
+// [LUCAS] : This class moves the parameters of the EQ according to an automation pattern
+class Automation
+{
+public:
+    Automation(SimpleEQAudioProcessor& processor, const juce::String& pattern, double sampleRate)
+        : parametersManager(processor.parametersManager), pattern(pattern), sampleRate(sampleRate)
+    {
+    }
+
+    // [LUCAS] : Moves the parameters before the block starting at the given sample
+    void apply(juce::int64 blockStart)
+    {
+        const auto time = (double) blockStart / sampleRate;
+
+        if (pattern == "sweep")
+        {
+            // [LUCAS] : The peak frequency sweeps 20 Hz to 20 kHz and back every 4 seconds,
+            //           while the peak gain moves between -12 and +12 dB
+            const auto phase = std::fmod(time, 4.0) / 2.0;
+            const auto position = phase < 1.0 ? phase : 2.0 - phase;
+
+            set("Peak Freq", (float) (20.0 * std::pow(1000.0, position)));
+            set("Peak Gain", (float) (12.0 * std::sin(juce::MathConstants<double>::twoPi * time)));
+        }
+        else if (pattern == "steps")
+        {
+            // [LUCAS] : Every parameter jumps to a random value twice per second
+            const auto step = (juce::int64) (time * 2.0);
+
+            if (step != lastStep)
+            {
+                lastStep = step;
+                randomiseAll();
+            }
+        }
+        else if (pattern == "random")
+        {
+            // [LUCAS] : Every parameter jumps to a random value on every block (worst case)
+            randomiseAll();
+        }
+    }
+
+private:
+    void set(const juce::String& parameterID, float value)
+    {
+        if (auto* parameter = parametersManager.getParameter(parameterID))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    void randomiseAll()
+    {
+        for (auto* parameter : parametersManager.processor.getParameters())
+        {
+            // [LUCAS] : The dynamic mode is chosen with --dynamic, it is not automated
+            if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+                if (withId->getParameterID() == "Dynamic Enabled")
+                    continue;
+
+            parameter->setValueNotifyingHost(random.nextFloat());
+        }
+    }
+
+    juce::AudioProcessorValueTreeState& parametersManager;
+    juce::String pattern;
+    double sampleRate;
+    juce::Random random { 42 };
+    juce::int64 lastStep { -1 };
+};
+
+static double getPercentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return (0.0);
+
+    const auto index = (size_t) juce::jlimit(0.0, (double) values.size() - 1.0, percentile * (double) (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + (std::ptrdiff_t) index, values.end());
+
+    return (values[index]);
+}
+
+//==============================================================================
+// [LUCAS] : This function runs the processor over the whole input, one block at a time,
+//           and times every call to processBlock
+static BenchmarkResult runBenchmark(const BenchmarkOptions& options,
+                                    const FilterGraphSetup& setup,
+                                    const juce::AudioBuffer<float>& input,
+                                    double sampleRate,
+                                    int blockSize,
+                                    const juce::String& automationPattern,
+                                    int oversamplingFactor)
+{
+    SimpleEQAudioProcessor processor;
+
+    const auto channelSet = juce::AudioChannelSet::canonicalChannelSet(options.numChannels);
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(channelSet);
+    layout.outputBuses.add(channelSet);
+    processor.setBusesLayout(layout);
+
+    if (setup.state.getSize() > 0)
+        processor.setStateInformation(setup.state.getData(), (int) setup.state.getSize());
+
+    // [LUCAS] : A threshold low enough for the envelope to move the gain all the time
+    if (options.dynamicPeak)
+    {
+        auto* enabled = processor.parametersManager.getParameter("Dynamic Enabled");
+        auto* threshold = processor.parametersManager.getParameter("Dynamic Threshold");
+
+        enabled->setValueNotifyingHost(1.0f);
+        threshold->setValueNotifyingHost(threshold->convertTo0to1(-40.0f));
+    }
+
+    processor.setCoefficientUpdateMode(options.updateMode);
+    processor.setSmoothingTopology(options.topology);
+    processor.setSmoothingControlInterval(options.controlInterval);
+    processor.setPhaseMode(options.phaseMode);
+    processor.setLinearPhaseFirLength(options.firLength);
+    processor.setSilenceDetectionEnabled(options.silenceDetection);
+    processor.setDualMonoDetectionEnabled(options.dualMonoDetection);
+    processor.setPeakOversamplingFactor(oversamplingFactor);
+    processor.setPeakOversamplingPhase(options.oversamplingPhase);
+    processor.setProcessingPrecision(options.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                             : juce::AudioProcessor::singlePrecision);
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    Automation automation(processor, automationPattern, sampleRate);
+
+    juce::AudioBuffer<float> buffer(options.numChannels, blockSize);
+    juce::AudioBuffer<double> doubleBuffer(options.numChannels, blockSize);
+    juce::MidiBuffer midiMessages;
+
+    const auto numSamples = input.getNumSamples();
+    const auto ticksPerSecond = (double) juce::Time::getHighResolutionTicksPerSecond();
+
+    std::vector<double> blockMicroseconds;
+    blockMicroseconds.reserve((size_t) (numSamples / blockSize + 1));
+
+    double totalSeconds = 0.0;
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        const auto numBlockSamples = juce::jmin(blockSize, numSamples - start);
+
+        buffer.setSize(options.numChannels, numBlockSamples, false, false, true);
+
+        for (int channel = 0; channel < options.numChannels; ++channel)
+            buffer.copyFrom(channel, 0, input, channel, start, numBlockSamples);
+
+        // [LUCAS] : A double host hands doubles over, so the conversion is not timed
+        if (options.doublePrecision)
+        {
+            doubleBuffer.setSize(options.numChannels, numBlockSamples, false, false, true);
+
+            for (int channel = 0; channel < options.numChannels; ++channel)
+                for (int i = 0; i < numBlockSamples; ++i)
+                    doubleBuffer.setSample(channel, i, (double) buffer.getSample(channel, i));
+        }
+
+        automation.apply(start);
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        if (options.doublePrecision)
+            processor.processBlock(doubleBuffer, midiMessages);
+        else
+            processor.processBlock(buffer, midiMessages);
+
+        const auto endTicks = juce::Time::getHighResolutionTicks();
+
+        const auto seconds = (double) (endTicks - startTicks) / ticksPerSecond;
+
+        totalSeconds += seconds;
+        blockMicroseconds.push_back(seconds * 1.0e6);
+    }
+
+    processor.releaseResources();
+
+    BenchmarkResult result;
+
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+    result.numChannels = options.numChannels;
+    result.automation = automationPattern;
+    result.oversamplingFactor = oversamplingFactor;
+    result.latencySamples = processor.getLatencySamples();
+    result.realtimeFactor = totalSeconds > 0.0 ? ((double) numSamples / sampleRate) / totalSeconds : 0.0;
+    result.nsPerSample = totalSeconds * 1.0e9 / ((double) numSamples * options.numChannels);
+    result.p50BlockMicroseconds = getPercentile(blockMicroseconds, 0.5);
+    result.p99BlockMicroseconds = getPercentile(blockMicroseconds, 0.99);
+    result.maxBlockMicroseconds = blockMicroseconds.empty() ? 0.0 : *std::max_element(blockMicroseconds.begin(), blockMicroseconds.end());
+    result.budgetMicroseconds = (double) blockSize / sampleRate * 1.0e6;
+
+    return (result);
+}
+
+static juce::var toVar(const BenchmarkResult& result)
+{
+    auto* object = new juce::DynamicObject();
+
+    object->setProperty("sampleRate", result.sampleRate);
+    object->setProperty("blockSize", result.blockSize);
+    object->setProperty("channels", result.numChannels);
+    object->setProperty("automation", result.automation);
+    object->setProperty("oversampling", result.oversamplingFactor);
+    object->setProperty("latencySamples", result.latencySamples);
+    object->setProperty("realtimeFactor", result.realtimeFactor);
+    object->setProperty("nsPerSample", result.nsPerSample);
+    object->setProperty("p50BlockUs", result.p50BlockMicroseconds);
+    object->setProperty("p99BlockUs", result.p99BlockMicroseconds);
+    object->setProperty("maxBlockUs", result.maxBlockMicroseconds);
+    object->setProperty("budgetUs", result.budgetMicroseconds);
+
+    return (juce::var(object));
+}
+
+static void printResult(const BenchmarkResult& result)
+{
+    std::cout << juce::String(result.sampleRate, 0) << " Hz"
+              << "  block " << juce::String(result.blockSize).paddedLeft(' ', 5)
+              << "  " << result.numChannels << " ch"
+              << "  " << result.automation.paddedRight(' ', 7)
+              << "  peak x" << result.oversamplingFactor
+              << "  latency " << juce::String(result.latencySamples).paddedLeft(' ', 3)
+              << "  realtime x" << juce::String(result.realtimeFactor, 1).paddedLeft(' ', 9)
+              << "  " << juce::String(result.nsPerSample, 2).paddedLeft(' ', 7) << " ns/sample"
+              << "  p50 " << juce::String(result.p50BlockMicroseconds, 2) << " us"
+              << "  p99 " << juce::String(result.p99BlockMicroseconds, 2) << " us"
+              << "  max " << juce::String(result.maxBlockMicroseconds, 2) << " us"
+              << "  (budget " << juce::String(result.budgetMicroseconds, 1) << " us)"
+              << std::endl;
+}
+
+//==============================================================================
+// [LUCAS] : This function saves the state of numInstances prepared processors, restores
+//           every one of them with the state of another, and times the first processBlock
+//           after the restore against the next one
+static StateBenchmarkResult runStateBenchmark(const BenchmarkOptions& options,
+                                              const juce::AudioBuffer<float>& input,
+                                              double sampleRate,
+                                              int blockSize)
+{
+    const auto numInstances = juce::jmax(2, options.numInstances);
+    const auto channelSet = juce::AudioChannelSet::canonicalChannelSet(options.numChannels);
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(channelSet);
+    layout.outputBuses.add(channelSet);
+
+    std::vector<std::unique_ptr<SimpleEQAudioProcessor>> processors;
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        auto processor = std::make_unique<SimpleEQAudioProcessor>();
+
+        processor->setBusesLayout(layout);
+        processor->setCoefficientUpdateMode(options.updateMode);
+        processor->setSmoothingTopology(options.topology);
+        processor->setSmoothingControlInterval(options.controlInterval);
+        processor->setSilenceDetectionEnabled(options.silenceDetection);
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        // [LUCAS] : Every instance gets its own settings, so every restore changes the filters
+        Automation automation(*processor, "random", sampleRate);
+
+        for (int j = 0; j <= i; ++j)
+            automation.apply(0);
+
+        processors.push_back(std::move(processor));
+    }
+
+    juce::AudioBuffer<float> buffer(options.numChannels, blockSize);
+    juce::MidiBuffer midiMessages;
+
+    const auto fillBuffer = [&buffer, &input, &options, blockSize](int block)
+    {
+        const auto start = (block * blockSize) % juce::jmax(1, input.getNumSamples() - blockSize);
+
+        for (int channel = 0; channel < options.numChannels; ++channel)
+            buffer.copyFrom(channel, 0, input, channel, start, blockSize);
+    };
+
+    // [LUCAS] : Settles every instance on its settings before anything is timed
+    for (auto& processor : processors)
+    {
+        fillBuffer(0);
+        processor->processBlock(buffer, midiMessages);
+    }
+
+    const auto ticksPerSecond = (double) juce::Time::getHighResolutionTicksPerSecond();
+    const auto toMicroseconds = [ticksPerSecond](juce::int64 ticks) { return ((double) ticks / ticksPerSecond * 1.0e6); };
+
+    std::vector<juce::MemoryBlock> states((size_t) numInstances);
+    juce::int64 saveTicks = 0, restoreTicks = 0, firstBlockTicks = 0, nextBlockTicks = 0;
+
+    for (size_t i = 0; i < processors.size(); ++i)
+    {
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        processors[i]->getStateInformation(states[i]);
+        saveTicks += juce::Time::getHighResolutionTicks() - startTicks;
+
+        // [LUCAS] : The XML a session saved by an older version holds
+        if (options.xmlState)
+        {
+            states[i].reset();
+            juce::AudioProcessor::copyXmlToBinary(*processors[i]->parametersManager.copyState().createXml(), states[i]);
+        }
+    }
+
+    for (size_t i = 0; i < processors.size(); ++i)
+    {
+        const auto& state = states[(i + 1) % states.size()];
+
+        auto startTicks = juce::Time::getHighResolutionTicks();
+        processors[i]->setStateInformation(state.getData(), (int) state.getSize());
+        restoreTicks += juce::Time::getHighResolutionTicks() - startTicks;
+
+        fillBuffer(1);
+        startTicks = juce::Time::getHighResolutionTicks();
+        processors[i]->processBlock(buffer, midiMessages);
+        firstBlockTicks += juce::Time::getHighResolutionTicks() - startTicks;
+
+        fillBuffer(2);
+        startTicks = juce::Time::getHighResolutionTicks();
+        processors[i]->processBlock(buffer, midiMessages);
+        nextBlockTicks += juce::Time::getHighResolutionTicks() - startTicks;
+    }
+
+    for (auto& processor : processors)
+        processor->releaseResources();
+
+    StateBenchmarkResult result;
+
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+    result.numInstances = numInstances;
+    result.format = options.xmlState ? "xml" : "binary";
+    result.stateBytes = (int) states.front().getSize();
+    result.saveMicroseconds = toMicroseconds(saveTicks) / numInstances;
+    result.restoreMicroseconds = toMicroseconds(restoreTicks) / numInstances;
+    result.firstBlockMicroseconds = toMicroseconds(firstBlockTicks) / numInstances;
+    result.nextBlockMicroseconds = toMicroseconds(nextBlockTicks) / numInstances;
+
+    return (result);
+}
+
+static juce::var toVar(const StateBenchmarkResult& result)
+{
+    auto* object = new juce::DynamicObject();
+
+    object->setProperty("sampleRate", result.sampleRate);
+    object->setProperty("blockSize", result.blockSize);
+    object->setProperty("instances", result.numInstances);
+    object->setProperty("format", result.format);
+    object->setProperty("stateBytes", result.stateBytes);
+    object->setProperty("saveUs", result.saveMicroseconds);
+    object->setProperty("restoreUs", result.restoreMicroseconds);
+    object->setProperty("firstBlockUs", result.firstBlockMicroseconds);
+    object->setProperty("nextBlockUs", result.nextBlockMicroseconds);
+
+    return (juce::var(object));
+}
+
+static void printResult(const StateBenchmarkResult& result)
+{
+    std::cout << juce::String(result.sampleRate, 0) << " Hz"
+              << "  block " << juce::String(result.blockSize).paddedLeft(' ', 5)
+              << "  " << result.numInstances << " instances"
+              << "  " << result.format.paddedRight(' ', 6)
+              << "  " << result.stateBytes << " bytes"
+              << "  save " << juce::String(result.saveMicroseconds, 2) << " us"
+              << "  restore " << juce::String(result.restoreMicroseconds, 2) << " us"
+              << "  first block " << juce::String(result.firstBlockMicroseconds, 2) << " us"
+              << "  next block " << juce::String(result.nextBlockMicroseconds, 2) << " us"
+              << std::endl;
+}
+
+//==============================================================================
+// [LUCAS] : This function runs numBands enabled peak bands over the input, in the same
+//           fused cascade as the plugin, without the rest of the processor around it
+static BandBenchmarkResult runBandBenchmark(const BenchmarkOptions& options,
+                                            const juce::AudioBuffer<float>& input,
+                                            double sampleRate,
+                                            int blockSize,
+                                            int numBands)
+{
+    BenchmarkBands::Settings settings;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        auto& bandSettings = settings[(size_t) band];
+
+        bandSettings.enabled = true;
+        bandSettings.freq = 60.f * std::pow(200.f, (float) band / (float) maxBenchmarkBands);
+        bandSettings.gainInDb = (band % 2 == 0 ? 6.f : -6.f);
+        bandSettings.q = 2.f;
+    }
+
+    BandCascade cascade;
+    BenchmarkBands bands;
+
+    cascade.setTopology(options.topology);
+    cascade.prepare({ sampleRate, (juce::uint32) blockSize, (juce::uint32) options.numChannels });
+    bands.design(settings, sampleRate, cascade.getTopology(), -1.f, true);
+    bands.apply(cascade, 0);
+
+    juce::AudioBuffer<float> buffer(options.numChannels, blockSize);
+    const auto numBlocks = input.getNumSamples() / blockSize;
+    juce::int64 processTicks = 0;
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        for (int channel = 0; channel < options.numChannels; ++channel)
+            buffer.copyFrom(channel, 0, input, channel, block * blockSize, blockSize);
+
+        juce::dsp::AudioBlock<float> audioBlock(buffer);
+        juce::dsp::ProcessContextReplacing<float> context(audioBlock);
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        cascade.process(context);
+        processTicks += juce::Time::getHighResolutionTicks() - startTicks;
+    }
+
+    const auto seconds = juce::Time::highResolutionTicksToSeconds(processTicks);
+    const auto numSamples = (double) juce::jmax(1, numBlocks * blockSize * options.numChannels);
+
+    BandBenchmarkResult result;
+
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+    result.numChannels = options.numChannels;
+    result.numBands = bands.getNumActiveBands();
+    result.nsPerSample = seconds * 1.0e9 / numSamples;
+    result.nsPerSamplePerBand = result.nsPerSample / juce::jmax(1, result.numBands);
+
+    return (result);
+}
+
+static juce::var toVar(const BandBenchmarkResult& result)
+{
+    auto* object = new juce::DynamicObject();
+
+    object->setProperty("sampleRate", result.sampleRate);
+    object->setProperty("blockSize", result.blockSize);
+    object->setProperty("channels", result.numChannels);
+    object->setProperty("bands", result.numBands);
+    object->setProperty("nsPerSample", result.nsPerSample);
+    object->setProperty("nsPerSamplePerBand", result.nsPerSamplePerBand);
+
+    return (juce::var(object));
+}
+
+static void printResult(const BandBenchmarkResult& result)
+{
+    std::cout << juce::String(result.sampleRate, 0) << " Hz"
+              << "  block " << juce::String(result.blockSize).paddedLeft(' ', 5)
+              << "  " << result.numChannels << " ch"
+              << "  " << juce::String(result.numBands).paddedLeft(' ', 2) << " bands"
+              << "  " << juce::String(result.nsPerSample, 3) << " ns/sample"
+              << "  " << juce::String(result.nsPerSamplePerBand, 3) << " ns/sample/band"
+              << std::endl;
+}
+
+//==============================================================================
+// [LUCAS] : This function runs numInstances processors side by side, like the tracks of a session :
+//           every callback processes a block through each of them, in its own buffer, and is timed
+//           as a whole, so the cache misses between the instances are part of the measurement
+static DensityBenchmarkResult runDensityBenchmark(const BenchmarkOptions& options,
+                                                  const juce::AudioBuffer<float>& input,
+                                                  double sampleRate,
+                                                  int blockSize,
+                                                  int numInstances)
+{
+    const auto channelSet = juce::AudioChannelSet::canonicalChannelSet(options.numChannels);
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(channelSet);
+    layout.outputBuses.add(channelSet);
+
+    std::vector<std::unique_ptr<SimpleEQAudioProcessor>> processors;
+    std::vector<juce::AudioBuffer<float>> buffers;
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        auto processor = std::make_unique<SimpleEQAudioProcessor>();
+
+        processor->setBusesLayout(layout);
+        processor->setCoefficientUpdateMode(options.updateMode);
+        processor->setSmoothingTopology(options.topology);
+        processor->setSmoothingControlInterval(options.controlInterval);
+        processor->setSilenceDetectionEnabled(options.silenceDetection);
+        processor->setDualMonoDetectionEnabled(options.dualMonoDetection);
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        // [LUCAS] : Every instance gets its own settings, as the tracks of a session do
+        Automation automation(*processor, "random", sampleRate);
+
+        for (int j = 0; j <= i % 16; ++j)
+            automation.apply(0);
+
+        processors.push_back(std::move(processor));
+        buffers.emplace_back(options.numChannels, blockSize);
+    }
+
+    juce::MidiBuffer midiMessages;
+
+    const auto numCallbacks = input.getNumSamples() / blockSize;
+    const auto ticksPerSecond = (double) juce::Time::getHighResolutionTicksPerSecond();
+
+    std::vector<double> callbackMicroseconds;
+    callbackMicroseconds.reserve((size_t) numCallbacks);
+
+    for (int callback = 0; callback < numCallbacks; ++callback)
+    {
+        // [LUCAS] : The instances read the input at different offsets, so their audio differs too
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            const auto start = ((callback + (int) i) * blockSize) % juce::jmax(1, input.getNumSamples() - blockSize);
+
+            for (int channel = 0; channel < options.numChannels; ++channel)
+                buffers[i].copyFrom(channel, 0, input, channel, start, blockSize);
+        }
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (size_t i = 0; i < processors.size(); ++i)
+            processors[i]->processBlock(buffers[i], midiMessages);
+
+        callbackMicroseconds.push_back((double) (juce::Time::getHighResolutionTicks() - startTicks) / ticksPerSecond * 1.0e6);
+    }
+
+    for (auto& processor : processors)
+        processor->releaseResources();
+
+    DensityBenchmarkResult result;
+
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+    result.numChannels = options.numChannels;
+    result.numInstances = numInstances;
+    result.dspStateBytes = (int) processors.front()->getDspStateSizeInBytes();
+    result.processorBytes = (int) sizeof(SimpleEQAudioProcessor);
+    result.p50CallbackMicroseconds = getPercentile(callbackMicroseconds, 0.5);
+    result.p99CallbackMicroseconds = getPercentile(callbackMicroseconds, 0.99);
+    result.instanceMicroseconds = result.p50CallbackMicroseconds / numInstances;
+    result.budgetMicroseconds = (double) blockSize / sampleRate * 1.0e6;
+
+    return (result);
+}
+
+static juce::var toVar(const DensityBenchmarkResult& result)
+{
+    auto* object = new juce::DynamicObject();
+
+    object->setProperty("sampleRate", result.sampleRate);
+    object->setProperty("blockSize", result.blockSize);
+    object->setProperty("channels", result.numChannels);
+    object->setProperty("instances", result.numInstances);
+    object->setProperty("dspStateBytes", result.dspStateBytes);
+    object->setProperty("processorBytes", result.processorBytes);
+    object->setProperty("p50CallbackUs", result.p50CallbackMicroseconds);
+    object->setProperty("p99CallbackUs", result.p99CallbackMicroseconds);
+    object->setProperty("instanceUs", result.instanceMicroseconds);
+    object->setProperty("budgetUs", result.budgetMicroseconds);
+
+    return (juce::var(object));
+}
+
+static void printResult(const DensityBenchmarkResult& result)
+{
+    std::cout << juce::String(result.sampleRate, 0) << " Hz"
+              << "  block " << juce::String(result.blockSize).paddedLeft(' ', 5)
+              << "  " << result.numChannels << " ch"
+              << "  " << juce::String(result.numInstances).paddedLeft(' ', 4) << " instances"
+              << "  state " << result.dspStateBytes << " bytes"
+              << "  processor " << result.processorBytes << " bytes"
+              << "  callback p50 " << juce::String(result.p50CallbackMicroseconds, 2) << " us"
+              << "  p99 " << juce::String(result.p99CallbackMicroseconds, 2) << " us"
+              << "  " << juce::String(result.instanceMicroseconds, 3) << " us/instance"
+              << "  (budget " << juce::String(result.budgetMicroseconds, 1) << " us)"
+              << std::endl;
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList arguments(argc, argv);
+
+    if (arguments.containsOption("--help|-h"))
+    {
+        printUsage();
+        return (0);
+    }
+
+    BenchmarkOptions options;
+    FilterGraphSetup setup;
+
+    if (arguments.containsOption("--sample-rates"))
+        options.sampleRates = parseList<double>(arguments.getValueForOption("--sample-rates"));
+
+    if (arguments.containsOption("--block-sizes"))
+        options.blockSizes = parseList<int>(arguments.getValueForOption("--block-sizes"));
+
+    if (arguments.containsOption("--automation"))
+        options.automations = juce::StringArray::fromTokens(arguments.getValueForOption("--automation"), ",", "");
+
+    if (arguments.containsOption("--seconds"))
+        options.seconds = arguments.getValueForOption("--seconds").getDoubleValue();
+
+    if (arguments.containsOption("--signal"))
+        options.signal = arguments.getValueForOption("--signal");
+
+    if (arguments.containsOption("--input"))
+        options.inputFile = getFileForOption(arguments, "--input");
+
+    if (arguments.containsOption("--update-mode"))
+    {
+        const auto updateMode = arguments.getValueForOption("--update-mode");
+
+        if (updateMode == "background")
+            options.updateMode = CoefficientUpdateMode::backgroundThread;
+        else if (updateMode == "smoothed")
+            options.updateMode = CoefficientUpdateMode::smoothed;
+        else
+            options.updateMode = CoefficientUpdateMode::audioThread;
+    }
+
+    if (arguments.containsOption("--topology"))
+        options.topology = arguments.getValueForOption("--topology") == "svf"
+                         ? FilterTopology::stateVariable
+                         : FilterTopology::transposedDirectForm2;
+
+    if (arguments.containsOption("--control-interval"))
+        options.controlInterval = juce::jmax(1, arguments.getValueForOption("--control-interval").getIntValue());
+
+    if (arguments.containsOption("--phase"))
+        options.phaseMode = arguments.getValueForOption("--phase") == "linear"
+                          ? PhaseMode::linearPhase
+                          : PhaseMode::minimumPhase;
+
+    if (arguments.containsOption("--fir-length"))
+        options.firLength = arguments.getValueForOption("--fir-length").getIntValue();
+
+    options.doublePrecision = arguments.containsOption("--double");
+    options.silenceDetection = ! arguments.containsOption("--no-silence-skip");
+    options.dualMonoDetection = ! arguments.containsOption("--no-dual-mono");
+    options.json = arguments.containsOption("--json");
+    options.stateBenchmark = arguments.containsOption("--state");
+    options.dynamicPeak = arguments.containsOption("--dynamic");
+    options.xmlState = arguments.getValueForOption("--state-format") == "xml";
+
+    if (arguments.containsOption("--bands"))
+        for (auto numBands : parseList<int>(arguments.getValueForOption("--bands")))
+            options.bandCounts.add(juce::jlimit(1, maxBenchmarkBands, numBands));
+
+    if (arguments.containsOption("--oversampling"))
+    {
+        options.oversamplingFactors.clear();
+
+        for (auto factor : parseList<int>(arguments.getValueForOption("--oversampling")))
+            options.oversamplingFactors.add(factor >= 4 ? 4 : factor >= 2 ? 2 : 1);
+    }
+
+    if (arguments.containsOption("--oversampling-phase"))
+        options.oversamplingPhase = arguments.getValueForOption("--oversampling-phase") == "linear"
+                                  ? PhaseMode::linearPhase
+                                  : PhaseMode::minimumPhase;
+
+    if (arguments.containsOption("--density"))
+        for (auto numInstances : parseList<int>(arguments.getValueForOption("--density")))
+            options.densityCounts.add(juce::jmax(1, numInstances));
+
+    if (arguments.containsOption("--instances"))
+        options.numInstances = juce::jmax(2, arguments.getValueForOption("--instances").getIntValue());
+
+    if (arguments.containsOption("--filtergraph"))
+    {
+        options.filterGraphFile = getFileForOption(arguments, "--filtergraph");
+
+        if (! loadFilterGraph(options.filterGraphFile, setup))
+        {
+            std::cerr << "No SimpleEQ node found in " << options.filterGraphFile.getFullPathName() << std::endl;
+            return (1);
+        }
+
+        options.numChannels = setup.numChannels;
+    }
+
+    if (arguments.containsOption("--channels"))
+        options.numChannels = juce::jmax(1, arguments.getValueForOption("--channels").getIntValue());
+
+    juce::Array<juce::var> results;
+
+    for (auto sampleRate : options.sampleRates)
+    {
+        juce::AudioBuffer<float> input;
+
+        if (! createInput(options, sampleRate, input))
+        {
+            std::cerr << "Cannot read " << options.inputFile.getFullPathName() << std::endl;
+            return (1);
+        }
+
+        for (auto blockSize : options.blockSizes)
+        {
+            if (options.stateBenchmark)
+            {
+                const auto result = runStateBenchmark(options, input, sampleRate, blockSize);
+
+                if (options.json)
+                    results.add(toVar(result));
+                else
+                    printResult(result);
+
+                continue;
+            }
+
+            if (! options.bandCounts.isEmpty())
+            {
+                for (auto numBands : options.bandCounts)
+                {
+                    const auto result = runBandBenchmark(options, input, sampleRate, blockSize, numBands);
+
+                    if (options.json)
+                        results.add(toVar(result));
+                    else
+                        printResult(result);
+                }
+
+                continue;
+            }
+
+            if (! options.densityCounts.isEmpty())
+            {
+                for (auto numInstances : options.densityCounts)
+                {
+                    const auto result = runDensityBenchmark(options, input, sampleRate, blockSize, numInstances);
+
+                    if (options.json)
+                        results.add(toVar(result));
+                    else
+                        printResult(result);
+                }
+
+                continue;
+            }
+
+            for (const auto& automation : options.automations)
+            {
+                // [LUCAS] : The oversampling factors run one after the other, so their costs line up
+                for (auto oversamplingFactor : options.oversamplingFactors)
+                {
+                    const auto result = runBenchmark(options, setup, input, sampleRate, blockSize, automation, oversamplingFactor);
+
+                    if (options.json)
+                        results.add(toVar(result));
+                    else
+                        printResult(result);
+                }
+            }
+        }
+    }
+
+    if (options.json)
+        std::cout << juce::JSON::toString(juce::var(results)) << std::endl;
+
+    return (0);
+}
@@ -0,0 +1,629 @@
+/*
+  ==============================================================================
+
+    This file contains the kernel benchmark of SimpleEQ.
+
+    It times the hot pieces of the EQ in isolation : the parameter fetches,
+    each coefficient design, a single biquad section and the mono filter
+    chain at every slope, over a range of block sizes. It also renders the
+    impulse responses of the designs through the cascade, and compares them
+    with the golden references of Tests/Golden, so that an optimisation
+    that changes the output is caught as well as one that slows it down.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CascadeDesign.h"
+#include "PluginProcessor.h"
+
+// [LUCAS] : This structure holds the options of a kernel benchmark session
+struct KernelOptions
+{
+    double sampleRate { 48000.0 };
+    juce::Array<int> blockSizes { 16, 64, 256, 1024, 4096 };
+    double secondsPerKernel { 0.05 };
+    int numRuns { 5 };
+    bool json { false };
+    juce::File checkFile;
+    juce::File writeFile;
+    juce::File baselineFile;
+    double maxSlowdown { 0.25 };
+};
+
+// [LUCAS] : This structure holds the timing of a single kernel.
+//           Kernels that do not process audio have a block size of 0.
+struct KernelResult
+{
+    juce::String name;
+    int blockSize { 0 };
+    double nsPerCall { 0.0 };
+    double nsPerSample { 0.0 };
+};
+
+// [LUCAS] : This structure holds the comparison of a rendered reference with its golden version
+struct ReferenceResult
+{
+    juce::String name;
+    juce::String precision;
+    double maxError { 0.0 };
+    double tolerance { 0.0 };
+    bool passed { false };
+};
+
+// [LUCAS] : The filters of the references, with the positions of the sections
+//           in the FilterChain : [0..3] LowCut [4] Peak [5..8] HighCut
+constexpr float referenceLowCutFreq = 80.f;
+constexpr float referencePeakFreq = 1000.f;
+constexpr float referencePeakGainInDb = 6.f;
+constexpr float referencePeakQ = 0.7f;
+constexpr float referenceHighCutFreq = 9000.f;
+constexpr int referenceLength = 128;
+
+using MonoChain = BiquadCascade<float, 9>;
+
+// [LUCAS] : The largest difference from the golden references that is not a regression.
+//           The references are rendered in double precision : the float cascade, which rounds
+//           every section to float, stays within 1e-5 of them. A double cascade differs in the
+//           last bits of its designs from one compiler, standard library or FMA setting to the
+//           next, and the poles of the 80 Hz cut close to the unit circle carry those bits along
+//           the whole render, so it is held to 1e-7 rather than to the rounding of one sample.
+constexpr double doubleTolerance = 1.0e-7;
+constexpr double floatTolerance = 1.0e-4;
+
+static void printUsage()
+{
+    std::cout << "Usage: SimpleEQKernelBenchmark [options]\n"
+                 "  --sample-rate=48000            sample rate of the designs and the cascades\n"
+                 "  --block-sizes=16,64,256,1024,4096\n"
+                 "                                 block sizes of the section and chain kernels\n"
+                 "  --seconds=0.05                 time spent on each kernel\n"
+                 "  --runs=5                       runs of each kernel, the median one being reported\n"
+                 "  --baseline=results.json        compare the timings with the --json output of an earlier run\n"
+                 "  --max-slowdown=0.25            slowdown over the baseline that is a regression\n"
+                 "  --check=KernelReferences.json  compare the rendered references with the golden ones\n"
+                 "  --write=KernelReferences.json  render the golden references\n"
+                 "  --json                         print the results as JSON\n"
+                 "\n"
+                 "The process returns 1 when a reference drifts or a kernel regresses, so CI can run it as is.\n";
+}
+
+static juce::File getFileForOption(const juce::ArgumentList& arguments, const juce::String& option)
+{
+    return (juce::File::getCurrentWorkingDirectory().getChildFile(arguments.getValueForOption(option).unquoted()));
+}
+
+template<typename ValueType>
+static juce::Array<ValueType> parseList(const juce::String& text)
+{
+    juce::Array<ValueType> values;
+
+    for (const auto& token : juce::StringArray::fromTokens(text, ",", ""))
+        if (token.trim().isNotEmpty())
+            values.add(static_cast<ValueType>(token.trim().getDoubleValue()));
+
+    return (values);
+}
+
+// [LUCAS] : Results are written here, so the compiler cannot leave out the designs
+static volatile double sink = 0.0;
+
+//==============================================================================
+// [LUCAS] : This function calls function over and over for the time of a run, numRuns times,
+//           and returns the median time of a call, in nanoseconds. The number of calls of a run
+//           is found first, by doubling it until a run is long enough.
+template<typename Function>
+static double timeCall(const KernelOptions& options, Function&& function)
+{
+    const auto ticksPerSecond = (double) juce::Time::getHighResolutionTicksPerSecond();
+    const auto secondsPerRun = options.secondsPerKernel / juce::jmax(1, options.numRuns);
+
+    const auto runCalls = [&function, ticksPerSecond](juce::int64 numCalls)
+    {
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (juce::int64 i = 0; i < numCalls; ++i)
+            function(i);
+
+        return ((double) (juce::Time::getHighResolutionTicks() - startTicks) / ticksPerSecond);
+    };
+
+    juce::int64 numCalls = 1;
+
+    while (runCalls(numCalls) < secondsPerRun && numCalls < ((juce::int64) 1 << 40))
+        numCalls *= 2;
+
+    std::vector<double> nsPerCall;
+
+    for (int run = 0; run < juce::jmax(1, options.numRuns); ++run)
+        nsPerCall.push_back(runCalls(numCalls) * 1.0e9 / (double) numCalls);
+
+    std::nth_element(nsPerCall.begin(), nsPerCall.begin() + (std::ptrdiff_t) (nsPerCall.size() / 2), nsPerCall.end());
+
+    return (nsPerCall[nsPerCall.size() / 2]);
+}
+
+static juce::String getTopologyName(FilterTopology topology)
+{
+    return (topology == FilterTopology::stateVariable ? "svf" : "tdf2");
+}
+
+static juce::String getSlopeName(Slope slope)
+{
+    return (juce::String(12 * (slope + 1)));
+}
+
+// [LUCAS] : This function sets the sections of a MonoChain : the low cut, the peak and the high cut,
+//           each one only if asked for, with the given slope for both cut filters
+template<typename CascadeType>
+static void setReferenceFilters(CascadeType& cascade, FilterTopology topology, Slope slope,
+                                bool lowCut, bool peak, bool highCut, double sampleRate)
+{
+    cascade.setTopology(topology);
+
+    for (int section = 0; section < CascadeType::maxSections; ++section)
+        cascade.setBypassed(section, true);
+
+    const auto setCut = [&cascade, slope](int firstSection, const auto& sections)
+    {
+        for (int i = 0; i <= slope; ++i)
+        {
+            cascade.setCoefficients(firstSection + i, sections[(size_t) i]);
+            cascade.setBypassed(firstSection + i, false);
+        }
+    };
+
+    if (topology == FilterTopology::stateVariable)
+    {
+        std::array<StateVariableCoefficients, 4> sections;
+
+        if (lowCut)
+        {
+            designStateVariableHighPass(sections, referenceLowCutFreq, slope, sampleRate);
+            setCut(0, sections);
+        }
+
+        if (highCut)
+        {
+            designStateVariableLowPass(sections, referenceHighCutFreq, slope, sampleRate);
+            setCut(5, sections);
+        }
+
+        if (peak)
+            cascade.setCoefficients(4, designStateVariablePeak(referencePeakFreq, referencePeakQ, referencePeakGainInDb, sampleRate));
+    }
+    else
+    {
+        std::array<BiquadCoefficients, 4> sections;
+
+        if (lowCut)
+        {
+            designButterworthHighPass(sections, referenceLowCutFreq, slope, sampleRate);
+            setCut(0, sections);
+        }
+
+        if (highCut)
+        {
+            designButterworthLowPass(sections, referenceHighCutFreq, slope, sampleRate);
+            setCut(5, sections);
+        }
+
+        if (peak)
+            cascade.setCoefficients(4, designPeakFilter(referencePeakFreq, referencePeakQ, referencePeakGainInDb, sampleRate));
+    }
+
+    cascade.setBypassed(4, ! peak);
+}
+
+//==============================================================================
+// [LUCAS] : This function times every kernel, and returns their results
+static std::vector<KernelResult> runKernels(const KernelOptions& options)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    std::vector<KernelResult> results;
+    const auto sampleRate = options.sampleRate;
+
+    const auto addResult = [&results](const juce::String& name, int blockSize, double nsPerCall)
+    {
+        results.push_back({ name, blockSize, nsPerCall, blockSize > 0 ? nsPerCall / blockSize : 0.0 });
+    };
+
+    // [LUCAS] : The parameter fetch, from the settings snapshot, from the cached raw values
+    //           and by looking the parameters up
+    {
+        SimpleEQAudioProcessor processor;
+        const ChainSettingsSnapshot snapshot(processor.parametersManager);
+        const auto chainParameters = getChainParameters(processor.parametersManager);
+
+        addResult("fetch/snapshot", 0, timeCall(options, [&snapshot](juce::int64)
+        {
+            ChainSettings settings;
+
+            if (snapshot.tryRead(settings))
+                sink = sink + settings.peakFreq;
+        }));
+
+        addResult("fetch/cached", 0, timeCall(options, [&chainParameters](juce::int64)
+        {
+            sink = sink + getChainSettings(chainParameters).peakFreq;
+        }));
+
+        addResult("fetch/lookup", 0, timeCall(options, [&processor](juce::int64)
+        {
+            sink = sink + getChainSettings(processor.parametersManager).peakFreq;
+        }));
+    }
+
+    // [LUCAS] : The designs, with a frequency that changes on every call, as automation does
+    const auto getFrequency = [](juce::int64 call, float frequency) { return (frequency + (float) (call & 255)); };
+
+    addResult("design/tdf2/peak", 0, timeCall(options, [&](juce::int64 call)
+    {
+        sink = sink + designPeakFilter(getFrequency(call, referencePeakFreq), referencePeakQ, referencePeakGainInDb, sampleRate).b0;
+    }));
+
+    addResult("design/svf/peak", 0, timeCall(options, [&](juce::int64 call)
+    {
+        sink = sink + designStateVariablePeak(getFrequency(call, referencePeakFreq), referencePeakQ, referencePeakGainInDb, sampleRate).g;
+    }));
+
+    for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+    {
+        std::array<BiquadCoefficients, 4> biquads;
+        std::array<StateVariableCoefficients, 4> stateVariables;
+
+        addResult("design/tdf2/lowCut/" + getSlopeName(slope), 0, timeCall(options, [&](juce::int64 call)
+        {
+            designButterworthHighPass(biquads, getFrequency(call, referenceLowCutFreq), slope, sampleRate);
+            sink = sink + biquads[0].b0;
+        }));
+
+        addResult("design/tdf2/highCut/" + getSlopeName(slope), 0, timeCall(options, [&](juce::int64 call)
+        {
+            designButterworthLowPass(biquads, getFrequency(call, referenceHighCutFreq), slope, sampleRate);
+            sink = sink + biquads[0].b0;
+        }));
+
+        addResult("design/svf/lowCut/" + getSlopeName(slope), 0, timeCall(options, [&](juce::int64 call)
+        {
+            designStateVariableHighPass(stateVariables, getFrequency(call, referenceLowCutFreq), slope, sampleRate);
+            sink = sink + stateVariables[0].g;
+        }));
+
+        addResult("design/svf/highCut/" + getSlopeName(slope), 0, timeCall(options, [&](juce::int64 call)
+        {
+            designStateVariableLowPass(stateVariables, getFrequency(call, referenceHighCutFreq), slope, sampleRate);
+            sink = sink + stateVariables[0].g;
+        }));
+    }
+
+    // [LUCAS] : The processing, of one mono channel of noise, by a single section and by the whole chain
+    const auto maxBlockSize = juce::jmax(1, *std::max_element(options.blockSizes.begin(), options.blockSizes.end()));
+
+    juce::AudioBuffer<float> noise(1, maxBlockSize), buffer(1, maxBlockSize);
+    juce::Random random(42);
+
+    for (int i = 0; i < maxBlockSize; ++i)
+        noise.setSample(0, i, random.nextFloat() * 2.f - 1.f);
+
+    const auto timeCascade = [&](MonoChain& cascade, const juce::String& name)
+    {
+        for (auto blockSize : options.blockSizes)
+        {
+            cascade.prepare({ sampleRate, (juce::uint32) maxBlockSize, 1 });
+
+            const juce::dsp::AudioBlock<const float> input(noise.getArrayOfReadPointers(), 1, (size_t) blockSize);
+            juce::dsp::AudioBlock<float> output(buffer.getArrayOfWritePointers(), 1, (size_t) blockSize);
+
+            // [LUCAS] : The same noise is filtered on every call, the copy of the input into the output
+            //           costs a fraction of a single section
+            addResult(name, blockSize, timeCall(options, [&](juce::int64)
+            {
+                cascade.process(juce::dsp::ProcessContextNonReplacing<float>(input, output));
+            }));
+        }
+    };
+
+    for (auto topology : { FilterTopology::transposedDirectForm2, FilterTopology::stateVariable })
+    {
+        MonoChain cascade;
+
+        setReferenceFilters(cascade, topology, Slope_12, false, true, false, sampleRate);
+        timeCascade(cascade, "section/" + getTopologyName(topology));
+
+        for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+        {
+            setReferenceFilters(cascade, topology, slope, true, true, true, sampleRate);
+            timeCascade(cascade, "chain/" + getTopologyName(topology) + "/" + getSlopeName(slope));
+        }
+    }
+
+    return (results);
+}
+
+static juce::var toVar(const KernelResult& result)
+{
+    auto* object = new juce::DynamicObject();
+
+    object->setProperty("name", result.name);
+    object->setProperty("blockSize", result.blockSize);
+    object->setProperty("nsPerCall", result.nsPerCall);
+    object->setProperty("nsPerSample", result.nsPerSample);
+
+    return (juce::var(object));
+}
+
+static void printResult(const KernelResult& result)
+{
+    std::cout << result.name.paddedRight(' ', 24)
+              << "  block " << juce::String(result.blockSize).paddedLeft(' ', 5)
+              << "  " << juce::String(result.nsPerCall, 2).paddedLeft(' ', 10) << " ns/call";
+
+    if (result.blockSize > 0)
+        std::cout << "  " << juce::String(result.nsPerSample, 3).paddedLeft(' ', 8) << " ns/sample";
+
+    std::cout << std::endl;
+}
+
+// [LUCAS] : This function compares the results with the --json output of an earlier run,
+//           and returns the number of kernels that got slower by more than options.maxSlowdown.
+//           Kernels missing from the baseline are not compared.
+static int compareWithBaseline(const KernelOptions& options, const std::vector<KernelResult>& results)
+{
+    const auto baseline = juce::JSON::parse(options.baselineFile);
+
+    if (! baseline.isArray())
+    {
+        std::cerr << "Cannot read the baseline " << options.baselineFile.getFullPathName() << std::endl;
+        return (1);
+    }
+
+    int numRegressions = 0;
+
+    for (const auto& result : results)
+    {
+        for (const auto& entry : *baseline.getArray())
+        {
+            if (entry["name"].toString() != result.name || (int) entry["blockSize"] != result.blockSize)
+                continue;
+
+            const auto baselineNs = (double) entry["nsPerCall"];
+
+            if (baselineNs > 0.0 && result.nsPerCall > baselineNs * (1.0 + options.maxSlowdown))
+            {
+                std::cerr << "Regression : " << result.name << " block " << result.blockSize
+                          << " takes " << juce::String(result.nsPerCall, 2) << " ns/call"
+                          << ", " << juce::String(baselineNs, 2) << " ns/call in the baseline" << std::endl;
+                ++numRegressions;
+            }
+        }
+    }
+
+    return (numRegressions);
+}
+
+//==============================================================================
+// [LUCAS] : This function renders the impulse responses the golden references are made of :
+//           each filter on its own, and the whole chain, for both topologies and every slope
+template<typename SampleType>
+static std::vector<std::pair<juce::String, std::vector<SampleType>>> renderReferences(double sampleRate)
+{
+    std::vector<std::pair<juce::String, std::vector<SampleType>>> references;
+
+    for (auto topology : { FilterTopology::transposedDirectForm2, FilterTopology::stateVariable })
+    {
+        const auto render = [&references, topology, sampleRate](const juce::String& name, Slope slope, bool lowCut, bool peak, bool highCut)
+        {
+            BiquadCascade<SampleType, MonoChain::maxSections> cascade;
+
+            setReferenceFilters(cascade, topology, slope, lowCut, peak, highCut, sampleRate);
+            cascade.prepare({ sampleRate, (juce::uint32) referenceLength, 1 });
+
+            std::vector<SampleType> samples((size_t) referenceLength, SampleType(0));
+            samples[0] = SampleType(1);
+
+            auto* channels = samples.data();
+            juce::dsp::AudioBlock<SampleType> block(&channels, 1, samples.size());
+            cascade.process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+
+            references.push_back({ getTopologyName(topology) + "/" + name, std::move(samples) });
+        };
+
+        render("peak", Slope_12, false, true, false);
+
+        for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+        {
+            render("lowCut/" + getSlopeName(slope), slope, true, false, false);
+            render("highCut/" + getSlopeName(slope), slope, false, false, true);
+            render("chain/" + getSlopeName(slope), slope, true, true, true);
+        }
+    }
+
+    return (references);
+}
+
+// [LUCAS] : This function writes the references, rendered in double precision, as golden ones
+static bool writeReferences(const KernelOptions& options)
+{
+    auto* references = new juce::DynamicObject();
+
+    for (const auto& [name, samples] : renderReferences<double>(options.sampleRate))
+    {
+        juce::Array<juce::var> values;
+
+        for (auto sample : samples)
+            values.add(sample);
+
+        references->setProperty(name, values);
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("sampleRate", options.sampleRate);
+    root->setProperty("length", referenceLength);
+    root->setProperty("references", juce::var(references));
+
+    return (options.writeFile.replaceWithText(juce::JSON::toString(juce::var(root)) + "\n"));
+}
+
+// [LUCAS] : This function renders the references in both precisions, and compares them with
+//           the golden ones. A golden reference missing from the file is a failure.
+template<typename SampleType>
+static void checkReferences(const juce::var& golden, double tolerance, std::vector<ReferenceResult>& results)
+{
+    const auto sampleRate = (double) golden["sampleRate"];
+
+    for (const auto& [name, samples] : renderReferences<SampleType>(sampleRate))
+    {
+        ReferenceResult result;
+
+        result.name = name;
+        result.precision = std::is_same<SampleType, double>::value ? "double" : "float";
+        result.tolerance = tolerance;
+
+        const auto reference = golden["references"][juce::Identifier(name)];
+
+        if (reference.isArray() && reference.size() == (int) samples.size())
+        {
+            for (size_t i = 0; i < samples.size(); ++i)
+                result.maxError = juce::jmax(result.maxError, std::abs((double) samples[i] - (double) reference[(int) i]));
+
+            result.passed = (result.maxError <= tolerance);
+        }
+
+        results.push_back(result);
+    }
+}
+
+static juce::var toVar(const ReferenceResult& result)
+{
+    auto* object = new juce::DynamicObject();
+
+    object->setProperty("name", result.name);
+    object->setProperty("precision", result.precision);
+    object->setProperty("maxError", result.maxError);
+    object->setProperty("tolerance", result.tolerance);
+    object->setProperty("passed", result.passed);
+
+    return (juce::var(object));
+}
+
+static void printResult(const ReferenceResult& result)
+{
+    std::cout << (result.passed ? "ok     " : "DRIFT  ")
+              << result.name.paddedRight(' ', 20)
+              << "  " << result.precision.paddedRight(' ', 6)
+              << "  max error " << juce::String(result.maxError, 12)
+              << "  (tolerance " << juce::String(result.tolerance, 12) << ")"
+              << std::endl;
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList arguments(argc, argv);
+
+    if (arguments.containsOption("--help|-h"))
+    {
+        printUsage();
+        return (0);
+    }
+
+    KernelOptions options;
+
+    if (arguments.containsOption("--sample-rate"))
+        options.sampleRate = arguments.getValueForOption("--sample-rate").getDoubleValue();
+
+    if (arguments.containsOption("--block-sizes"))
+        options.blockSizes = parseList<int>(arguments.getValueForOption("--block-sizes"));
+
+    if (arguments.containsOption("--seconds"))
+        options.secondsPerKernel = arguments.getValueForOption("--seconds").getDoubleValue();
+
+    if (arguments.containsOption("--runs"))
+        options.numRuns = juce::jmax(1, arguments.getValueForOption("--runs").getIntValue());
+
+    if (arguments.containsOption("--max-slowdown"))
+        options.maxSlowdown = arguments.getValueForOption("--max-slowdown").getDoubleValue();
+
+    if (arguments.containsOption("--baseline"))
+        options.baselineFile = getFileForOption(arguments, "--baseline");
+
+    if (arguments.containsOption("--check"))
+        options.checkFile = getFileForOption(arguments, "--check");
+
+    if (arguments.containsOption("--write"))
+        options.writeFile = getFileForOption(arguments, "--write");
+
+    options.json = arguments.containsOption("--json");
+
+    if (options.blockSizes.isEmpty())
+        options.blockSizes.add(64);
+
+    if (options.writeFile != juce::File())
+    {
+        if (! writeReferences(options))
+        {
+            std::cerr << "Cannot write " << options.writeFile.getFullPathName() << std::endl;
+            return (1);
+        }
+
+        return (0);
+    }
+
+    // [LUCAS] : The references are checked on their own, without timing anything
+    if (options.checkFile != juce::File())
+    {
+        const auto golden = juce::JSON::parse(options.checkFile);
+
+        if (! golden["references"].isObject())
+        {
+            std::cerr << "Cannot read " << options.checkFile.getFullPathName() << std::endl;
+            return (1);
+        }
+
+        std::vector<ReferenceResult> results;
+        checkReferences<double>(golden, doubleTolerance, results);
+        checkReferences<float>(golden, floatTolerance, results);
+
+        juce::Array<juce::var> values;
+
+        for (const auto& result : results)
+        {
+            if (options.json)
+                values.add(toVar(result));
+            else
+                printResult(result);
+        }
+
+        if (options.json)
+            std::cout << juce::JSON::toString(juce::var(values)) << std::endl;
+
+        const auto passed = std::all_of(results.begin(), results.end(), [](const ReferenceResult& result) { return result.passed; });
+
+        return (passed ? 0 : 1);
+    }
+
+    const auto results = runKernels(options);
+
+    if (options.json)
+    {
+        juce::Array<juce::var> values;
+
+        for (const auto& result : results)
+            values.add(toVar(result));
+
+        std::cout << juce::JSON::toString(juce::var(values)) << std::endl;
+    }
+    else
+    {
+        for (const auto& result : results)
+            printResult(result);
+    }
+
+    if (options.baselineFile != juce::File() && compareWithBaseline(options, results) > 0)
+        return (1);
+
+    return (0);
+}